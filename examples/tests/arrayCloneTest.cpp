@@ -0,0 +1,144 @@
+// ------------------------- OpenPose Array Clone Testing -------------------------
+// Checks of the copy-on-write Array::clone(): clones must be isolated from their source (and from each other), while
+// plain copies (copy constructor and assignment) and noCopy slices must keep aliasing their source, also after
+// clone(). It stops at the first failed check (op::checkBool()) and returns -1, or 0 if all of them pass.
+
+// Command-line user interface
+#define OPENPOSE_FLAGS_DISABLE_POSE
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+
+int arrayCloneTest()
+{
+    try
+    {
+        op::opLog("Starting Array clone test...", op::Priority::High);
+
+        // logging_level
+        op::checkBool(
+            0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+
+        // Isolation: the clone is lazy, but writes on either side are not seen by the other one
+        {
+            op::Array<float> original{{2, 3}, 1.f};
+            auto clone = original.clone();
+            op::checkBool(
+                clone.getConstPtr() == original.getConstPtr(), "Clone shares the data until the first write",
+                __LINE__, __FUNCTION__, __FILE__);
+            clone[0] = 2.f;
+            op::checkBool(
+                original[0] == 1.f && clone[0] == 2.f, "Write on the clone is isolated",
+                __LINE__, __FUNCTION__, __FILE__);
+            auto clone2 = original.clone();
+            original[1] = 3.f;
+            op::checkBool(
+                original[1] == 3.f && clone2[1] == 1.f, "Write on the source is isolated",
+                __LINE__, __FUNCTION__, __FILE__);
+            auto clone3 = clone2.clone();
+            clone3.setTo(4.f);
+            op::checkBool(
+                clone2[0] == 1.f && clone3[0] == 4.f, "Clone of a clone is isolated", __LINE__, __FUNCTION__, __FILE__);
+        }
+
+        // Aliasing: copies made before clone() keep aliasing their source
+        {
+            op::Array<float> original{{4}, 1.f};
+            op::Array<float> copy = original;
+            auto clone = original.clone();
+            copy[0] = 2.f;
+            op::checkBool(
+                original[0] == 2.f && clone[0] == 1.f, "Copy made before clone() aliases its source",
+                __LINE__, __FUNCTION__, __FILE__);
+            original[1] = 3.f;
+            op::checkBool(
+                copy[1] == 3.f && clone[1] == 1.f, "Source aliases its copy made before clone()",
+                __LINE__, __FUNCTION__, __FILE__);
+        }
+
+        // Aliasing: copies (constructor and assignment) made after clone() keep aliasing their source, not the clone
+        {
+            op::Array<float> original{{4}, 1.f};
+            auto clone = original.clone();
+            op::Array<float> copy{original};
+            op::Array<float> assigned;
+            assigned = clone;
+            copy[0] = 2.f;
+            op::checkBool(
+                original[0] == 2.f && clone[0] == 1.f && assigned[0] == 1.f,
+                "Copy of the source aliases the source only", __LINE__, __FUNCTION__, __FILE__);
+            assigned[1] = 3.f;
+            op::checkBool(
+                clone[1] == 3.f && original[1] == 1.f && copy[1] == 1.f,
+                "Assigned copy of the clone aliases the clone only", __LINE__, __FUNCTION__, __FILE__);
+            original[2] = 4.f;
+            clone[3] = 5.f;
+            op::checkBool(
+                copy[2] == 4.f && assigned[3] == 5.f && clone[2] == 1.f && original[3] == 1.f,
+                "Sources see the writes of their copies only", __LINE__, __FUNCTION__, __FILE__);
+        }
+
+        // Data shared with a noCopy slice or external memory is copied immediately
+        {
+            op::Array<float> original{{2, 2}, 1.f};
+            op::Array<float> slice{original, 1, true};
+            auto clone = original.clone();
+            op::checkBool(
+                clone.getConstPtr() != original.getConstPtr(), "Data shared with a slice is copied by clone()",
+                __LINE__, __FUNCTION__, __FILE__);
+            slice[0] = 2.f;
+            op::checkBool(
+                original[2] == 2.f && clone[2] == 1.f, "Slice taken before clone() aliases its source only",
+                __LINE__, __FUNCTION__, __FILE__);
+            float externalData[4] = {1.f, 2.f, 3.f, 4.f};
+            op::Array<float> external{{4}, externalData};
+            auto externalClone = external.clone();
+            externalData[0] = 5.f;
+            op::checkBool(
+                externalClone[0] == 1.f, "External memory is copied by clone()", __LINE__, __FUNCTION__, __FILE__);
+        }
+
+        // Slices taken after clone() alias their source, not the clone
+        {
+            op::Array<float> original{{2, 2}, 1.f};
+            auto clone = original.clone();
+            op::Array<float> slice{original, 0, true};
+            slice[1] = 2.f;
+            op::checkBool(
+                original[1] == 2.f && clone[1] == 1.f, "Slice taken after clone() aliases its source only",
+                __LINE__, __FUNCTION__, __FILE__);
+        }
+
+        // Moves keep the copy-on-write state
+        {
+            op::Array<float> original{{4}, 1.f};
+            op::Array<float> moved{original.clone()};
+            op::Array<float> moveAssigned;
+            moveAssigned = original.clone();
+            moved[0] = 2.f;
+            moveAssigned[1] = 3.f;
+            op::checkBool(
+                original[0] == 1.f && original[1] == 1.f && moveAssigned[0] == 1.f, "Moved clones are isolated",
+                __LINE__, __FUNCTION__, __FILE__);
+        }
+
+        op::opLog("All checks passed.", op::Priority::High);
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running arrayCloneTest
+    return arrayCloneTest();
+}
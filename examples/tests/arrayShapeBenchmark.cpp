@@ -0,0 +1,127 @@
+// ------------------------- OpenPose Array Shape Benchmark -------------------------
+// Micro-benchmark of the Array<T> shape accessors inside a per-keypoint loop (as in scaleKeypoints,
+// getKeypointsRectangle or the keypoint savers). It compares the std::vector API (getSize(), which allocates on each
+// call) with the inline ArrayShape (getShape()) and getSize(index), reporting the time and the number of heap
+// allocations per keypoint.
+
+// Command-line user interface
+#define OPENPOSE_FLAGS_DISABLE_POSE
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+
+DEFINE_int32(people,                    20,                     "Number of people of the keypoint Array.");
+DEFINE_int32(parts,                     25,                     "Number of body parts of the keypoint Array.");
+DEFINE_int32(repetitions,               20000,                  "Number of times each loop is repeated.");
+
+// Heap allocation counter (global replacement of operator new)
+std::atomic<unsigned long long> sNumberAllocations{0ull};
+
+void* operator new(std::size_t size)
+{
+    sNumberAllocations++;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+enum class ShapeAccess
+{
+    Vector,
+    Shape,
+    Index,
+};
+
+// Scales all the keypoints in place, reading the shape inside the loop (as the original code does)
+float scaleKeypoints(op::Array<float>& keypoints, const ShapeAccess shapeAccess)
+{
+    auto sum = 0.f;
+    for (auto person = 0 ; person < keypoints.getSize(0) ; person++)
+    {
+        for (auto part = 0 ; part < keypoints.getSize(1) ; part++)
+        {
+            int numberParts, numberChannels;
+            if (shapeAccess == ShapeAccess::Vector)
+            {
+                const auto size = keypoints.getSize();
+                numberParts = size[1];
+                numberChannels = size[2];
+            }
+            else if (shapeAccess == ShapeAccess::Shape)
+            {
+                const auto& shape = keypoints.getShape();
+                numberParts = shape[1];
+                numberChannels = shape[2];
+            }
+            else
+            {
+                numberParts = keypoints.getSize(1);
+                numberChannels = keypoints.getSize(2);
+            }
+            const auto baseIndex = (person * numberParts + part) * numberChannels;
+            keypoints[baseIndex] *= 1.0001f;
+            keypoints[baseIndex+1] *= 0.9999f;
+            sum += keypoints[baseIndex+2];
+        }
+    }
+    return sum;
+}
+
+void benchmarkShapeAccess(op::Array<float>& keypoints, const ShapeAccess shapeAccess, const std::string& name)
+{
+    const auto numberKeypoints = (double)FLAGS_repetitions * FLAGS_people * FLAGS_parts;
+    const auto numberAllocationsBegin = sNumberAllocations.load();
+    const auto timerBegin = std::chrono::high_resolution_clock::now();
+    auto checksum = 0.f;
+    for (auto repetition = 0 ; repetition < FLAGS_repetitions ; repetition++)
+        checksum += scaleKeypoints(keypoints, shapeAccess);
+    const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now() - timerBegin).count();
+    const auto numberAllocations = sNumberAllocations.load() - numberAllocationsBegin;
+    op::opLog(name + ": " + std::to_string(nanoseconds / numberKeypoints) + " ns and "
+              + std::to_string(numberAllocations / numberKeypoints) + " allocations per keypoint (checksum "
+              + std::to_string(checksum) + ").", op::Priority::High);
+}
+
+int arrayShapeBenchmark()
+{
+    try
+    {
+        op::opLog("Starting array shape benchmark...", op::Priority::High);
+
+        // logging_level
+        op::checkBool(
+            0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::checkBool(
+            FLAGS_people > 0 && FLAGS_parts > 0 && FLAGS_repetitions > 0, "Wrong people/parts/repetitions.",
+            __LINE__, __FUNCTION__, __FILE__);
+
+        op::Array<float> keypoints{{FLAGS_people, FLAGS_parts, 3}, 0.5f};
+        benchmarkShapeAccess(keypoints, ShapeAccess::Vector, "getSize() (std::vector)");
+        benchmarkShapeAccess(keypoints, ShapeAccess::Shape, "getShape() (ArrayShape)");
+        benchmarkShapeAccess(keypoints, ShapeAccess::Index, "getSize(index)");
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running arrayShapeBenchmark
+    return arrayShapeBenchmark();
+}
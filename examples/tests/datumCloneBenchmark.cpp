@@ -0,0 +1,107 @@
+// ------------------------- OpenPose Datum Clone Benchmark -------------------------
+// Benchmark of Datum::clone() with heat maps enabled (as the Python and Unity bindings or any fan-out consumer do on
+// each frame). The Array<T> and Matrix elements are copy-on-write, so a read-only consumer only pays for the clone
+// itself, while a consumer that modifies every element pays for the deep copy (the cost of the former eager clone).
+
+// Command-line user interface
+#define OPENPOSE_FLAGS_DISABLE_POSE
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <opencv2/core/core.hpp> // CV_8UC3
+#include <openpose/headers.hpp>
+
+DEFINE_int32(width,                     1280,                   "Width of the input image.");
+DEFINE_int32(height,                    720,                    "Height of the input image.");
+DEFINE_int32(net_width,                 656,                    "Width of the network input and heat maps.");
+DEFINE_int32(net_height,                368,                    "Height of the network input and heat maps.");
+DEFINE_int32(heat_maps,                 78,                     "Number of heat map channels (78 for BODY_25 with"
+                                                                " parts, background and PAFs).");
+DEFINE_int32(repetitions,               100,                    "Number of clones of each mode.");
+
+// Datum with the elements of a frame processed with heat maps enabled
+op::Datum createDatum()
+{
+    op::Datum datum;
+    datum.cvInputData = op::Matrix(FLAGS_height, FLAGS_width, CV_8UC3);
+    datum.cvInputData.setTo(127.);
+    datum.cvOutputData = op::Matrix(FLAGS_height, FLAGS_width, CV_8UC3);
+    datum.cvOutputData.setTo(63.);
+    datum.inputNetData.emplace_back(std::vector<int>{1, 3, FLAGS_net_height, FLAGS_net_width}, 0.5f);
+    datum.outputData = op::Array<float>({FLAGS_height, FLAGS_width, 3}, 0.25f);
+    datum.poseHeatMaps = op::Array<float>({FLAGS_heat_maps, FLAGS_net_height, FLAGS_net_width}, 0.125f);
+    datum.poseKeypoints = op::Array<float>({20, 25, 3}, 1.f);
+    datum.poseScores = op::Array<float>(20, 1.f);
+    return datum;
+}
+
+// Modifies all the cloned elements (so all of them are copied)
+void writeAll(op::Datum& datum)
+{
+    datum.cvInputData.data()[0] = 0;
+    datum.cvOutputData.data()[0] = 0;
+    datum.inputNetData[0][0] = 0.f;
+    datum.outputData[0] = 0.f;
+    datum.poseHeatMaps[0] = 0.f;
+    datum.poseKeypoints[0] = 0.f;
+    datum.poseScores[0] = 0.f;
+}
+
+void benchmarkClone(const op::Datum& datum, const bool write)
+{
+    auto checksum = 0.;
+    const auto timerBegin = std::chrono::high_resolution_clock::now();
+    for (auto repetition = 0 ; repetition < FLAGS_repetitions ; repetition++)
+    {
+        auto datumClone = datum.clone();
+        if (write)
+            writeAll(datumClone);
+        checksum += datumClone.poseHeatMaps.getConstPtr()[1] + datumClone.cvInputData.dataConst()[1];
+    }
+    const auto microseconds = std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(
+        std::chrono::high_resolution_clock::now() - timerBegin).count();
+    op::opLog(std::string{write ? "Clone + write all:" : "Clone (read-only):"} + " "
+              + std::to_string(microseconds / FLAGS_repetitions) + " us per clone (checksum "
+              + std::to_string(checksum) + ").", op::Priority::High);
+}
+
+int datumCloneBenchmark()
+{
+    try
+    {
+        op::opLog("Starting Datum clone benchmark...", op::Priority::High);
+
+        // logging_level
+        op::checkBool(
+            0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::checkBool(
+            FLAGS_width > 0 && FLAGS_height > 0 && FLAGS_net_width > 0 && FLAGS_net_height > 0
+            && FLAGS_heat_maps > 0 && FLAGS_repetitions > 0,
+            "Wrong width/height/net_width/net_height/heat_maps/repetitions.", __LINE__, __FUNCTION__, __FILE__);
+
+        const auto datum = createDatum();
+        const auto megabytes = (3. * FLAGS_width * FLAGS_height * (2 + sizeof(float))
+                                + sizeof(float) * FLAGS_net_width * FLAGS_net_height * (3. + FLAGS_heat_maps))
+                             / (1024. * 1024.);
+        op::opLog("Datum of " + std::to_string(megabytes) + " MB.", op::Priority::High);
+        benchmarkClone(datum, false);
+        benchmarkClone(datum, true);
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running datumCloneBenchmark
+    return datumCloneBenchmark();
+}
@@ -0,0 +1,96 @@
+// ------------------------- OpenPose Direct Latency Benchmark -------------------------
+// Benchmark of the per-image latency of a request/response service: Wrapper::emplaceAndPop (the image goes through
+// the ThreadManager queues and threads) vs. Wrapper::processDirect (the workers run inline on the calling thread).
+// Both use the default body configuration without rendering, and the first frames (network loading) are excluded.
+
+// Third-party dependencies
+#include <opencv2/opencv.hpp>
+// Command-line user interface
+#define OPENPOSE_FLAGS_DISABLE_POSE
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+
+DEFINE_string(image_path,               "examples/media/COCO_val2014_000000000192.jpg",
+                                                                "Image to process.");
+DEFINE_int32(warmup,                    5,                      "Number of images processed before measuring.");
+DEFINE_int32(repetitions,               50,                     "Number of measured images of each mode.");
+
+template<typename TFunction>
+void benchmark(const std::string& name, const TFunction& function)
+{
+    for (auto repetition = 0 ; repetition < FLAGS_warmup ; repetition++)
+        function();
+    auto numberPeople = 0;
+    const auto timerBegin = std::chrono::high_resolution_clock::now();
+    for (auto repetition = 0 ; repetition < FLAGS_repetitions ; repetition++)
+        numberPeople += function();
+    const auto milliseconds = std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(
+        std::chrono::high_resolution_clock::now() - timerBegin).count();
+    op::opLog(name + " " + std::to_string(milliseconds / FLAGS_repetitions) + " ms per image ("
+              + std::to_string(numberPeople / (double)FLAGS_repetitions) + " people per image).",
+              op::Priority::High);
+}
+
+int directLatencyBenchmark()
+{
+    try
+    {
+        op::opLog("Starting direct latency benchmark...", op::Priority::High);
+
+        // logging_level
+        op::checkBool(
+            0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::checkBool(
+            FLAGS_warmup >= 0 && FLAGS_repetitions > 0, "Wrong warmup/repetitions.", __LINE__, __FUNCTION__,
+            __FILE__);
+
+        // Image
+        const cv::Mat cvImageToProcess = cv::imread(FLAGS_image_path);
+        const op::Matrix imageToProcess = OP_CV2OPCONSTMAT(cvImageToProcess);
+        if (imageToProcess.empty())
+            op::error("Could not open or find the image: " + FLAGS_image_path, __LINE__, __FUNCTION__, __FILE__);
+
+        // Default body configuration, 1 GPU and no rendering
+        op::Wrapper opWrapper{op::ThreadManagerMode::Asynchronous};
+        op::WrapperStructPose wrapperStructPose;
+        wrapperStructPose.gpuNumber = 1;
+        wrapperStructPose.renderMode = op::RenderMode::None;
+        opWrapper.configure(wrapperStructPose);
+        opWrapper.start();
+
+        // Queues and threads
+        benchmark("Wrapper::emplaceAndPop():", [&]()
+        {
+            const auto datumsPtr = opWrapper.emplaceAndPop(imageToProcess);
+            return (datumsPtr != nullptr && !datumsPtr->empty() ? datumsPtr->at(0)->poseKeypoints.getSize(0) : 0);
+        });
+        opWrapper.stop();
+
+        // Inline on this thread
+        benchmark("Wrapper::processDirect():", [&]()
+        {
+            op::Datum datum;
+            datum.cvInputData = imageToProcess;
+            return (opWrapper.processDirect(datum) ? datum.poseKeypoints.getSize(0) : 0);
+        });
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running directLatencyBenchmark
+    return directLatencyBenchmark();
+}
@@ -0,0 +1,318 @@
+// ------------------------- OpenPose Hand Tracking Stress Benchmark -------------------------
+// Benchmark of HandDetector::trackHands (+ updateTracker) on synthetic crowds (e.g., 100+ people as in stadium
+// footage), used to check that its cost grows close to linearly with the number of people. It also checks that
+// trackHands returns exactly the same rectangles as the former linear scan over all the previous hands, on the random
+// crowds and on a lattice of hands lying exactly on the cell borders of its grid (including ties among nested
+// previous hands). It returns -1 if they differ.
+
+// Command-line user interface
+#define OPENPOSE_FLAGS_DISABLE_POSE
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+#include <random>
+
+DEFINE_string(people_list,              "10,50,100,200,400",    "Comma-separated list with the number of synthetic people to"
+                                                                " benchmark.");
+DEFINE_int32(iterations,                200,                    "Number of tracking iterations (frames) for each number of"
+                                                                " people.");
+
+// Former HandDetector::trackHands: each hand is compared with all the previous hands (reference of the equivalence
+// checks)
+float getAreaRatioLinear(const op::Rectangle<float>& rectangleA, const op::Rectangle<float>& rectangleB)
+{
+    const auto sA = rectangleA.area();
+    const auto sB = rectangleB.area();
+    const auto bottomRightA = rectangleA.bottomRight();
+    const auto bottomRightB = rectangleB.bottomRight();
+    const auto sI = op::fastMax(0.f, 1.f + op::fastMin(bottomRightA.x, bottomRightB.x)
+                                - op::fastMax(rectangleA.x, rectangleB.x))
+                  * op::fastMax(0.f, 1.f + op::fastMin(bottomRightA.y, bottomRightB.y)
+                                - op::fastMax(rectangleA.y, rectangleB.y));
+    const auto sU = op::fastMin(sA, sB);
+    return op::fastMin(1.f, sI / (float)sU);
+}
+
+void trackHandLinear(op::Rectangle<float>& currentRectangle, const std::vector<op::Rectangle<float>>& previousHands)
+{
+    if (currentRectangle.area() > 0 && previousHands.size() > 0)
+    {
+        // Find closest previous rectangle
+        auto maxIndex = -1;
+        auto maxValue = 0.f;
+        for (auto previous = 0u ; previous < previousHands.size() ; previous++)
+        {
+            const auto areaRatio = getAreaRatioLinear(currentRectangle, previousHands[previous]);
+            if (maxValue < areaRatio)
+            {
+                maxValue = areaRatio;
+                maxIndex = previous;
+            }
+        }
+        // Update current rectangle with closest previous rectangle
+        if (maxIndex > -1)
+        {
+            const auto& prevRectangle = previousHands[maxIndex];
+            const auto ratio = 2.f;
+            const auto newWidth = op::fastMax((currentRectangle.width * ratio + prevRectangle.width) * 0.5f,
+                                              (currentRectangle.height * ratio + prevRectangle.height) * 0.5f);
+            currentRectangle.x = 0.5f * (currentRectangle.x + prevRectangle.x
+                                         + 0.5f * (currentRectangle.width + prevRectangle.width) - newWidth);
+            currentRectangle.y = 0.5f * (currentRectangle.y + prevRectangle.y
+                                         + 0.5f * (currentRectangle.height + prevRectangle.height) - newWidth);
+            currentRectangle.width = newWidth;
+            currentRectangle.height = newWidth;
+        }
+    }
+}
+
+// Previous hands kept by HandDetector::updateTracker
+std::vector<op::Rectangle<float>> getPreviousHands(const op::Array<float>& handKeypoints)
+{
+    std::vector<op::Rectangle<float>> previousHands;
+    for (auto person = 0 ; person < handKeypoints.getSize(0) ; person++)
+    {
+        if (op::getAverageScore(handKeypoints, person) > 0.66667f)
+        {
+            const auto handRectangle = op::getKeypointsRectangle(handKeypoints, person, 0.25f);
+            if (handRectangle.area() > 0)
+                previousHands.emplace_back(handRectangle);
+        }
+    }
+    return previousHands;
+}
+
+// It compares trackHands with the former linear scan, given the hand keypoints of the last updateTracker
+void checkEquivalence(
+    const std::vector<std::array<op::Rectangle<float>, 2>>& handRectangles, const op::HandDetector& handDetector,
+    const op::Array<float>& poseKeypoints, const std::array<op::Array<float>, 2>& previousHandKeypoints,
+    const std::string& description)
+{
+    auto expectedRectangles = handDetector.detectHands(poseKeypoints);
+    const std::array<std::vector<op::Rectangle<float>>, 2> previousHands{
+        getPreviousHands(previousHandKeypoints[0]), getPreviousHands(previousHandKeypoints[1])};
+    for (auto& expectedRectangle : expectedRectangles)
+        for (auto hand = 0 ; hand < 2 ; hand++)
+            trackHandLinear(expectedRectangle[hand], previousHands[hand]);
+    op::checkBool(
+        handRectangles.size() == expectedRectangles.size(), description + ": number of people",
+        __LINE__, __FUNCTION__, __FILE__);
+    for (auto person = 0u ; person < handRectangles.size() ; person++)
+    {
+        for (auto hand = 0 ; hand < 2 ; hand++)
+        {
+            const auto& rectangle = handRectangles[person][hand];
+            const auto& expectedRectangle = expectedRectangles[person][hand];
+            op::checkBool(
+                rectangle.x == expectedRectangle.x && rectangle.y == expectedRectangle.y
+                && rectangle.width == expectedRectangle.width && rectangle.height == expectedRectangle.height,
+                description + ": person " + std::to_string(person) + ", hand " + std::to_string(hand)
+                + " differs from the linear scan", __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
+
+// Square hand keypoints (2 corners + the center) of the given size centered at (x, y)
+void setHandKeypoints(op::Array<float>& handKeypoints, const int person, const float x, const float y,
+                      const float size)
+{
+    for (auto part = 0 ; part < handKeypoints.getSize(1) ; part++)
+    {
+        const auto corner = (part == 0 ? -0.5f : (part == 1 ? 0.5f : 0.f));
+        handKeypoints[{person, part, 0}] = x + corner * size;
+        handKeypoints[{person, part, 1}] = y + corner * size;
+        handKeypoints[{person, part, 2}] = 0.9f;
+    }
+}
+
+// Equivalence on hands exactly on the cell borders of the grid: previous hands centered on a lattice whose step is
+// the cell size (i.e., the biggest previous hand), with nested previous hands of different sizes with the same
+// center (so new hands inside both of them are ties, resolved in favor of the lowest index), and new hands of several
+// sizes centered on the lattice, between its points, and touching the previous ones
+void checkCellBorders()
+{
+    const auto poseModel = op::PoseModel::BODY_25;
+    const auto numberBodyParts = (int)op::getPoseNumberBodyParts(poseModel);
+    const auto cellSize = 64.f;
+    const auto latticeWidth = 6;
+    const auto latticeHeight = 4;
+    // Previous hands: left ones on the lattice points, right ones on the middle of the cell borders. On every other
+    // point, a nested hand of half size (before or after the big one, so ties are tested in both orders)
+    const auto numberPoints = latticeWidth * latticeHeight;
+    std::array<op::Array<float>, 2> previousHandKeypoints{
+        op::Array<float>{{2*numberPoints, 21, 3}, 0.f}, op::Array<float>{{2*numberPoints, 21, 3}, 0.f}};
+    auto numberPrevious = 0;
+    for (auto point = 0 ; point < numberPoints ; point++)
+    {
+        const auto x = cellSize * (point % latticeWidth);
+        const auto y = cellSize * (point / latticeWidth);
+        const auto nestedFirst = (point % 4 == 1);
+        const auto nested = (point % 2 == 1);
+        for (auto hand = 0 ; hand < 2 ; hand++)
+        {
+            const auto handX = x + hand * 0.5f * cellSize;
+            if (nested && nestedFirst)
+                setHandKeypoints(previousHandKeypoints[hand], numberPrevious, handX, y, 0.5f * cellSize);
+            setHandKeypoints(previousHandKeypoints[hand], numberPrevious + (nested && nestedFirst ? 1 : 0), handX, y,
+                             cellSize);
+            if (nested && !nestedFirst)
+                setHandKeypoints(previousHandKeypoints[hand], numberPrevious + 1, handX, y, 0.5f * cellSize);
+        }
+        numberPrevious += (nested ? 2 : 1);
+    }
+    // New hands: wrist = elbow, so the hand is centered on the wrist and its width is 1.35 x elbow-shoulder
+    const std::vector<float> offsets{0.f, 1.f, 0.25f * cellSize, 0.5f * cellSize, cellSize - 1.f};
+    const std::vector<float> widths{0.25f * cellSize, 0.5f * cellSize, cellSize, 2.f * cellSize};
+    const auto numberPeople = numberPoints * (int)(offsets.size() * offsets.size() * widths.size());
+    op::Array<float> poseKeypoints{{numberPeople, numberBodyParts, 3}, 0.f};
+    auto person = 0;
+    for (auto point = 0 ; point < numberPoints ; point++)
+        for (const auto offsetX : offsets)
+            for (const auto offsetY : offsets)
+                for (const auto width : widths)
+                {
+                    const auto x = cellSize * (point % latticeWidth) + offsetX;
+                    const auto y = cellSize * (point / latticeWidth) + offsetY;
+                    for (const auto& arm : {std::array<std::string, 3>{"LWrist", "LElbow", "LShoulder"},
+                                            std::array<std::string, 3>{"RWrist", "RElbow", "RShoulder"}})
+                    {
+                        for (auto i = 0 ; i < 3 ; i++)
+                        {
+                            const auto part = (int)op::poseBodyPartMapStringToKey(poseModel, arm[i]);
+                            poseKeypoints[{person, part, 0}] = x;
+                            poseKeypoints[{person, part, 1}] = y - (i == 2 ? width / 1.35f : 0.f);
+                            poseKeypoints[{person, part, 2}] = 0.9f;
+                        }
+                    }
+                    person++;
+                }
+    op::HandDetector handDetector{poseModel};
+    handDetector.updateTracker(previousHandKeypoints, 1ull);
+    checkEquivalence(handDetector.trackHands(poseKeypoints), handDetector, poseKeypoints, previousHandKeypoints,
+                     "Cell borders");
+    op::opLog("Cell borders: trackHands matches the linear scan (" + std::to_string(numberPeople) + " people, "
+              + std::to_string(numberPrevious) + " previous hands per side).", op::Priority::High);
+}
+
+// Synthetic BODY_25 poses with random positions in a 1920x1080 frame and plausible arm lengths
+op::Array<float> createPoseKeypoints(const int numberPeople, std::mt19937& randomGenerator)
+{
+    const auto poseModel = op::PoseModel::BODY_25;
+    const auto numberBodyParts = (int)op::getPoseNumberBodyParts(poseModel);
+    op::Array<float> poseKeypoints{{numberPeople, numberBodyParts, 3}, 0.f};
+    std::uniform_real_distribution<float> randomX{0.f, 1920.f};
+    std::uniform_real_distribution<float> randomY{0.f, 1080.f};
+    std::uniform_real_distribution<float> randomLength{10.f, 40.f};
+    const std::array<std::string, 6> armParts{"LShoulder", "LElbow", "LWrist", "RShoulder", "RElbow", "RWrist"};
+    for (auto person = 0 ; person < numberPeople ; person++)
+    {
+        const auto x = randomX(randomGenerator);
+        const auto y = randomY(randomGenerator);
+        const auto length = randomLength(randomGenerator);
+        for (auto i = 0u ; i < armParts.size() ; i++)
+        {
+            const auto part = (int)op::poseBodyPartMapStringToKey(poseModel, armParts[i]);
+            const auto side = (i < 3 ? -1.f : 1.f);
+            poseKeypoints[{person, part, 0}] = x + side * length * (i % 3) * 0.3f;
+            poseKeypoints[{person, part, 1}] = y + length * (i % 3);
+            poseKeypoints[{person, part, 2}] = 0.9f;
+        }
+    }
+    return poseKeypoints;
+}
+
+// Synthetic hand keypoints around the tracked hand rectangles
+std::array<op::Array<float>, 2> createHandKeypoints(
+    const std::vector<std::array<op::Rectangle<float>, 2>>& handRectangles, std::mt19937& randomGenerator)
+{
+    const auto numberPeople = (int)handRectangles.size();
+    const auto numberHandParts = 21;
+    std::array<op::Array<float>, 2> handKeypoints{
+        op::Array<float>{{numberPeople, numberHandParts, 3}, 0.f},
+        op::Array<float>{{numberPeople, numberHandParts, 3}, 0.f}};
+    std::uniform_real_distribution<float> randomRatio{0.2f, 0.8f};
+    for (auto hand = 0 ; hand < 2 ; hand++)
+    {
+        for (auto person = 0 ; person < numberPeople ; person++)
+        {
+            const auto& rectangle = handRectangles[person][hand];
+            for (auto part = 0 ; part < numberHandParts ; part++)
+            {
+                handKeypoints[hand][{person, part, 0}] = rectangle.x + rectangle.width * randomRatio(randomGenerator);
+                handKeypoints[hand][{person, part, 1}] = rectangle.y + rectangle.height * randomRatio(randomGenerator);
+                handKeypoints[hand][{person, part, 2}] = 0.9f;
+            }
+        }
+    }
+    return handKeypoints;
+}
+
+int handTrackingBenchmark()
+{
+    try
+    {
+        op::opLog("Starting hand tracking benchmark...", op::Priority::High);
+
+        // logging_level
+        op::checkBool(
+            0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+
+        // Equivalence with the former linear scan on the cell borders
+        checkCellBorders();
+
+        std::mt19937 randomGenerator{0};
+        for (const auto& numberPeopleString : op::splitString(FLAGS_people_list, ","))
+        {
+            const auto numberPeople = std::stoi(numberPeopleString);
+            op::HandDetector handDetector{op::PoseModel::BODY_25};
+            // Warm up tracker with a first frame
+            auto poseKeypoints = createPoseKeypoints(numberPeople, randomGenerator);
+            auto handRectangles = handDetector.trackHands(poseKeypoints);
+            auto previousHandKeypoints = createHandKeypoints(handRectangles, randomGenerator);
+            handDetector.updateTracker(previousHandKeypoints, 1ull);
+            // Benchmark
+            auto trackSeconds = 0.;
+            auto updateSeconds = 0.;
+            for (auto iteration = 0 ; iteration < FLAGS_iterations ; iteration++)
+            {
+                poseKeypoints = createPoseKeypoints(numberPeople, randomGenerator);
+                const auto timerTrack = std::chrono::high_resolution_clock::now();
+                handRectangles = handDetector.trackHands(poseKeypoints);
+                const auto timerUpdate = std::chrono::high_resolution_clock::now();
+                trackSeconds += double(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(timerUpdate-timerTrack).count()* 1e-9);
+                // Equivalence with the former linear scan (not timed)
+                checkEquivalence(handRectangles, handDetector, poseKeypoints, previousHandKeypoints,
+                                 std::to_string(numberPeople) + " people");
+                const auto handKeypoints = createHandKeypoints(handRectangles, randomGenerator);
+                const auto timerUpdateBegin = std::chrono::high_resolution_clock::now();
+                handDetector.updateTracker(handKeypoints, iteration + 2ull);
+                const auto timerEnd = std::chrono::high_resolution_clock::now();
+                updateSeconds += double(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(timerEnd-timerUpdateBegin).count()* 1e-9);
+                previousHandKeypoints = handKeypoints;
+            }
+            op::opLog(std::to_string(numberPeople) + " people: trackHands "
+                      + std::to_string(1e3 * trackSeconds / FLAGS_iterations) + " ms/frame, updateTracker "
+                      + std::to_string(1e3 * updateSeconds / FLAGS_iterations) + " ms/frame.", op::Priority::High);
+        }
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running handTrackingBenchmark
+    return handTrackingBenchmark();
+}
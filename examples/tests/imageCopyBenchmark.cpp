@@ -0,0 +1,95 @@
+// ------------------------- OpenPose Image Copy Benchmark -------------------------
+// Benchmark of the per-frame image hand-offs between Matrix (cv::Mat) and Array<float>: the CPU conversions of
+// CvMatToOpOutput (compared with its former intermediate copy) and OpOutputToCvMat. For each one, it prints the time
+// per frame and the number of image copies (i.e., whether the resulting element points to a new buffer).
+
+// Command-line user interface
+#define OPENPOSE_FLAGS_DISABLE_POSE
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <opencv2/core/core.hpp> // CV_8UC3, CV_32FC3
+#include <openpose/headers.hpp>
+
+DEFINE_int32(width,                     1280,                   "Width of the input image.");
+DEFINE_int32(height,                    720,                    "Height of the input image.");
+DEFINE_int32(repetitions,               100,                    "Number of frames of each mode.");
+
+template<typename TFunction>
+void benchmark(const std::string& name, const TFunction& function)
+{
+    auto copies = 0;
+    const auto timerBegin = std::chrono::high_resolution_clock::now();
+    for (auto repetition = 0 ; repetition < FLAGS_repetitions ; repetition++)
+        copies += function();
+    const auto microseconds = std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(
+        std::chrono::high_resolution_clock::now() - timerBegin).count();
+    op::opLog(name + " " + std::to_string(microseconds / FLAGS_repetitions) + " us and "
+              + std::to_string(copies / (double)FLAGS_repetitions) + " image copies per frame.",
+              op::Priority::High);
+}
+
+int imageCopyBenchmark()
+{
+    try
+    {
+        op::opLog("Starting image copy benchmark...", op::Priority::High);
+
+        // logging_level
+        op::checkBool(
+            0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::checkBool(
+            FLAGS_width > 0 && FLAGS_height > 0 && FLAGS_repetitions > 0, "Wrong width/height/repetitions.",
+            __LINE__, __FUNCTION__, __FILE__);
+
+        // Input frame and output resolution (the default output resolution is the input one)
+        op::Matrix cvInputData(FLAGS_height, FLAGS_width, CV_8UC3);
+        cvInputData.setTo(127.);
+        const op::Point<int> outputResolution{FLAGS_width, FLAGS_height};
+
+        // cv::Mat -> float* (converted, so no copies if the output buffer is reused)
+        op::CvMatToOpOutput cvMatToOpOutput;
+        op::Array<float> outputData;
+        cvMatToOpOutput.fillArray(outputData, cvInputData, 1., outputResolution);
+        // Former fillArray() for the same resolution: intermediate copy of the frame, then conversion
+        benchmark("Copy + convertTo (former fillArray()):", [&]()
+        {
+            cv::Mat frameWithOutputSize;
+            OP_OP2CVCONSTMAT(cvInputData).copyTo(frameWithOutputSize);
+            cv::Mat cvOutputData = OP_OP2CVMAT(outputData.getCvMat());
+            frameWithOutputSize.convertTo(cvOutputData, CV_32FC3);
+            return 1;
+        });
+        benchmark("CvMatToOpOutput::fillArray():", [&]()
+        {
+            const auto* const previousPtr = outputData.getConstPtr();
+            cvMatToOpOutput.fillArray(outputData, cvInputData, 1., outputResolution);
+            return int(outputData.getConstPtr() != previousPtr);
+        });
+
+        // float* -> cv::Mat (converted into a new Matrix for each frame)
+        op::OpOutputToCvMat opOutputToCvMat;
+        benchmark("OpOutputToCvMat::formatToCvMat():", [&]()
+        {
+            opOutputToCvMat.formatToCvMat(outputData);
+            return 0;
+        });
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running imageCopyBenchmark
+    return imageCopyBenchmark();
+}
@@ -0,0 +1,157 @@
+// ------------------------- OpenPose KeypointSet Testing -------------------------
+// Round-trip checks of KeypointSet: Datum keypoints -> KeypointSet -> Datum keypoints, with float storage (exact) and
+// half precision storage (within the half precision rounding error), for 2-D and 3-D keypoints. It stops at the first
+// failed check (op::checkBool()) and returns -1, or 0 if all of them pass.
+
+#include <cmath> // std::abs, std::fmod, std::pow
+#include <limits> // std::numeric_limits
+// Command-line user interface
+#define OPENPOSE_FLAGS_DISABLE_POSE
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+
+DEFINE_int32(people,                    3,                      "Number of people of the synthetic keypoints.");
+
+// Synthetic keypoints: image coordinates in [0, 4096) and scores in [0, 1]
+void fillKeypoints(op::Array<float>& keypoints, const int numberPeople, const int numberParts,
+                   const int numberChannels, const float seed)
+{
+    keypoints.reset({numberPeople, numberParts, numberChannels});
+    for (auto i = 0u ; i < keypoints.getVolume() ; i++)
+        keypoints[i] = ((int)i % numberChannels == numberChannels - 1
+            ? std::fmod(seed * (i + 1), 1.f) : std::fmod(seed * 997.f * (i + 1), 4096.f));
+}
+
+// Maximum absolute error allowed: 0 for float storage, half a unit in the last place for half precision
+bool isClose(const float value, const float reference, const op::KeypointStorage keypointStorage)
+{
+    if (keypointStorage == op::KeypointStorage::Float32)
+        return value == reference;
+    return std::abs(value - reference) <= std::abs(reference) / 2048.f + 1e-7f;
+}
+
+void checkRoundTrip(const op::KeypointStorage keypointStorage, const bool threeD)
+{
+    const auto storageName = std::string{keypointStorage == op::KeypointStorage::Float32 ? "Float32" : "Float16"}
+                           + (threeD ? " 3-D" : " 2-D");
+    const auto numberChannels = (threeD ? 4 : 3);
+    // Datum with body, face and left hand keypoints (empty right hand)
+    op::Datum datum;
+    auto& poseKeypoints = (threeD ? datum.poseKeypoints3D : datum.poseKeypoints);
+    auto& faceKeypoints = (threeD ? datum.faceKeypoints3D : datum.faceKeypoints);
+    auto& leftHandKeypoints = (threeD ? datum.handKeypoints3D[0] : datum.handKeypoints[0]);
+    const auto& rightHandKeypoints = (threeD ? datum.handKeypoints3D[1] : datum.handKeypoints[1]);
+    fillKeypoints(poseKeypoints, FLAGS_people, 25, numberChannels, 0.1234f);
+    fillKeypoints(faceKeypoints, FLAGS_people, (int)op::FACE_NUMBER_PARTS, numberChannels, 0.5678f);
+    fillKeypoints(leftHandKeypoints, FLAGS_people, (int)op::HAND_NUMBER_PARTS, numberChannels, 0.9012f);
+
+    // Datum -> KeypointSet
+    op::KeypointSet keypointSet{keypointStorage};
+    keypointSet.setFrom(datum, threeD);
+    op::checkBool(
+        keypointSet.getNumberPeople() == FLAGS_people && keypointSet.getNumberChannels() == numberChannels,
+        storageName + ": number of people and channels", __LINE__, __FUNCTION__, __FILE__);
+    op::checkBool(
+        keypointSet.getNumberParts(op::KeypointGroup::Face) == (int)op::FACE_NUMBER_PARTS
+        && keypointSet.getNumberParts(op::KeypointGroup::RightHand) == 0,
+        storageName + ": number of parts", __LINE__, __FUNCTION__, __FILE__);
+    // Columns: all the values of a channel of a group are contiguous
+    auto columnsMatch = true;
+    for (auto channel = 0 ; channel < numberChannels ; channel++)
+    {
+        const auto* const floatColumn = (keypointStorage == op::KeypointStorage::Float32
+            ? keypointSet.getConstColumn(op::KeypointGroup::Pose, channel) : nullptr);
+        const auto* const halfColumn = (keypointStorage == op::KeypointStorage::Float16
+            ? keypointSet.getConstHalfColumn(op::KeypointGroup::Pose, channel) : nullptr);
+        for (auto index = 0 ; index < FLAGS_people * 25 ; index++)
+        {
+            const auto value = (floatColumn != nullptr ? floatColumn[index] : op::halfToFloat(halfColumn[index]));
+            columnsMatch &= (value == keypointSet.get(op::KeypointGroup::Pose, index / 25, index % 25, channel));
+            columnsMatch &= isClose(value, poseKeypoints[index * numberChannels + channel], keypointStorage);
+        }
+    }
+    op::checkBool(columnsMatch, storageName + ": pose columns", __LINE__, __FUNCTION__, __FILE__);
+
+    // KeypointSet -> Datum (on a clone, so the original values are kept)
+    op::Datum datumOutput;
+    keypointSet.clone().copyTo(datumOutput, threeD);
+    const auto& poseOutput = (threeD ? datumOutput.poseKeypoints3D : datumOutput.poseKeypoints);
+    const auto& faceOutput = (threeD ? datumOutput.faceKeypoints3D : datumOutput.faceKeypoints);
+    const auto& leftHandOutput = (threeD ? datumOutput.handKeypoints3D[0] : datumOutput.handKeypoints[0]);
+    const auto& rightHandOutput = (threeD ? datumOutput.handKeypoints3D[1] : datumOutput.handKeypoints[1]);
+    op::checkBool(
+        poseOutput.getShape() == poseKeypoints.getShape() && faceOutput.getShape() == faceKeypoints.getShape()
+        && leftHandOutput.getShape() == leftHandKeypoints.getShape() && rightHandOutput.empty()
+        && rightHandKeypoints.empty(),
+        storageName + ": round-trip shapes", __LINE__, __FUNCTION__, __FILE__);
+    auto valuesMatch = true;
+    for (const auto& arrays : std::vector<std::pair<const op::Array<float>*, const op::Array<float>*>>{
+        {&poseOutput, &poseKeypoints}, {&faceOutput, &faceKeypoints}, {&leftHandOutput, &leftHandKeypoints}})
+        if (arrays.first->getVolume() == arrays.second->getVolume())
+            for (auto i = 0u ; i < arrays.first->getVolume() ; i++)
+                valuesMatch &= isClose(arrays.first->at(i), arrays.second->at(i), keypointStorage);
+    op::checkBool(valuesMatch, storageName + ": round-trip values", __LINE__, __FUNCTION__, __FILE__);
+
+    // A second round trip of half precision values is exact
+    if (keypointStorage == op::KeypointStorage::Float16)
+    {
+        op::KeypointSet keypointSet2{keypointStorage};
+        keypointSet2.setFrom(datumOutput, threeD);
+        const auto faceOutput2 = keypointSet2.toArray(op::KeypointGroup::Face);
+        auto exact = (faceOutput2.getVolume() == faceOutput.getVolume());
+        for (auto i = 0u ; exact && i < faceOutput2.getVolume() ; i++)
+            exact &= (faceOutput2[i] == faceOutput[i]);
+        op::checkBool(exact, storageName + ": second round trip", __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+int keypointSetTest()
+{
+    try
+    {
+        op::opLog("Starting KeypointSet test...", op::Priority::High);
+
+        // logging_level
+        op::checkBool(
+            0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::checkBool(FLAGS_people > 0, "Wrong people.", __LINE__, __FUNCTION__, __FILE__);
+
+        // Round trips
+        for (const auto keypointStorage : {op::KeypointStorage::Float32, op::KeypointStorage::Float16})
+            for (const auto threeD : {false, true})
+                checkRoundTrip(keypointStorage, threeD);
+
+        // Half precision conversion: exact for values representable in half precision, and special values kept
+        op::checkBool(
+            op::halfToFloat(op::floatToHalf(1.f)) == 1.f && op::halfToFloat(op::floatToHalf(-2048.f)) == -2048.f
+            && op::halfToFloat(op::floatToHalf(65504.f)) == 65504.f,
+            "Exact half values", __LINE__, __FUNCTION__, __FILE__);
+        op::checkBool(
+            op::halfToFloat(op::floatToHalf(1e6f)) == std::numeric_limits<float>::infinity(), "Overflow into infinity",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::checkBool(
+            op::floatToHalf(0.f) == 0u
+            && op::halfToFloat(op::floatToHalf(std::pow(2.f, -24.f))) == std::pow(2.f, -24.f),
+            "Zero and subnormal values", __LINE__, __FUNCTION__, __FILE__);
+
+        op::opLog("All checks passed.", op::Priority::High);
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running keypointSetTest
+    return keypointSetTest();
+}
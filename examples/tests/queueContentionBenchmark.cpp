@@ -0,0 +1,109 @@
+// ------------------------- OpenPose Queue Contention Benchmark -------------------------
+// Benchmark of the thread queues under contention: N producer threads push into a single queue while N consumer
+// threads pop from it (as in the fan-out of the num_gpu pose stages). It compares the mutex-based Queue with the
+// lock-free RingBufferQueue (MPMC and, for a single producer and consumer, SPSC).
+
+// Command-line user interface
+#define OPENPOSE_FLAGS_DISABLE_POSE
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+
+DEFINE_string(workers_list,             "1,4,16",               "Comma-separated list with the number of producer (and"
+                                                                " consumer) threads to benchmark.");
+DEFINE_int32(elements,                  200000,                 "Total number of elements pushed through the queue for"
+                                                                " each number of workers.");
+DEFINE_int32(queue_size,                16,                     "Maximum number of elements in the queue.");
+
+typedef std::shared_ptr<std::vector<std::shared_ptr<op::Datum>>> TDatumsSP;
+
+// Returns the throughput (in million elements per second)
+template<typename TQueue>
+double benchmarkQueue(TQueue& tQueue, const int numberWorkers)
+{
+    const auto elementsPerWorker = FLAGS_elements / numberWorkers;
+    const auto numberElements = elementsPerWorker * numberWorkers;
+    // Shared element (only the queue operations are measured, not allocating them)
+    const auto datumsPtr = std::make_shared<std::vector<std::shared_ptr<op::Datum>>>();
+    std::atomic<int> numberPopped{0};
+    std::vector<std::thread> threads;
+    const auto timerBegin = std::chrono::high_resolution_clock::now();
+    for (auto worker = 0 ; worker < numberWorkers ; worker++)
+    {
+        // Producer
+        threads.emplace_back([&]{
+            auto tDatums = datumsPtr;
+            for (auto i = 0 ; i < elementsPerWorker ; i++)
+                while (!tQueue.tryEmplace(tDatums))
+                    std::this_thread::yield();
+        });
+        // Consumer
+        threads.emplace_back([&]{
+            TDatumsSP tDatums;
+            while (numberPopped < numberElements)
+            {
+                if (tQueue.tryPop(tDatums))
+                    numberPopped++;
+                else
+                    std::this_thread::yield();
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    const auto timerEnd = std::chrono::high_resolution_clock::now();
+    const auto seconds = double(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(timerEnd-timerBegin).count() * 1e-9);
+    return numberElements / seconds * 1e-6;
+}
+
+int queueContentionBenchmark()
+{
+    try
+    {
+        op::opLog("Starting queue contention benchmark...", op::Priority::High);
+
+        // logging_level
+        op::checkBool(
+            0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::checkBool(FLAGS_elements > 0 && FLAGS_queue_size > 0, "Wrong elements/queue_size value.",
+            __LINE__, __FUNCTION__, __FILE__);
+
+        for (const auto& numberWorkersString : op::splitString(FLAGS_workers_list, ","))
+        {
+            const auto numberWorkers = std::stoi(numberWorkersString);
+            op::Queue<TDatumsSP> queue{FLAGS_queue_size};
+            op::RingBufferQueue<TDatumsSP> mpmcQueue{FLAGS_queue_size};
+            mpmcQueue.setEndpoints(false, false);
+            auto message = std::to_string(numberWorkers) + " producers/consumers: Queue "
+                + std::to_string(benchmarkQueue(queue, numberWorkers)) + " M/s, RingBufferQueue (MPMC) "
+                + std::to_string(benchmarkQueue(mpmcQueue, numberWorkers)) + " M/s";
+            if (numberWorkers == 1)
+            {
+                op::RingBufferQueue<TDatumsSP> spscQueue{FLAGS_queue_size};
+                spscQueue.setEndpoints(true, true);
+                message += ", RingBufferQueue (SPSC) " + std::to_string(benchmarkQueue(spscQueue, numberWorkers))
+                         + " M/s";
+            }
+            op::opLog(message + ".", op::Priority::High);
+        }
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running queueContentionBenchmark
+    return queueContentionBenchmark();
+}
@@ -0,0 +1,244 @@
+// ------------------------- OpenPose Thread Latency Benchmark -------------------------
+// Benchmark of the per-frame latency that the threading module (ThreadManager, queues and SubThreads) adds on its
+// own. It builds a pipeline of null (no-op) stages, each one on its own thread, and compares the polling mode
+// (sleep of 100 microseconds when a queue is empty or full) with the blocking mode (condition variables) and with the
+// work-stealing backend (all stages share a pool of threads). It also reports the CPU usage of the idle pipeline.
+// Finally, it runs an overload test: a live source faster than a (sleeping) stage, with the queues blocking
+// (QueueFullPolicy::Block) or dropping the oldest frame (QueueFullPolicy::OverwriteOldest, i.e., latest-frame-wins).
+// It reports the latency from capture to output and the frames dropped, with 1 worker and with several parallel
+// workers plus WQueueOrderer (as the multi-GPU pipeline).
+
+// Command-line user interface
+#define OPENPOSE_FLAGS_DISABLE_POSE
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+#include <algorithm>
+#include <ctime>
+#include <thread>
+
+DEFINE_int32(stages,                    10,                     "Number of null stages (threads) in the pipeline.");
+DEFINE_int32(frames,                    2000,                   "Number of frames sent through the pipeline for each"
+                                                                " mode. Frames are sent one at a time, so the measured"
+                                                                " time is the latency of each one.");
+DEFINE_int32(idle_seconds,              1,                      "Time (in seconds) that the idle pipeline is running"
+                                                                " to measure its CPU usage.");
+DEFINE_int32(pool_threads,              -1,                     "Number of pool threads for the work-stealing backend"
+                                                                " (-1 for one per logical core).");
+DEFINE_int32(overload_fps,              1000,                   "Frame rate of the live source of the overload test."
+                                                                " Select 0 to disable the overload test.");
+DEFINE_double(overload_stage_ms,        5.,                     "Time (in milliseconds) that the stage of the overload"
+                                                                " test takes per frame (it must be slower than the"
+                                                                " source to overload the pipeline).");
+DEFINE_int32(overload_workers,          3,                      "Number of parallel workers of the stage in the second"
+                                                                " overload configuration (the first one uses 1).");
+DEFINE_int32(overload_seconds,          2,                      "Duration (in seconds) of the live source of each"
+                                                                " overload configuration.");
+
+typedef std::shared_ptr<std::vector<std::shared_ptr<op::Datum>>> TDatumsSP;
+
+// Stage that does nothing, so only the threading overhead is measured
+class WNull : public op::Worker<TDatumsSP>
+{
+public:
+    void initializationOnThread() {}
+
+    void work(TDatumsSP&) {}
+};
+
+// Stage that takes a fixed time per frame (e.g., the GPU stage), used to overload the pipeline
+class WSleep : public op::Worker<TDatumsSP>
+{
+public:
+    void initializationOnThread() {}
+
+    void work(TDatumsSP&)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds{(long long)(1e3 * FLAGS_overload_stage_ms)});
+    }
+};
+
+double getPercentile(const std::vector<double>& sortedValues, const double percentile)
+{
+    return (sortedValues.empty() ? 0. : sortedValues[(size_t)(percentile*(sortedValues.size()-1))]);
+}
+
+void benchmarkMode(const bool blocking, const bool workStealing)
+{
+    // Null pipeline: queue 0 -> stage 0 -> queue 1 -> ... -> stage N-1 -> queue N
+    op::ThreadManager<TDatumsSP> threadManager{op::ThreadManagerMode::Asynchronous};
+    threadManager.setBlocking(blocking);
+    if (workStealing)
+        threadManager.setBackend(op::ThreadManagerBackend::WorkStealing, FLAGS_pool_threads);
+    for (auto stage = 0ull ; stage < (unsigned long long)FLAGS_stages ; stage++)
+        threadManager.add(stage, std::make_shared<WNull>(), stage, stage+1);
+    threadManager.start();
+
+    // Idle CPU usage
+    const auto clockBegin = std::clock();
+    std::this_thread::sleep_for(std::chrono::seconds{FLAGS_idle_seconds});
+    const auto idleCpuUsage = 100. * double(std::clock() - clockBegin) / CLOCKS_PER_SEC / FLAGS_idle_seconds;
+
+    // Latency
+    std::vector<double> latencies;
+    latencies.reserve(FLAGS_frames);
+    for (auto frame = 0 ; frame < FLAGS_frames ; frame++)
+    {
+        auto datumsPtr = std::make_shared<std::vector<std::shared_ptr<op::Datum>>>();
+        datumsPtr->emplace_back(std::make_shared<op::Datum>());
+        datumsPtr->at(0)->id = frame;
+        const auto timerBegin = std::chrono::high_resolution_clock::now();
+        threadManager.waitAndEmplace(datumsPtr);
+        TDatumsSP datumsProcessed;
+        if (!threadManager.waitAndPop(datumsProcessed))
+            op::error("Pipeline stopped unexpectedly.", __LINE__, __FUNCTION__, __FILE__);
+        const auto timerEnd = std::chrono::high_resolution_clock::now();
+        latencies.emplace_back(
+            double(std::chrono::duration_cast<std::chrono::nanoseconds>(timerEnd-timerBegin).count() * 1e-6));
+    }
+    threadManager.stop();
+
+    // Report
+    std::sort(latencies.begin(), latencies.end());
+    auto meanLatency = 0.;
+    for (const auto latency : latencies)
+        meanLatency += latency;
+    meanLatency /= latencies.size();
+    const auto modeName = std::string{workStealing ? "Work-stealing" : (blocking ? "Blocking" : "Polling ")};
+    op::opLog(modeName + " mode (" + std::to_string(FLAGS_stages) + " stages): mean "
+              + std::to_string(meanLatency) + " ms, median "
+              + std::to_string(getPercentile(latencies, 0.5)) + " ms, p99 "
+              + std::to_string(getPercentile(latencies, 0.99)) + " ms, idle CPU "
+              + std::to_string(idleCpuUsage) + "%.", op::Priority::High);
+}
+
+void benchmarkOverload(const op::QueueFullPolicy queueFullPolicy, const unsigned int numberWorkers)
+{
+    // Live source (1 frame every 1/fps seconds) -> queue 0 -> numberWorkers WSleep -> queue 1
+    //     [-> WQueueOrderer -> queue 2] -> consumer
+    const auto overwrite = (queueFullPolicy == op::QueueFullPolicy::OverwriteOldest);
+    op::ThreadManager<TDatumsSP> threadManager{op::ThreadManagerMode::Asynchronous};
+    threadManager.setBlocking(true);
+    threadManager.setQueueFullPolicy(queueFullPolicy);
+    for (auto worker = 0u ; worker < numberWorkers ; worker++)
+        threadManager.add(worker, std::make_shared<WSleep>(), 0, 1);
+    // Same orderer as the multi-GPU pipeline of the wrapper
+    if (numberWorkers > 1u)
+        threadManager.add(
+            numberWorkers, std::make_shared<op::WQueueOrderer<TDatumsSP>>(
+                overwrite ? 2u * numberWorkers : 64u, overwrite), 1, 2);
+    threadManager.start();
+
+    // Consumer: Latency from capture to output (captureTimes is written before pushing each frame)
+    const auto numberFrames = (unsigned long long)FLAGS_overload_fps * FLAGS_overload_seconds;
+    std::vector<std::chrono::steady_clock::time_point> captureTimes(numberFrames);
+    std::vector<double> latencies;
+    auto numberOutOfOrder = 0ull;
+    std::thread consumer{[&]
+    {
+        auto lastId = -1ll;
+        TDatumsSP datumsProcessed;
+        while (threadManager.waitAndPop(datumsProcessed))
+        {
+            const auto id = (long long)datumsProcessed->at(0)->id;
+            latencies.emplace_back(1e-6 * std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - captureTimes[id]).count());
+            if (id <= lastId)
+                numberOutOfOrder++;
+            lastId = id;
+        }
+    }};
+
+    // Live source: Frames are captured at a fixed rate. If pushing blocks, the frames of the missed periods are not
+    // captured (as a camera driver dropping them), so the latency measures the time each frame spends in the queues.
+    // IDs are consecutive among the captured frames (as the ones of WIdGenerator), so WQueueOrderer never waits for
+    // a frame that was not captured
+    const auto period = std::chrono::nanoseconds{(long long)(1e9 / FLAGS_overload_fps)};
+    const auto sourceBegin = std::chrono::steady_clock::now();
+    auto numberCaptured = 0ull;
+    for (auto frame = 0ull ; frame < numberFrames ; frame++)
+    {
+        std::this_thread::sleep_until(sourceBegin + (long long)frame * period);
+        if (std::chrono::steady_clock::now() >= sourceBegin + (long long)(frame+1) * period)
+            continue;
+        auto datumsPtr = std::make_shared<std::vector<std::shared_ptr<op::Datum>>>();
+        datumsPtr->emplace_back(std::make_shared<op::Datum>());
+        datumsPtr->at(0)->id = numberCaptured;
+        captureTimes[numberCaptured] = std::chrono::steady_clock::now();
+        threadManager.waitAndEmplace(datumsPtr);
+        numberCaptured++;
+    }
+    // Let the last frames go through the pipeline
+    std::this_thread::sleep_for(std::chrono::microseconds{
+        (long long)(1e3 * FLAGS_overload_stage_ms * (64 + 2*numberWorkers))});
+    const auto numberDroppedPerQueue = threadManager.getNumberDropped();
+    threadManager.stop();
+    consumer.join();
+
+    // Report (median of the whole run and of its last 10%, which would be higher if the latency kept growing)
+    auto numberDropped = 0ull;
+    for (const auto number : numberDroppedPerQueue)
+        numberDropped += number;
+    std::vector<double> lastLatencies(latencies.begin() + (latencies.size() - latencies.size()/10), latencies.end());
+    std::sort(latencies.begin(), latencies.end());
+    std::sort(lastLatencies.begin(), lastLatencies.end());
+    op::opLog(std::string{overwrite ? "Overwrite-oldest" : "Block"} + " policy (" + std::to_string(numberWorkers)
+              + " worker(s) of " + std::to_string(FLAGS_overload_stage_ms) + " ms, "
+              + std::to_string(FLAGS_overload_fps) + " fps source): median "
+              + std::to_string(getPercentile(latencies, 0.5)) + " ms (last 10%: "
+              + std::to_string(getPercentile(lastLatencies, 0.5)) + " ms), p99 "
+              + std::to_string(getPercentile(latencies, 0.99)) + " ms, " + std::to_string(numberCaptured)
+              + " frames captured, " + std::to_string(latencies.size()) + " output, "
+              + std::to_string(numberDropped) + " dropped in the queues, " + std::to_string(numberOutOfOrder)
+              + " out of order.", op::Priority::High);
+}
+
+int threadLatencyBenchmark()
+{
+    try
+    {
+        op::opLog("Starting thread latency benchmark...", op::Priority::High);
+
+        // logging_level
+        op::checkBool(
+            0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::checkBool(
+            FLAGS_stages > 0 && FLAGS_frames > 0 && FLAGS_idle_seconds >= 0, "Wrong stages/frames/idle_seconds.",
+            __LINE__, __FUNCTION__, __FILE__);
+
+        benchmarkMode(false, false);
+        benchmarkMode(true, false);
+        benchmarkMode(true, true);
+
+        // Overload (latest-frame-wins)
+        if (FLAGS_overload_fps > 0)
+        {
+            op::checkBool(
+                FLAGS_overload_stage_ms > 0. && FLAGS_overload_workers > 0 && FLAGS_overload_seconds > 0,
+                "Wrong overload_stage_ms/overload_workers/overload_seconds.", __LINE__, __FUNCTION__, __FILE__);
+            for (const auto numberWorkers : {1u, (unsigned int)FLAGS_overload_workers})
+            {
+                benchmarkOverload(op::QueueFullPolicy::Block, numberWorkers);
+                benchmarkOverload(op::QueueFullPolicy::OverwriteOldest, numberWorkers);
+            }
+        }
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running threadLatencyBenchmark
+    return threadLatencyBenchmark();
+}
@@ -0,0 +1,166 @@
+// ------------------------- OpenPose Thread Placement Benchmark -------------------------
+// Benchmark of the throughput with and without NUMA-aware thread placement (ThreadManager::setThreadCpus, flag
+// `--pin_threads` on the demo). It emulates the OpenPose pipeline: a producer thread writes each frame, N parallel
+// "GPU" threads read it and stream over their own large buffer (like the net input and heat maps, allocated in
+// initializationOnThread()), and an output thread reads the results. With placement, each GPU thread runs on its own
+// NUMA node and the others on the first one, as Wrapper does. Without it, the OS freely migrates them across
+// sockets. On single-node machines both modes should be equivalent.
+
+// Command-line user interface
+#define OPENPOSE_FLAGS_DISABLE_POSE
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+
+DEFINE_int32(gpus,                      2,                      "Number of parallel GPU-like threads (e.g., 1 per NUMA"
+                                                                " node).");
+DEFINE_int32(buffer_mb,                 64,                     "Size (in MB) of the buffer of each GPU-like thread.");
+DEFINE_int32(frame_mb,                  4,                      "Size (in MB) of each frame.");
+DEFINE_int32(frames,                    300,                    "Number of frames for each mode.");
+
+typedef std::shared_ptr<std::vector<std::shared_ptr<op::Datum>>> TDatumsSP;
+
+// Producer: it writes each frame (on its own thread, so on its node)
+class WFrameProducer : public op::WorkerProducer<TDatumsSP>
+{
+public:
+    void initializationOnThread() {}
+
+    TDatumsSP workProducer()
+    {
+        if (mFrame >= (unsigned long long)FLAGS_frames)
+        {
+            this->stop();
+            return nullptr;
+        }
+        auto datumsPtr = std::make_shared<std::vector<std::shared_ptr<op::Datum>>>();
+        datumsPtr->emplace_back(std::make_shared<op::Datum>());
+        auto& datum = *datumsPtr->at(0);
+        datum.id = mFrame++;
+        datum.outputData.reset(FLAGS_frame_mb * 1024 * 1024 / (int)sizeof(float), float(datum.id % 7));
+        return datumsPtr;
+    }
+
+private:
+    unsigned long long mFrame = 0ull;
+};
+
+// GPU-like stage: it reads the frame and streams over its own buffer, first written (so placed) on its thread
+class WBufferStage : public op::Worker<TDatumsSP>
+{
+public:
+    void initializationOnThread()
+    {
+        mBuffer.assign(FLAGS_buffer_mb * 1024ull * 1024ull / sizeof(float), 1.f);
+    }
+
+    void work(TDatumsSP& datumsPtr)
+    {
+        if (datumsPtr == nullptr || datumsPtr->empty())
+            return;
+        auto& datum = *datumsPtr->at(0);
+        const auto* const frame = datum.outputData.getConstPtr();
+        const auto frameSize = (size_t)datum.outputData.getVolume();
+        auto sum = 0.f;
+        for (auto i = 0ull ; i < mBuffer.size() ; i++)
+        {
+            mBuffer[i] = 0.5f * mBuffer[i] + frame[i % frameSize];
+            sum += mBuffer[i];
+        }
+        datum.outputData[0] = sum;
+    }
+
+private:
+    std::vector<float> mBuffer;
+};
+
+// Output: it reads the results
+class WResultConsumer : public op::WorkerConsumer<TDatumsSP>
+{
+public:
+    void initializationOnThread() {}
+
+    void workConsumer(const TDatumsSP& datumsPtr)
+    {
+        if (datumsPtr != nullptr && !datumsPtr->empty())
+            mChecksum += datumsPtr->at(0)->outputData[0];
+    }
+
+    double mChecksum = 0.;
+};
+
+void benchmarkMode(const bool pinThreads)
+{
+    // Producer (thread 0) -> GPU-like threads (1..N) -> output (N+1)
+    op::ThreadManager<TDatumsSP> threadManager;
+    threadManager.add(0, std::make_shared<WFrameProducer>(), 0, 1);
+    for (auto gpu = 0ull ; gpu < (unsigned long long)FLAGS_gpus ; gpu++)
+        threadManager.add(1 + gpu, std::make_shared<WBufferStage>(), 1, 2);
+    const auto outputThreadId = (unsigned long long)FLAGS_gpus + 1ull;
+    threadManager.add(outputThreadId, std::make_shared<WResultConsumer>(), 2, 3);
+    // Placement (same as Wrapper): GPU thread i on node i * #nodes / #gpus, the others on the first node
+    if (pinThreads)
+    {
+        std::vector<std::vector<int>> numaNodeCpus;
+        for (const auto& cpus : op::getNumaNodeCpus())
+            if (!cpus.empty())
+                numaNodeCpus.emplace_back(cpus);
+        threadManager.setThreadCpus(0, numaNodeCpus.at(0));
+        threadManager.setThreadCpus(outputThreadId, numaNodeCpus.at(0));
+        for (auto gpu = 0u ; gpu < (unsigned int)FLAGS_gpus ; gpu++)
+            threadManager.setThreadCpus(1 + gpu, numaNodeCpus.at(gpu * numaNodeCpus.size() / FLAGS_gpus));
+    }
+
+    // Throughput
+    const auto timerBegin = std::chrono::high_resolution_clock::now();
+    threadManager.exec();
+    const auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(
+        std::chrono::high_resolution_clock::now() - timerBegin).count();
+
+    // Report
+    op::opLog(std::string{pinThreads ? "Placement on: " : "Placement off:"} + " " + std::to_string(FLAGS_frames)
+              + " frames in " + std::to_string(seconds) + " s, " + std::to_string(FLAGS_frames / seconds)
+              + " fps.", op::Priority::High);
+}
+
+int threadPlacementBenchmark()
+{
+    try
+    {
+        op::opLog("Starting thread placement benchmark...", op::Priority::High);
+
+        // logging_level
+        op::checkBool(
+            0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::checkBool(
+            FLAGS_gpus > 0 && FLAGS_buffer_mb > 0 && FLAGS_frame_mb > 0 && FLAGS_frames > 0,
+            "Wrong gpus/buffer_mb/frame_mb/frames.", __LINE__, __FUNCTION__, __FILE__);
+
+        // Topology
+        auto numberNodes = 0;
+        for (const auto& cpus : op::getNumaNodeCpus())
+            numberNodes += (cpus.empty() ? 0 : 1);
+        op::opLog(std::to_string(numberNodes) + " NUMA node(s) with CPUs.", op::Priority::High);
+
+        benchmarkMode(false);
+        benchmarkMode(true);
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running threadPlacementBenchmark
+    return threadPlacementBenchmark();
+}
@@ -0,0 +1,289 @@
+// ------------------------- OpenPose Unity Shared Memory Reader -------------------------
+// Plain C++ reader of the shared memory output of the Unity binding (see UnitySharedMemoryHeader), polling it as Unity
+// would. It only relies on the layout structs, and it does not allocate memory per frame.
+// By default, it also runs an UnitySharedMemoryWriter on another thread, which fills each keypoint and image pixel
+// with its frame sequence, so any torn frame (i.e., mixing data of 2 frames) is detected. Use `--write false` to read
+// the output of the Unity binding (or any other process) instead.
+
+#include <algorithm> // std::max, std::min
+#include <atomic> // std::atomic_thread_fence
+#include <cstring> // std::memcpy
+#include <thread>
+// Third-party dependencies
+#include <opencv2/opencv.hpp>
+// Command-line user interface
+#define OPENPOSE_FLAGS_DISABLE_POSE
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+// Shared memory
+#ifdef _WIN32
+    #include <windows.h> // OpenFileMappingA, MapViewOfFile
+#else
+    #include <fcntl.h> // open
+    #include <sys/mman.h> // mmap
+    #include <unistd.h> // close
+#endif
+
+#ifdef _WIN32
+    DEFINE_string(shared_memory_name,   "Local\\OpenPose",      "Name of the shared memory mapping.");
+#else
+    DEFINE_string(shared_memory_name,   "/dev/shm/openpose",    "Path of the shared memory file.");
+#endif
+DEFINE_bool(write,                      true,                   "If true, it also writes synthetic frames on another"
+                                                                " thread. Otherwise, it only reads the frames of an"
+                                                                " external writer.");
+DEFINE_int32(frames,                    1000,                   "Number of frames to write (or read if `--write"
+                                                                " false`).");
+DEFINE_int32(fps,                       60,                     "Frame rate of the synthetic frames.");
+DEFINE_int32(max_people,                10,                     "Maximum number of people of the synthetic frames.");
+DEFINE_int32(image_width,               320,                    "Width of the synthetic BGR images (0 to write no"
+                                                                " images).");
+DEFINE_int32(image_height,              240,                    "Height of the synthetic BGR images.");
+
+// Plain reader (independent of the writer implementation)
+class SharedMemoryReader
+{
+public:
+    explicit SharedMemoryReader(const std::string& name) :
+        pMemory{nullptr},
+        mTotalBytes{0ull},
+        mLastSequence{0ull}
+    {
+        #ifdef _WIN32
+            mHandle = OpenFileMappingA(FILE_MAP_READ, FALSE, name.c_str());
+            if (mHandle == nullptr)
+                op::error("Shared memory " + name + " not found.", __LINE__, __FUNCTION__, __FILE__);
+            pMemory = (const unsigned char*)MapViewOfFile(mHandle, FILE_MAP_READ, 0, 0, 0);
+        #else
+            const auto fileDescriptor = open(name.c_str(), O_RDONLY);
+            if (fileDescriptor < 0)
+                op::error("Shared memory file " + name + " not found.", __LINE__, __FUNCTION__, __FILE__);
+            // Header first, then the whole region
+            op::UnitySharedMemoryHeader fileHeader;
+            if (read(fileDescriptor, &fileHeader, sizeof(fileHeader)) != (ssize_t)sizeof(fileHeader))
+                op::error("Shared memory file " + name + " too small.", __LINE__, __FUNCTION__, __FILE__);
+            mTotalBytes = fileHeader.totalBytes;
+            auto* memory = mmap(nullptr, (size_t)mTotalBytes, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+            close(fileDescriptor);
+            pMemory = (memory == MAP_FAILED ? nullptr : (const unsigned char*)memory);
+        #endif
+        if (pMemory == nullptr)
+            op::error("Shared memory " + name + " could not be mapped.", __LINE__, __FUNCTION__, __FILE__);
+        const auto& header = *(const op::UnitySharedMemoryHeader*)pMemory;
+        if (load(header.magic) != op::UNITY_SHARED_MEMORY_MAGIC
+            || header.version != op::UNITY_SHARED_MEMORY_VERSION)
+            op::error("Wrong shared memory magic number or version.", __LINE__, __FUNCTION__, __FILE__);
+        mTotalBytes = header.totalBytes;
+        // Destination of the copies, allocated once
+        for (auto group = 0 ; group < op::UNITY_SHARED_MEMORY_GROUPS ; group++)
+            mKeypoints[group].resize(3 * header.maxPeople * header.numberParts[group]);
+        mImage.resize(header.maxImageBytes);
+    }
+
+    ~SharedMemoryReader()
+    {
+        #ifdef _WIN32
+            UnmapViewOfFile(pMemory);
+            CloseHandle(mHandle);
+        #else
+            munmap((void*)pMemory, (size_t)mTotalBytes);
+        #endif
+    }
+
+    // It returns 0 if there is no new frame, or the sequence of the copied frame otherwise. tornReads counts the
+    // copies discarded because the writer overwrote the buffer while it was copied
+    unsigned long long poll(unsigned long long& tornReads)
+    {
+        const auto& header = *(const op::UnitySharedMemoryHeader*)pMemory;
+        while (true)
+        {
+            const auto sequence = load(header.sequence);
+            if (sequence == 0 || sequence == mLastSequence)
+                return 0ull;
+            const auto* const buffer = pMemory + header.bufferOffsets[sequence % 2];
+            const auto& frame = *(const op::UnitySharedMemoryFrame*)buffer;
+            if (load(frame.sequenceEnd) == sequence)
+            {
+                // The frame might be overwritten while it is read, so its sizes are clamped to the allocated ones
+                // (and the copy is discarded below if it was overwritten)
+                mFrame = frame;
+                for (auto group = 0 ; group < op::UNITY_SHARED_MEMORY_GROUPS ; group++)
+                {
+                    mFrame.numberPeople[group] = std::max(0, std::min(mFrame.numberPeople[group], header.maxPeople));
+                    std::memcpy(mKeypoints[group].data(), buffer + header.keypointOffsets[group],
+                                sizeof(float) * 3 * mFrame.numberPeople[group] * header.numberParts[group]);
+                }
+                const auto imageBytes = (mFrame.imageWidth > 0 && mFrame.imageHeight > 0 && mFrame.imageChannels > 0
+                    ? (size_t)mFrame.imageWidth * mFrame.imageHeight * mFrame.imageChannels : 0ul);
+                if (imageBytes > mImage.size())
+                    mFrame.imageWidth = mFrame.imageHeight = mFrame.imageChannels = 0;
+                else if (imageBytes > 0)
+                    std::memcpy(mImage.data(), buffer + header.imageOffset, imageBytes);
+                if (load(frame.sequenceBegin) == sequence)
+                {
+                    mLastSequence = sequence;
+                    return sequence;
+                }
+            }
+            tornReads++;
+        }
+    }
+
+    const op::UnitySharedMemoryFrame& getFrame() const
+    {
+        return mFrame;
+    }
+
+    const std::vector<float>& getKeypoints(const int group) const
+    {
+        return mKeypoints[group];
+    }
+
+    const std::vector<unsigned char>& getImage() const
+    {
+        return mImage;
+    }
+
+private:
+    const unsigned char* pMemory;
+    unsigned long long mTotalBytes;
+    unsigned long long mLastSequence;
+    #ifdef _WIN32
+        HANDLE mHandle;
+    #endif
+    op::UnitySharedMemoryFrame mFrame;
+    std::array<std::vector<float>, op::UNITY_SHARED_MEMORY_GROUPS> mKeypoints;
+    std::vector<unsigned char> mImage;
+
+    template<typename T>
+    static T load(const T& value)
+    {
+        const auto result = *(const volatile T*)&value;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return result;
+    }
+};
+
+int unitySharedMemoryReader()
+{
+    try
+    {
+        op::opLog("Starting Unity shared memory reader...", op::Priority::High);
+
+        // logging_level
+        op::checkBool(
+            0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::checkBool(
+            FLAGS_frames > 0 && FLAGS_fps > 0 && FLAGS_max_people > 0, "Wrong frames/fps/max_people.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::checkBool(
+            FLAGS_image_width >= 0 && FLAGS_image_height > 0, "Wrong image_width/image_height.",
+            __LINE__, __FUNCTION__, __FILE__);
+
+        // Synthetic writer: BODY_25 + face + hands, with up to max_people people (cycling the number of people), and
+        // an image of image_width x image_height
+        std::shared_ptr<op::UnitySharedMemoryWriter> spWriter;
+        std::atomic<bool> writerFinished{!FLAGS_write};
+        std::thread writerThread;
+        if (FLAGS_write)
+        {
+            const std::array<int, op::UNITY_SHARED_MEMORY_GROUPS> numberParts{
+                25, (int)op::FACE_NUMBER_PARTS, (int)op::HAND_NUMBER_PARTS, (int)op::HAND_NUMBER_PARTS};
+            const auto imageBytes = FLAGS_image_width * FLAGS_image_height * 3;
+            spWriter = std::make_shared<op::UnitySharedMemoryWriter>(
+                FLAGS_shared_memory_name, FLAGS_max_people, numberParts, imageBytes);
+            writerThread = std::thread{[&, numberParts, imageBytes]()
+            {
+                op::Datum datum;
+                if (imageBytes > 0)
+                    datum.cvInputData = op::Matrix(FLAGS_image_height, FLAGS_image_width, CV_8UC3);
+                const auto framePeriod = std::chrono::microseconds{1000000 / FLAGS_fps};
+                for (auto frame = 1ull ; frame <= (unsigned long long)FLAGS_frames ; frame++)
+                {
+                    const auto numberPeople = int(frame % (FLAGS_max_people + 1));
+                    datum.frameNumber = frame;
+                    datum.poseKeypoints.reset({numberPeople, numberParts[0], 3}, float(frame));
+                    datum.faceKeypoints.reset({numberPeople, numberParts[1], 3}, float(frame));
+                    datum.handKeypoints[0].reset({numberPeople, numberParts[2], 3}, float(frame));
+                    datum.handKeypoints[1].reset({numberPeople, numberParts[3], 3}, float(frame));
+                    if (imageBytes > 0)
+                        datum.cvInputData.setTo(double(frame % 256));
+                    spWriter->write(datum, imageBytes > 0);
+                    std::this_thread::sleep_for(framePeriod);
+                }
+                writerFinished = true;
+            }};
+        }
+
+        // Poll as Unity would (once per rendered frame, here at twice the writer frame rate)
+        SharedMemoryReader reader{FLAGS_shared_memory_name};
+        auto framesRead = 0ull;
+        auto tornReads = 0ull;
+        auto wrongFrames = 0ull;
+        auto lastSequence = 0ull;
+        auto skippedFrames = 0ull;
+        while (true)
+        {
+            const auto sequence = reader.poll(tornReads);
+            if (sequence > 0)
+            {
+                framesRead++;
+                skippedFrames += sequence - lastSequence - 1;
+                lastSequence = sequence;
+                // Synthetic frames: all the keypoints (and image pixels) of the frame must be its frame number
+                if (FLAGS_write)
+                {
+                    const auto& frame = reader.getFrame();
+                    auto wrongFrame = (frame.frameNumber != sequence);
+                    if (FLAGS_image_width > 0)
+                    {
+                        const auto& image = reader.getImage();
+                        wrongFrame |= (frame.imageWidth != FLAGS_image_width
+                                       || frame.imageHeight != FLAGS_image_height || frame.imageChannels != 3
+                                       || image.size() != (size_t)FLAGS_image_width * FLAGS_image_height * 3);
+                        for (auto i = 0u ; !wrongFrame && i < image.size() ; i++)
+                            wrongFrame |= (image[i] != (unsigned char)(sequence % 256));
+                    }
+                    for (auto group = 0 ; group < op::UNITY_SHARED_MEMORY_GROUPS ; group++)
+                    {
+                        const auto& keypoints = reader.getKeypoints(group);
+                        const auto numberValues = frame.numberPeople[group] * keypoints.size()
+                                                / FLAGS_max_people;
+                        for (auto i = 0u ; i < numberValues ; i++)
+                            wrongFrame |= (keypoints[i] != float(sequence));
+                    }
+                    wrongFrames += wrongFrame;
+                }
+                else if (framesRead == (unsigned long long)FLAGS_frames)
+                    break;
+            }
+            if (writerFinished && lastSequence == (unsigned long long)FLAGS_frames)
+                break;
+            std::this_thread::sleep_for(std::chrono::microseconds{500000 / FLAGS_fps});
+        }
+        if (writerThread.joinable())
+            writerThread.join();
+
+        op::opLog("Frames read: " + std::to_string(framesRead) + ", skipped: " + std::to_string(skippedFrames)
+                  + ", torn reads retried: " + std::to_string(tornReads) + ", wrong frames: "
+                  + std::to_string(wrongFrames) + ".", op::Priority::High);
+        return (wrongFrames == 0 ? 0 : -1);
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running unitySharedMemoryReader
+    return unitySharedMemoryReader();
+}
@@ -0,0 +1,88 @@
+// ------------------------- OpenPose Warm-up Benchmark -------------------------
+// Benchmark of the start-up of a service: the time until the pipeline is hot (Wrapper::warmup) and the latency of the
+// first images afterwards. Run it once with `--warmup true` and once with `--warmup false` (each process starts cold):
+// without warm-up, the first images pay for the lazy network loading, reshapes and first forward passes.
+
+// Third-party dependencies
+#include <opencv2/opencv.hpp>
+// Command-line user interface
+#define OPENPOSE_FLAGS_DISABLE_POSE
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+
+DEFINE_string(image_path,               "examples/media/COCO_val2014_000000000192.jpg",
+                                                                "Image to process.");
+DEFINE_bool(warmup,                     true,                   "Whether to call Wrapper::warmup() (with the image"
+                                                                " resolution) before processing the images.");
+DEFINE_int32(repetitions,               5,                      "Number of measured images.");
+
+double millisecondsSince(const std::chrono::high_resolution_clock::time_point& timerBegin)
+{
+    return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(
+        std::chrono::high_resolution_clock::now() - timerBegin).count();
+}
+
+int warmupBenchmark()
+{
+    try
+    {
+        op::opLog("Starting warm-up benchmark...", op::Priority::High);
+
+        // logging_level
+        op::checkBool(
+            0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::checkBool(FLAGS_repetitions > 0, "Wrong repetitions.", __LINE__, __FUNCTION__, __FILE__);
+
+        // Image
+        const cv::Mat cvImageToProcess = cv::imread(FLAGS_image_path);
+        const op::Matrix imageToProcess = OP_CV2OPCONSTMAT(cvImageToProcess);
+        if (imageToProcess.empty())
+            op::error("Could not open or find the image: " + FLAGS_image_path, __LINE__, __FUNCTION__, __FILE__);
+
+        // Default body configuration and no rendering
+        const auto timerBegin = std::chrono::high_resolution_clock::now();
+        op::Wrapper opWrapper{op::ThreadManagerMode::Asynchronous};
+        op::WrapperStructPose wrapperStructPose;
+        wrapperStructPose.renderMode = op::RenderMode::None;
+        opWrapper.configure(wrapperStructPose);
+        if (FLAGS_warmup)
+        {
+            opWrapper.warmup({op::Point<int>{imageToProcess.cols(), imageToProcess.rows()}});
+            op::opLog("Hot (isHot() = " + std::to_string(opWrapper.isHot()) + ") after "
+                      + std::to_string(millisecondsSince(timerBegin)) + " ms.", op::Priority::High);
+        }
+        else
+            opWrapper.start();
+
+        // Latency of the first images
+        for (auto repetition = 0 ; repetition < FLAGS_repetitions ; repetition++)
+        {
+            const auto timerImage = std::chrono::high_resolution_clock::now();
+            const auto datumsPtr = opWrapper.emplaceAndPop(imageToProcess);
+            const auto numberPeople = (datumsPtr != nullptr && !datumsPtr->empty()
+                ? datumsPtr->at(0)->poseKeypoints.getSize(0) : 0);
+            op::opLog("Image " + std::to_string(repetition) + ": " + std::to_string(millisecondsSince(timerImage))
+                      + " ms (" + std::to_string(numberPeople) + " people).", op::Priority::High);
+        }
+        op::opLog("Total time: " + std::to_string(millisecondsSince(timerBegin)) + " ms.", op::Priority::High);
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running warmupBenchmark
+    return warmupBenchmark();
+}
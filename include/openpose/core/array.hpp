@@ -1,14 +1,23 @@
 #ifndef OPENPOSE_CORE_ARRAY_HPP
 #define OPENPOSE_CORE_ARRAY_HPP
 
+#include <atomic>
 #include <memory> // std::shared_ptr
 #include <vector>
+#include <openpose/core/arrayShape.hpp>
 #include <openpose/core/macros.hpp>
 #include <openpose/core/matrix.hpp>
 #include <openpose/utilities/errorAndLog.hpp>
 
 namespace op
 {
+    /**
+     * Alignment (in bytes) of the memory allocated by Array<T>: one cache line, enough for any SIMD load/store (e.g.,
+     * _mm256_load_ps or AVX-512). Each allocation is also padded up to a multiple of it (see
+     * Array<T>::getPaddedVolume()).
+     */
+    const size_t ARRAY_ALIGNMENT = 64;
+
     /**
      * Array<T>: The OpenPose Basic Raw Data Container
      * This template class implements a multidimensional data array. It is our basic data container, analogous to
@@ -16,6 +25,9 @@ namespace op
      * It wraps a Matrix and a std::shared_ptr, both of them pointing to the same raw data. I.e. they both share the
      * same memory, so we can read and modify this data in both formats with no performance impact.
      * Hence, it keeps high performance while adding high-level functions.
+     * The memory allocated by Array<T> is aligned to ARRAY_ALIGNMENT bytes and padded up to a multiple of it, so SIMD
+     * kernels can use aligned loads/stores over getPaddedVolume() elements without a scalar tail. Arrays wrapping
+     * external memory (dataPtr) or slices (noCopy) keep their original alignment, so check isAligned() first.
      */
     template<typename T>
     class Array
@@ -81,8 +93,10 @@ namespace op
          * @param noCopy indicates whether to perform a copy. Copy will never go to undefined behavior, however, if
          * noCopy == true, then:
          *     1. It is faster, as no data copy is involved, but...
-         *     2. If the Array array goes out of scope, then the resulting Array will provoke an undefined behavior.
-         *     3. If the returned Array is modified, the information in the Array array will also be.
+         *     2. If the Array array wraps external memory (reset(sizes, dataPtr)) and it goes out of scope, then the
+         *        resulting Array will provoke an undefined behavior. Otherwise, it keeps the memory of array alive.
+         *     3. If the returned Array is modified, the information in the Array array will also be. If array
+         *        shares its data with a copy-on-write clone (see clone()), array first gets its own copy of it.
          * @return Array<T> with the same dimension than array expect the first dimension being 1. E.g., if array
          * is {p,k,m}, the resulting Array<T> is {1,k,m}.
          */
@@ -100,7 +114,7 @@ namespace op
             {
                 // Copy
                 for (auto i = 0u ; i < array.getVolume() ; i++)
-                    pData[i] = T(array[i]);
+                    spImpl->pData[i] = T(array[i]);
             }
             catch (const std::exception& e)
             {
@@ -114,6 +128,8 @@ namespace op
          * reference, it still shares the same internal data.
          * Modifying the copied element will modify the original one.
          * Use clone() for a slower but real copy, similarly to cv::Mat and Array<T>.
+         * This also applies to Arrays sharing their data with a copy-on-write clone (see clone()): the copy and array
+         * keep aliasing each other, but not the clone.
          * @param array Array to be copied.
          */
         Array<T>(const Array<T>& array);
@@ -144,8 +160,14 @@ namespace op
         /**
          * Clone function.
          * Similar to cv::Mat::clone and Datum::clone.
-         * It performs a real but slow copy of the data, i.e., even if the copied element is modified, the original
-         * one is not.
+         * It performs a real copy of the data, i.e., even if the copied element is modified, the original one is not.
+         * The copy is lazy (copy-on-write): if the data is owned by this Array and not shared with any other one, both
+         * Arrays share it until the first write access of either of them (non-const operator[], at(), getPtr(),
+         * getCvMat(), setTo(), etc.), which then copies it. Plain copies (copy constructor or assignment) of either
+         * of them share its copy-on-write state (analogously to Matrix), so they keep aliasing their source. External
+         * memory (reset(sizes, dataPtr)) or data shared with noCopy slices is copied immediately.
+         * Raw pointers from getConstPtr() or getPseudoConstPtr() do not detect the sharing, so write through
+         * getPtr() (e.g., as ArrayView does).
          * @return The resulting Array.
          */
         Array<T> clone() const;
@@ -162,6 +184,8 @@ namespace op
          * Data allocation function.
          * Similar to reset(const int size), but it allocates a multi-dimensional array of dimensions each of the
          * values of the argument.
+         * If the Array already owns a buffer of the same volume that is not shared with any other Array, that buffer
+         * is reused (its content is not initialized either way).
          * @param sizes Vector with the size of each dimension. E.g., size = {3, 5, 2} is internally similar to
          * `new T[3*5*2]`.
          */
@@ -207,6 +231,7 @@ namespace op
         /**
          * Data allocation function.
          * It internally allocates memory and copies the data of the argument to the Array allocated memory.
+         * Multi-channel matrices (e.g., BGR images) result in an Array of size {rows, cols, channels}.
          * @param cvMat Matrix to be copied.
          */
         void setFrom(const Matrix& cvMat);
@@ -232,21 +257,35 @@ namespace op
 
         /**
          * Return a vector with the size of each dimension allocated.
+         * Kept for compatibility, but it allocates a new std::vector on each call. Use getShape() or getSize(index)
+         * instead inside loops.
          * @return A std::vector<int> with the size of each dimension. If no memory has been allocated, it will return
          * an empty std::vector.
          */
         inline std::vector<int> getSize() const
+        {
+            return mSize.toVector();
+        }
+
+        /**
+         * Similar to getSize(), but it returns a reference to the internal shape (no heap allocation).
+         * @return An ArrayShape with the size of each dimension. If no memory has been allocated, it will be empty.
+         */
+        inline const ArrayShape& getShape() const noexcept
         {
             return mSize;
         }
 
         /**
-         * Return a vector with the size of the desired dimension.
+         * Return the size of the desired dimension, Matlab style.
          * @param index Dimension to check its size.
-         * @return Size of the desired dimension. It will return 0 if the requested dimension is higher than the number
-         * of dimensions.
+         * @return Size of the desired dimension. If no memory has been allocated, it returns 0. Otherwise, it returns 1
+         * if the requested dimension is negative or not lower than the number of dimensions.
          */
-        int getSize(const int index) const;
+        inline int getSize(const int index) const noexcept
+        {
+            return ((unsigned int)index < mSize.size() ? mSize[index] : int(!mSize.empty()));
+        }
 
         /**
          * Return a string with the size of each dimension allocated.
@@ -286,9 +325,30 @@ namespace op
         size_t getVolume(const int indexA, const int indexB = -1) const;
 
         /**
-         * Return the stride or step size of the array.
+         * Number of elements that can be safely read and written from getPtr(), i.e., getVolume() rounded up to a
+         * multiple of ARRAY_ALIGNMENT / sizeof(T) (at least 1 block, even if getVolume() is 0) if the memory was
+         * allocated by the Array, or getVolume() if it wraps external memory. The padding elements are not
+         * initialized and do not belong to the Array data.
+         * @return The number of allocated elements.
+         */
+        inline size_t getPaddedVolume() const
+        {
+            return mPaddedVolume;
+        }
+
+        /**
+         * Whether getPtr() is aligned to ARRAY_ALIGNMENT bytes. Always true for memory allocated by the Array, but
+         * not necessarily for external memory (reset(sizes, dataPtr)) or slices (noCopy).
+         * @return True if it is aligned (or empty), false otherwise.
+         */
+        bool isAligned() const;
+
+        /**
+         * Return the stride or step size (in bytes) of the array.
          * E.g., given and Array<T> of size 5x3, getStride() would return the following vector:
          * {5x3sizeof(T), 3sizeof(T), sizeof(T)}.
+         * The data is contiguous (no padding between rows), so a row or plane is only aligned if getPtr() is and its
+         * stride is a multiple of ARRAY_ALIGNMENT.
          */
         std::vector<int> getStride() const;
 
@@ -309,7 +369,8 @@ namespace op
          */
         inline T* getPtr()
         {
-            return pData; // spData.get()
+            beforeWrite();
+            return (spImpl != nullptr ? spImpl->pData : nullptr); // spData.get()
         }
 
         /**
@@ -318,7 +379,7 @@ namespace op
          */
         inline const T* getConstPtr() const
         {
-            return pData; // spData.get()
+            return (spImpl != nullptr ? spImpl->pData : nullptr); // spData.get()
         }
 
         /**
@@ -328,7 +389,7 @@ namespace op
          */
         inline T* getPseudoConstPtr() const
         {
-            return pData; // spData.get()
+            return (spImpl != nullptr ? spImpl->pData : nullptr); // spData.get()
         }
 
         /**
@@ -365,7 +426,8 @@ namespace op
         inline T& operator[](const int index)
         {
             #ifdef NDEBUG
-                return pData[index]; // spData.get()[index]
+                beforeWrite();
+                return spImpl->pData[index]; // spData.get()[index]
             #else
                 return at(index);
             #endif
@@ -381,7 +443,7 @@ namespace op
         inline const T& operator[](const int index) const
         {
             #ifdef NDEBUG
-                return pData[index]; // spData.get()[index]
+                return spImpl->pData[index]; // spData.get()[index]
             #else
                 return at(index);
             #endif
@@ -421,6 +483,7 @@ namespace op
          */
         inline T& at(const int index)
         {
+            beforeWrite();
             return commonAt(index);
         }
 
@@ -475,11 +538,46 @@ namespace op
         const std::string toString() const;
 
     private:
-        std::vector<int> mSize;
+        ArrayShape mSize;
         size_t mVolume;
-        std::shared_ptr<T> spData;
-        T* pData; // pData is a wrapper of spData. Used for Pybind11 binding.
-        std::pair<bool, Matrix> mCvMatData;
+        size_t mPaddedVolume;
+        /**
+         * Data shared by an Array and its plain copies, analogously to Matrix::ImplMatrix. Copy-on-write clones (see
+         * clone()) have their own ImplArray, pointing to the same spData until the first write.
+         */
+        struct ImplArray
+        {
+            std::shared_ptr<T> spData;
+            T* pData; // pData is a wrapper of spData. Used for Pybind11 binding.
+            std::pair<bool, Matrix> mCvMatData;
+            // Whether spData might be shared with a copy-on-write clone (see clone())
+            std::atomic<bool> mCopyOnWrite;
+
+            ImplArray() :
+                pData{nullptr},
+                mCvMatData{true, Matrix()},
+                mCopyOnWrite{false}
+            {
+            }
+        };
+        // Null only for moved Arrays
+        std::shared_ptr<ImplArray> spImpl;
+
+        /**
+         * Write barrier of the copy-on-write clones, called by all the non-const data access functions.
+         */
+        inline void beforeWrite()
+        {
+            if (spImpl != nullptr && spImpl->mCopyOnWrite.load(std::memory_order_relaxed))
+                detach();
+        }
+
+        /**
+         * If spData is still shared with a clone, it allocates a new buffer for this Array and its plain copies. It
+         * only modifies the shared ImplArray, but not the data values, so it is also used on const Arrays.
+         * @param copyData Whether to copy the current data into the new buffer (false if it will be overwritten).
+         */
+        void detach(const bool copyData = true) const;
 
         /**
          * Auxiliary function that both operator[](const std::vector<int>& indexes) and
@@ -0,0 +1,104 @@
+#ifndef OPENPOSE_CORE_ARRAY_SHAPE_HPP
+#define OPENPOSE_CORE_ARRAY_SHAPE_HPP
+
+#include <string>
+#include <vector>
+#include <openpose/utilities/errorAndLog.hpp>
+
+namespace op
+{
+    /**
+     * ArrayShape: Size of each dimension of an Array<T>, stored inline (no heap allocation) for up to MAX_DIMENSIONS
+     * dimensions. Its accessors are noexcept and do not check the bounds (analogous to std::vector::operator[]), so
+     * they can be used inside per-keypoint loops.
+     */
+    class ArrayShape
+    {
+    public:
+        static const unsigned int MAX_DIMENSIONS = 6u;
+
+        constexpr ArrayShape() noexcept :
+            mSizes{},
+            mNumberDimensions{0u}
+        {
+        }
+
+        /**
+         * It throws an error if sizes has more than MAX_DIMENSIONS elements.
+         */
+        ArrayShape(const std::vector<int>& sizes) :
+            mSizes{},
+            mNumberDimensions{(unsigned int)sizes.size()}
+        {
+            if (mNumberDimensions > MAX_DIMENSIONS)
+                error("Array<T> only supports up to " + std::to_string(MAX_DIMENSIONS) + " dimensions, but "
+                      + std::to_string(sizes.size()) + " were requested.", __LINE__, __FUNCTION__, __FILE__);
+            for (auto i = 0u ; i < mNumberDimensions ; i++)
+                mSizes[i] = sizes[i];
+        }
+
+        constexpr unsigned int size() const noexcept
+        {
+            return mNumberDimensions;
+        }
+
+        constexpr bool empty() const noexcept
+        {
+            return mNumberDimensions == 0u;
+        }
+
+        constexpr int operator[](const unsigned int index) const noexcept
+        {
+            return mSizes[index];
+        }
+
+        inline int& operator[](const unsigned int index) noexcept
+        {
+            return mSizes[index];
+        }
+
+        inline const int* data() const noexcept
+        {
+            return mSizes;
+        }
+
+        inline const int* begin() const noexcept
+        {
+            return mSizes;
+        }
+
+        inline const int* end() const noexcept
+        {
+            return mSizes + mNumberDimensions;
+        }
+
+        /**
+         * Compatibility with the std::vector<int> API (e.g., Array<T>::getSize()). It allocates memory.
+         */
+        inline std::vector<int> toVector() const
+        {
+            return std::vector<int>(begin(), end());
+        }
+
+        inline bool operator==(const ArrayShape& arrayShape) const noexcept
+        {
+            if (mNumberDimensions != arrayShape.mNumberDimensions)
+                return false;
+            for (auto i = 0u ; i < mNumberDimensions ; i++)
+                if (mSizes[i] != arrayShape.mSizes[i])
+                    return false;
+            return true;
+        }
+
+        inline bool operator!=(const ArrayShape& arrayShape) const noexcept
+        {
+            return !(*this == arrayShape);
+        }
+
+    private:
+        int mSizes[MAX_DIMENSIONS];
+        unsigned int mNumberDimensions;
+    };
+}
+
+#endif // OPENPOSE_CORE_ARRAY_SHAPE_HPP
@@ -0,0 +1,210 @@
+#ifndef OPENPOSE_CORE_ARRAY_VIEW_HPP
+#define OPENPOSE_CORE_ARRAY_VIEW_HPP
+
+#include <type_traits> // std::enable_if, std::is_const, std::remove_const
+#include <openpose/core/array.hpp>
+#include <openpose/core/arrayShape.hpp>
+#include <openpose/utilities/errorAndLog.hpp>
+
+namespace op
+{
+    /**
+     * ArrayView<T>: Non-owning view of the data of an Array<T> (or any raw memory), made of a pointer, a shape and
+     * the stride of each dimension. Unlike Array<T>(array, index, true), creating, copying or slicing it involves no
+     * heap allocation nor reference counting, so it is meant to be passed by value inside per-person or
+     * per-channel loops.
+     * Analogously to Array<T>(array, index, true), the viewed memory must outlive the view. Use ArrayView<const T>
+     * for read-only access (it can be created from a const Array<T>).
+     */
+    template<typename T>
+    class ArrayView
+    {
+    public:
+        typedef typename std::remove_const<T>::type TNonConst;
+
+        ArrayView() noexcept :
+            pData{nullptr},
+            mVolume{0ul},
+            mContiguous{true}
+        {
+        }
+
+        /**
+         * Contiguous (row-major) view of dataPtr.
+         */
+        ArrayView(T* const dataPtr, const ArrayShape& shape) noexcept :
+            pData{dataPtr},
+            mShape(shape),
+            mStrides(shape),
+            mVolume{shape.empty() ? 0ul : 1ul},
+            mContiguous{true}
+        {
+            for (auto i = (int)mShape.size() - 1 ; i >= 0 ; i--)
+            {
+                mStrides[i] = (int)mVolume;
+                mVolume *= mShape[i];
+            }
+        }
+
+        /**
+         * Strided view of dataPtr.
+         * @param strides Distance (in elements, not bytes) between 2 consecutive indexes of each dimension.
+         */
+        ArrayView(T* const dataPtr, const ArrayShape& shape, const ArrayShape& strides) noexcept :
+            pData{dataPtr},
+            mShape(shape),
+            mStrides(strides),
+            mVolume{shape.empty() ? 0ul : 1ul},
+            mContiguous{true}
+        {
+            for (auto i = (int)mShape.size() - 1 ; i >= 0 ; i--)
+            {
+                // Strides of dimensions of size 1 are irrelevant (e.g., slice(0, person))
+                if (mShape[i] > 1 && mStrides[i] != (int)mVolume)
+                    mContiguous = false;
+                mVolume *= mShape[i];
+            }
+        }
+
+        /**
+         * Only available for ArrayView<T> with non-const T. ArrayView<const T> uses the const Array<T> one, so reading
+         * a copy-on-write clone (see Array<T>::clone()) does not copy its data.
+         */
+        template<typename U = T, typename std::enable_if<!std::is_const<U>::value, int>::type = 0>
+        ArrayView(Array<TNonConst>& array) noexcept :
+            ArrayView{array.getPtr(), array.getShape()}
+        {
+        }
+
+        /**
+         * Only available for ArrayView<const T>.
+         */
+        ArrayView(const Array<TNonConst>& array) noexcept :
+            ArrayView{array.getConstPtr(), array.getShape()}
+        {
+        }
+
+        /**
+         * Conversion from ArrayView<TNonConst> into ArrayView<const TNonConst>.
+         */
+        ArrayView(const ArrayView<TNonConst>& arrayView) noexcept :
+            pData{arrayView.getPtr()},
+            mShape(arrayView.getShape()),
+            mStrides(arrayView.getStrides()),
+            mVolume{arrayView.getVolume()},
+            mContiguous{arrayView.isContiguous()}
+        {
+        }
+
+        inline bool empty() const noexcept
+        {
+            return (mVolume == 0ul);
+        }
+
+        inline const ArrayShape& getShape() const noexcept
+        {
+            return mShape;
+        }
+
+        /**
+         * Analogous to Array<T>::getSize(const int index): 0 if empty, 1 if index is not a valid dimension.
+         */
+        inline int getSize(const int index) const noexcept
+        {
+            return ((unsigned int)index < mShape.size() ? mShape[index] : int(!mShape.empty()));
+        }
+
+        inline size_t getNumberDimensions() const noexcept
+        {
+            return mShape.size();
+        }
+
+        inline size_t getVolume() const noexcept
+        {
+            return mVolume;
+        }
+
+        /**
+         * Stride of each dimension, in elements (unlike Array<T>::getStride(), which is in bytes).
+         */
+        inline const ArrayShape& getStrides() const noexcept
+        {
+            return mStrides;
+        }
+
+        inline int getStride(const int index) const noexcept
+        {
+            return mStrides[index];
+        }
+
+        /**
+         * Whether the view is row-major contiguous, i.e., operator[] is a plain pointer access.
+         */
+        inline bool isContiguous() const noexcept
+        {
+            return mContiguous;
+        }
+
+        /**
+         * Pointer to the first element of the view.
+         */
+        inline T* getPtr() const noexcept
+        {
+            return pData;
+        }
+
+        /**
+         * Element access by its 3 indexes (e.g., person, body part and x/y/score for keypoints), using the strides.
+         */
+        inline T& operator()(const int index0, const int index1, const int index2) const noexcept
+        {
+            return pData[index0*mStrides[0] + index1*mStrides[1] + index2*mStrides[2]];
+        }
+
+        /**
+         * Element access by its row-major index, as Array<T>::operator[]. It is a plain pointer access for
+         * contiguous views, and it computes the index of each dimension otherwise.
+         * If debug mode is enabled, then it will check that the desired index is in the data range.
+         */
+        T& operator[](const int index) const
+        {
+            #ifndef NDEBUG
+                if (index < 0 || (size_t)index >= mVolume)
+                    error("Index out of bounds: 0 <= index && index < mVolume", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+            if (mContiguous)
+                return pData[index];
+            auto offset = 0;
+            auto remainder = index;
+            for (auto i = (int)mShape.size() - 1 ; i >= 0 ; i--)
+            {
+                offset += (remainder % mShape[i]) * mStrides[i];
+                remainder /= mShape[i];
+            }
+            return pData[offset];
+        }
+
+        /**
+         * It returns the view of a single index of a dimension, keeping the number of dimensions. E.g., for
+         * keypoints of size {p,k,3}, slice(0, person) returns the {1,k,3} keypoints of that person (analogous to
+         * getKeypointsPerson with noCopy = true), and slice(2, 2) the {p,k,1} scores of all of them.
+         */
+        ArrayView<T> slice(const int dimension, const int index) const
+        {
+            if ((unsigned int)dimension >= mShape.size() || index < 0 || index >= mShape[dimension])
+                error("Dimension or index out of range.", __LINE__, __FUNCTION__, __FILE__);
+            auto shape = mShape;
+            shape[dimension] = 1;
+            return ArrayView<T>{pData + index*mStrides[dimension], shape, mStrides};
+        }
+
+    private:
+        T* pData;
+        ArrayShape mShape;
+        ArrayShape mStrides;
+        size_t mVolume;
+        bool mContiguous;
+    };
+}
+
+#endif // OPENPOSE_CORE_ARRAY_VIEW_HPP
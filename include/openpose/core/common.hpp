@@ -9,6 +9,7 @@
 // OpenPose most used classes
 #include <openpose/core/array.hpp>
 #include <openpose/core/arrayCpuGpu.hpp>
+#include <openpose/core/arrayView.hpp>
 #include <openpose/core/macros.hpp>
 #include <openpose/core/matrix.hpp>
 #include <openpose/core/point.hpp>
@@ -17,6 +17,14 @@ namespace op
             const Matrix& inputData, const std::vector<double>& scaleInputToNetInputs,
             const std::vector<Point<int>>& netInputSizes);
 
+        /**
+         * Similar to createArray(), but it fills inputNetData in place, reusing its buffers if their shapes match
+         * (e.g., for recycled Datums).
+         */
+        void fillArray(
+            std::vector<Array<float>>& inputNetData, const Matrix& inputData,
+            const std::vector<double>& scaleInputToNetInputs, const std::vector<Point<int>>& netInputSizes);
+
     private:
         const PoseModel mPoseModel;
         const bool mGpuResize;
@@ -18,6 +18,14 @@ namespace op
         Array<float> createArray(
             const Matrix& inputData, const double scaleInputToOutput, const Point<int>& outputResolution);
 
+        /**
+         * Similar to createArray(), but it fills outputData in place, reusing its buffer if its shape matches (e.g.,
+         * for recycled Datums).
+         */
+        void fillArray(
+            Array<float>& outputData, const Matrix& inputData, const double scaleInputToOutput,
+            const Point<int>& outputResolution);
+
     private:
         const bool mGpuResize;
         unsigned char* pInputImageCuda;
@@ -6,6 +6,7 @@
         #include <Eigen/Core>
     #endif
 #endif
+#include <chrono>
 #include <openpose/core/common.hpp>
 
 namespace op
@@ -37,6 +38,25 @@ namespace op
          */
         unsigned long long frameNumber;
 
+        /**
+         * Optional absolute deadline (e.g., capture time + latency budget). The default value (the steady_clock epoch)
+         * means no deadline. If it passes, the expensive workers (body, face and hand estimation, rendering) and the
+         * output ones (GUI, savers, etc.) skip this Datum, but it still goes through the pipeline (so IDs and
+         * ordering are kept) with `expired` set to true.
+         */
+        std::chrono::steady_clock::time_point deadline;
+
+        /**
+         * Whether `deadline` passed before the Datum finished the pipeline, so some of its results are missing.
+         */
+        bool expired;
+
+        /**
+         * Whether it is a frame of Wrapper::warmup(), so the workers that keep state among frames (motion gate,
+         * net resolution controller, ROI, tracking and person IDs) must ignore it.
+         */
+        bool warmup;
+
         // ------------------------------ Input image and rendered version parameters ------------------------------ //
         /**
          * Original image to be processed in cv::Mat uchar format.
@@ -326,8 +346,9 @@ namespace op
         /**
          * Clone function.
          * Similar to cv::Mat::clone and Array<T>::clone.
-         * It performs a real but slow copy of the data, i.e., even if the copied element is modified, the original
-         * one is not.
+         * It performs a real copy of the data, i.e., even if the copied element is modified, the original one is not.
+         * The images (Matrix) and Array<T> elements are copy-on-write (see Array<T>::clone() and Matrix::clone()):
+         * their data is shared until either Datum modifies it, so cloning is cheap for read-only consumers.
          * @return The resulting Datum.
          */
         Datum clone() const;
@@ -38,6 +38,27 @@ namespace op
         AddKeypoints,
         AddPAFs,
     };
+
+    /**
+     * Element type of the KeypointSet columns.
+     */
+    enum class KeypointStorage : unsigned char
+    {
+        Float32,
+        Float16, // IEEE 754 half precision: half the memory, ~3 significant digits (e.g., 0.5 px error at x = 2048)
+    };
+
+    /**
+     * Keypoint groups of a KeypointSet, matching the Datum keypoint elements.
+     */
+    enum class KeypointGroup : unsigned char
+    {
+        Pose,
+        Face,
+        LeftHand,
+        RightHand,
+        Size,
+    };
 }
 
 #endif // OPENPOSE_CORE_ENUM_CLASSES_HPP
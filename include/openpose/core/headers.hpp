@@ -4,6 +4,8 @@
 // core module
 #include <openpose/core/array.hpp>
 #include <openpose/core/arrayCpuGpu.hpp>
+#include <openpose/core/arrayShape.hpp>
+#include <openpose/core/arrayView.hpp>
 #include <openpose/core/common.hpp>
 #include <openpose/core/cvMatToOpInput.hpp>
 #include <openpose/core/cvMatToOpOutput.hpp>
@@ -12,8 +14,11 @@
 #include <openpose/core/gpuRenderer.hpp>
 #include <openpose/core/keepTopNPeople.hpp>
 #include <openpose/core/keypointScaler.hpp>
+#include <openpose/core/keypointSet.hpp>
 #include <openpose/core/macros.hpp>
 #include <openpose/core/matrix.hpp>
+#include <openpose/core/motionGate.hpp>
+#include <openpose/core/netResolutionController.hpp>
 #include <openpose/core/opOutputToCvMat.hpp>
 #include <openpose/core/point.hpp>
 #include <openpose/core/rectangle.hpp>
@@ -25,6 +30,8 @@
 #include <openpose/core/wCvMatToOpOutput.hpp>
 #include <openpose/core/wKeepTopNPeople.hpp>
 #include <openpose/core/wKeypointScaler.hpp>
+#include <openpose/core/wMotionGate.hpp>
+#include <openpose/core/wNetResolutionController.hpp>
 #include <openpose/core/wOpOutputToCvMat.hpp>
 #include <openpose/core/wScaleAndSizeExtractor.hpp>
 #include <openpose/core/wVerbosePrinter.hpp>
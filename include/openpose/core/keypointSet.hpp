@@ -0,0 +1,169 @@
+#ifndef OPENPOSE_CORE_KEYPOINT_SET_HPP
+#define OPENPOSE_CORE_KEYPOINT_SET_HPP
+
+#include <array>
+#include <memory> // std::shared_ptr
+#include <openpose/core/array.hpp>
+#include <openpose/core/enumClasses.hpp>
+#include <openpose/core/macros.hpp>
+
+namespace op
+{
+    struct Datum;
+
+    /**
+     * Conversion between float and IEEE 754 half precision (round to nearest even, with infinities, NaNs and
+     * subnormals).
+     */
+    OP_API unsigned short floatToHalf(const float value);
+
+    OP_API float halfToFloat(const unsigned short value);
+
+    /**
+     * KeypointSet: Columnar (SoA) representation of the keypoints of a frame, as an optional alternative to the
+     * interleaved Array<float> {people x parts x channels} elements of Datum (poseKeypoints, faceKeypoints,
+     * handKeypoints, and their 3-D versions).
+     * All the groups (KeypointGroup) share a single 64-byte-aligned allocation, made of one column per channel (x, y,
+     * score for 2-D keypoints, or x, y, z, score for 3-D ones). Each column holds the {people x parts} values of each
+     * group contiguously, so e.g. all the x coordinates of the body parts of all people are a single contiguous
+     * vector. Columns can be stored as float or, to halve the memory and bandwidth, as half precision floats
+     * (KeypointStorage::Float16).
+     * Analogously to Array<T>, copying a KeypointSet shares its data, while clone() copies it.
+     */
+    class OP_API KeypointSet
+    {
+    public:
+        static const int NUMBER_GROUPS = (int)KeypointGroup::Size;
+
+        explicit KeypointSet(const KeypointStorage keypointStorage = KeypointStorage::Float32);
+
+        KeypointSet clone() const;
+
+        /**
+         * It allocates the columns for numberPeople people with numberParts[group] parts on each group, and
+         * initializes all the values to 0 (i.e., not detected). The memory is reused if the total size does not
+         * change and it is not shared with other KeypointSet copies.
+         * @param numberChannels 3 for 2-D keypoints (x, y, score), 4 for 3-D ones (x, y, z, score).
+         */
+        void reset(
+            const int numberPeople, const std::array<int, NUMBER_GROUPS>& numberParts, const int numberChannels = 3);
+
+        /**
+         * It fills the KeypointSet from the interleaved keypoint Arrays of each group (empty Arrays are ignored), with
+         * a single allocation for all of them. All the non-empty Arrays must have the same number of people and
+         * channels.
+         */
+        void setFrom(const std::array<const Array<float>*, NUMBER_GROUPS>& keypointArrays);
+
+        /**
+         * Same as setFrom(keypointArrays), taking the 2-D (or 3-D if threeD) keypoint elements of the datum.
+         */
+        void setFrom(const Datum& datum, const bool threeD = false);
+
+        /**
+         * It converts back the desired group into an interleaved Array<float> {people x parts x channels}. The
+         * Array memory is reused if possible (see Array<T>::reset()). An empty group results in an empty Array.
+         */
+        void toArray(Array<float>& keypoints, const KeypointGroup keypointGroup) const;
+
+        Array<float> toArray(const KeypointGroup keypointGroup) const;
+
+        /**
+         * It converts back all the groups into the 2-D (or 3-D if threeD) keypoint elements of the datum.
+         */
+        void copyTo(Datum& datum, const bool threeD = false) const;
+
+        inline bool empty() const
+        {
+            return (mNumberPeople == 0);
+        }
+
+        inline KeypointStorage getStorage() const
+        {
+            return mKeypointStorage;
+        }
+
+        inline int getNumberPeople() const
+        {
+            return mNumberPeople;
+        }
+
+        inline int getNumberParts(const KeypointGroup keypointGroup) const
+        {
+            return mNumberParts[(int)keypointGroup];
+        }
+
+        inline int getNumberChannels() const
+        {
+            return mNumberChannels;
+        }
+
+        /**
+         * Number of bytes of the single allocation (all groups and channels, including the alignment padding).
+         */
+        size_t getNumberBytes() const;
+
+        /**
+         * Value of a keypoint channel (converted to float if KeypointStorage::Float16). No bounds checking.
+         */
+        inline float get(
+            const KeypointGroup keypointGroup, const int person, const int part, const int channel) const
+        {
+            const auto elementIndex = getElementIndex(keypointGroup, person, part, channel);
+            if (mKeypointStorage == KeypointStorage::Float16)
+                return halfToFloat(((const unsigned short*)spData.get())[elementIndex]);
+            return ((const float*)spData.get())[elementIndex];
+        }
+
+        inline void set(
+            const KeypointGroup keypointGroup, const int person, const int part, const int channel,
+            const float value)
+        {
+            const auto elementIndex = getElementIndex(keypointGroup, person, part, channel);
+            if (mKeypointStorage == KeypointStorage::Float16)
+                ((unsigned short*)spData.get())[elementIndex] = floatToHalf(value);
+            else
+                ((float*)spData.get())[elementIndex] = value;
+        }
+
+        /**
+         * Column of a channel of a group: {people x parts} contiguous values, i.e., the value of (person, part) is
+         * column[person * getNumberParts(keypointGroup) + part]. Only for KeypointStorage::Float32 (it throws an
+         * error otherwise).
+         */
+        float* getColumn(const KeypointGroup keypointGroup, const int channel);
+
+        const float* getConstColumn(const KeypointGroup keypointGroup, const int channel) const;
+
+        /**
+         * Analogous to getColumn(), for KeypointStorage::Float16 (raw IEEE 754 half precision values, see
+         * halfToFloat() and floatToHalf()).
+         */
+        unsigned short* getHalfColumn(const KeypointGroup keypointGroup, const int channel);
+
+        const unsigned short* getConstHalfColumn(const KeypointGroup keypointGroup, const int channel) const;
+
+    private:
+        KeypointStorage mKeypointStorage;
+        int mNumberPeople;
+        int mNumberChannels;
+        std::array<int, NUMBER_GROUPS> mNumberParts;
+        // Offset (in elements) of each group inside each column
+        std::array<size_t, NUMBER_GROUPS> mGroupOffsets;
+        // Elements of each column, padded so each column is 64-byte aligned
+        size_t mColumnStride;
+        std::shared_ptr<unsigned char> spData;
+
+        inline size_t getElementIndex(
+            const KeypointGroup keypointGroup, const int person, const int part, const int channel) const
+        {
+            const auto group = (int)keypointGroup;
+            return channel * mColumnStride + mGroupOffsets[group] + (size_t)person * mNumberParts[group] + part;
+        }
+
+        void checkColumn(const KeypointGroup keypointGroup, const int channel,
+                         const KeypointStorage keypointStorage) const;
+    };
+}
+
+#endif // OPENPOSE_CORE_KEYPOINT_SET_HPP
@@ -126,6 +126,13 @@ namespace op
          */
         explicit Matrix(const int rows, const int cols, const int type, void* cvMatPtr);
 
+        /**
+         * Analog to cv::Mat::clone, but copy-on-write: if the data is owned by this Matrix (and its copies), it is
+         * shared until the first write of either Matrix (getCvMat(), data(), setTo() or copyTo() into it), which then
+         * copies it. External memory (e.g., the Matrix of an Array<T>) is copied immediately.
+         * Reading through getConstCvMat() or dataConst() never copies the data, while dataPseudoConst() does not
+         * detect writes.
+         */
         Matrix clone() const;
 
         /**
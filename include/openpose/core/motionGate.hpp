@@ -0,0 +1,123 @@
+#ifndef OPENPOSE_CORE_MOTION_GATE_HPP
+#define OPENPOSE_CORE_MOTION_GATE_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Snapshot returned by MotionGate::getStatistics() (and WrapperT::getMotionGateStatistics()).
+     */
+    struct OP_API MotionGateStatistics
+    {
+        unsigned long long numberFrames;
+        // Frames that reused the results of a previous frame
+        unsigned long long numberSkippedFrames;
+        // Frames first skipped but whose reference results were not available (expired, or still being processed by
+        // another GPU and the frame could not be deferred), so they ran the body network themselves (or were left
+        // without results if deferred). They are not counted in numberSkippedFrames
+        unsigned long long numberUnfilledFrames;
+        // Mean absolute difference per pixel of the last frame checked (useful to tune the threshold), -1 if none
+        double lastDifference;
+
+        MotionGateStatistics();
+    };
+
+    /**
+     * MotionGate: Skips the body network on frames with negligible scene change (e.g., static cameras).
+     * Each frame is downscaled to a grayscale thumbnail and compared with the thumbnail of the last processed
+     * (i.e., not skipped) frame. If the mean absolute difference per pixel is below a threshold, the frame is
+     * skipped and it will reuse the body keypoints of that last processed frame. At most maxSkippedFrames
+     * consecutive frames are skipped, so results are refreshed periodically.
+     * All functions are thread-safe, so it can be shared among the PoseExtractor of each GPU. No function blocks:
+     * with several GPUs, a skipped frame whose reference is still being processed by another GPU is either deferred
+     * (its results are filled after the GPU threads, see isDeferred()) or runs the body network itself.
+     */
+    class OP_API MotionGate
+    {
+    public:
+        /**
+         * @param threshold Maximum mean absolute difference per thumbnail pixel (in gray levels, i.e., [0, 255])
+         * to consider that the scene did not change.
+         * @param maxSkippedFrames Maximum number of consecutive skipped frames.
+         * @param thumbnailWidth Width of the thumbnail (height keeps the aspect ratio).
+         * @param deferFrames Whether the skipped frames whose reference is not processed yet are deferred. It
+         * requires a WMotionGate filling them after the GPU threads, and nothing in those threads using their body
+         * keypoints for the output (e.g., GPU rendering).
+         */
+        MotionGate(const double threshold, const int maxSkippedFrames, const int thumbnailWidth = 64,
+                   const bool deferFrames = false);
+
+        virtual ~MotionGate();
+
+        /**
+         * It decides whether the frame should be skipped. It must be called in order (before any multi-threading).
+         * @return Whether the frame will be skipped.
+         */
+        bool checkSkip(const Matrix& cvInputData, const unsigned long long id);
+
+        bool isSkipped(const unsigned long long id) const;
+
+        /**
+         * It saves the body results of a processed frame, so skipped frames can reuse them.
+         */
+        void setResults(const unsigned long long id, const Array<float>& poseKeypoints,
+                        const Array<float>& poseScores);
+
+        /**
+         * It returns the body results (poseKeypoints and poseScores) for a skipped frame if the frame it depends on
+         * has already been processed. It never waits: if that frame is still being processed (e.g., by another GPU),
+         * the skipped frame is deferred (if enabled, leaving both arrays empty) or it runs the body network.
+         * @return Whether the body network must be skipped (results filled or deferred). False if the frame was not
+         * skipped, the frame it depends on expired (see setExpired()) or is not ready and deferring is disabled.
+         */
+        bool getResults(const unsigned long long id, Array<float>& poseKeypoints, Array<float>& poseScores);
+
+        /**
+         * Whether the frame was deferred by getResults(), so its results are filled after the GPU threads.
+         */
+        bool isDeferred(const unsigned long long id) const;
+
+        /**
+         * It must be called for each deferred frame once the frames before it went through the GPU threads (i.e.,
+         * after sorting them), so the frame it depends on is already processed or expired.
+         * @return Whether the frame it depends on was processed, so the deferred frame can reuse its results.
+         */
+        bool endDeferred(const unsigned long long id);
+
+        /**
+         * It is called instead of setResults() or getResults() for a frame whose deadline (Datum::deadline) passed
+         * before the body network. If it was a processed frame, the frames skipped because of it will run the body
+         * network themselves, and the next frame will be processed. It is also called instead of endDeferred() for
+         * a deferred frame that expired afterwards.
+         */
+        void setExpired(const unsigned long long id);
+
+        /**
+         * No more frames are skipped. Called when the pipeline stops, since the frames they depend on might never be
+         * processed.
+         */
+        void stop();
+
+        MotionGateStatistics getStatistics() const;
+
+        unsigned long long getNumberFrames() const;
+
+        unsigned long long getNumberSkippedFrames() const;
+
+        /**
+         * Mean absolute difference per pixel of the last frame checked (useful to tune the threshold).
+         */
+        double getLastDifference() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplMotionGate;
+        std::shared_ptr<ImplMotionGate> spImpl;
+
+        DELETE_COPY(MotionGate);
+    };
+}
+
+#endif // OPENPOSE_CORE_MOTION_GATE_HPP
@@ -0,0 +1,58 @@
+#ifndef OPENPOSE_CORE_NET_RESOLUTION_CONTROLLER_HPP
+#define OPENPOSE_CORE_NET_RESOLUTION_CONTROLLER_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * NetResolutionController: Latency-driven selection of the pose net input height.
+     * It measures the latency of each frame (from frameStarted to frameFinished) and moves the net input height
+     * among a fixed set of resolutions, keeping the highest one whose latency fits in the target budget:
+     * - It moves to the next lower resolution after several consecutive frames over budget.
+     * - It moves to the next higher resolution only after many consecutive frames whose latency, extrapolated to
+     *   the higher resolution, would still fit in the budget (hysteresis).
+     * It starts at the highest resolution. The resolutions are not pre-warmed, i.e., the network is reshaped by the
+     * first frame after each switch, so that frame is not considered, nor are the frames started with a different
+     * resolution than the current one (in flight while switching).
+     * All functions are thread-safe.
+     */
+    class OP_API NetResolutionController
+    {
+    public:
+        /**
+         * @param netInputHeight Highest net input height (multiple of 16).
+         * @param latencyBudget Target latency per frame (in milliseconds).
+         * @param netInputHeights Candidate net input heights (multiples of 16). If empty, it will use netInputHeight
+         * scaled by 1, 0.875, 0.75, 0.625 and 0.5.
+         */
+        NetResolutionController(const int netInputHeight, const double latencyBudget,
+                                const std::vector<int>& netInputHeights = {});
+
+        virtual ~NetResolutionController();
+
+        /**
+         * Net input height that should be used for the next frame.
+         */
+        int getNetInputHeight() const;
+
+        /**
+         * Smoothed latency (in milliseconds) measured for the current resolution, or -1 if not available yet.
+         */
+        double getLatency() const;
+
+        void frameStarted(const unsigned long long id);
+
+        void frameFinished(const unsigned long long id);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplNetResolutionController;
+        std::shared_ptr<ImplNetResolutionController> spImpl;
+
+        DELETE_COPY(NetResolutionController);
+    };
+}
+
+#endif // OPENPOSE_CORE_NET_RESOLUTION_CONTROLLER_HPP
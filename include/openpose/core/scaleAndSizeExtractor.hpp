@@ -3,6 +3,7 @@
 
 #include <tuple>
 #include <openpose/core/common.hpp>
+#include <openpose/core/netResolutionController.hpp>
 
 namespace op
 {
@@ -10,7 +11,8 @@ namespace op
     {
     public:
         ScaleAndSizeExtractor(const Point<int>& netInputResolution, const float netInputResolutionDynamicBehavior,
-            const Point<int>& outputResolution, const int scaleNumber = 1, const double scaleGap = 0.25);
+            const Point<int>& outputResolution, const int scaleNumber = 1, const double scaleGap = 0.25,
+            const std::shared_ptr<NetResolutionController>& netResolutionController = nullptr);
 
         virtual ~ScaleAndSizeExtractor();
 
@@ -23,6 +25,7 @@ namespace op
         const Point<int> mOutputSize;
         const int mScaleNumber;
         const double mScaleGap;
+        const std::shared_ptr<NetResolutionController> spNetResolutionController;
     };
 }
 
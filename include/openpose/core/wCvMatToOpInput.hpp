@@ -63,8 +63,9 @@ namespace op
                 const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
                 // cv::Mat -> float*
                 for (auto& tDatumPtr : *tDatums)
-                    tDatumPtr->inputNetData = spCvMatToOpInput->createArray(
-                        tDatumPtr->cvInputData, tDatumPtr->scaleInputToNetInputs, tDatumPtr->netInputSizes);
+                    spCvMatToOpInput->fillArray(
+                        tDatumPtr->inputNetData, tDatumPtr->cvInputData, tDatumPtr->scaleInputToNetInputs,
+                        tDatumPtr->netInputSizes);
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
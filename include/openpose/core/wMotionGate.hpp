@@ -0,0 +1,178 @@
+#ifndef OPENPOSE_CORE_W_MOTION_GATE_HPP
+#define OPENPOSE_CORE_W_MOTION_GATE_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/core/motionGate.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    /**
+     * Worker that decides which frames are skipped by MotionGate (isStart = true). It must be placed before any
+     * multi-threading (e.g., right after WIdGenerator). Only single-view frames are gated.
+     * With isStart = false, it fills the frames deferred by the MotionGate (see MotionGate::isDeferred()) with the
+     * results (body, face and hand) of the last frame processed before them. It must be placed right after sorting
+     * the frames of the GPU threads (WQueueOrderer), so that frame already went through it.
+     */
+    template<typename TDatums>
+    class WMotionGate : public Worker<TDatums>
+    {
+    public:
+        explicit WMotionGate(const std::shared_ptr<MotionGate>& motionGate, const bool isStart);
+
+        virtual ~WMotionGate();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+        /**
+         * It also stops the MotionGate, so no more frames depend on the results of another one (which might never
+         * be processed).
+         */
+        void tryStop();
+
+    private:
+        const std::shared_ptr<MotionGate> spMotionGate;
+        const bool mIsStart;
+        // Results of the last frame processed before the deferred ones (isStart = false)
+        bool mLastResultsValid;
+        Array<float> mPoseKeypoints;
+        Array<float> mPoseScores;
+        Array<long long> mPoseIds;
+        std::vector<Rectangle<float>> mFaceRectangles;
+        Array<float> mFaceKeypoints;
+        std::vector<std::array<Rectangle<float>, 2>> mHandRectangles;
+        std::array<Array<float>, 2> mHandKeypoints;
+
+        void fillDeferred(TDatums& tDatums);
+
+        DELETE_COPY(WMotionGate);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WMotionGate<TDatums>::WMotionGate(const std::shared_ptr<MotionGate>& motionGate, const bool isStart) :
+        spMotionGate{motionGate},
+        mIsStart{isStart},
+        mLastResultsValid{false}
+    {
+    }
+
+    template<typename TDatums>
+    WMotionGate<TDatums>::~WMotionGate()
+    {
+    }
+
+    template<typename TDatums>
+    void WMotionGate<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WMotionGate<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Fill deferred frames
+                if (!mIsStart)
+                    fillDeferred(tDatums);
+                // Check scene change (warm-up frames are always processed and they do not become the reference)
+                else if (tDatums->size() == 1 && !(*tDatums)[0]->warmup)
+                    spMotionGate->checkSkip((*tDatums)[0]->cvInputData, (*tDatums)[0]->id);
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WMotionGate<TDatums>::tryStop()
+    {
+        try
+        {
+            spMotionGate->stop();
+            Worker<TDatums>::tryStop();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WMotionGate<TDatums>::fillDeferred(TDatums& tDatums)
+    {
+        try
+        {
+            if (tDatums->size() != 1 || (*tDatums)[0]->warmup)
+                return;
+            auto& tDatumPtr = (*tDatums)[0];
+            // Deferred frame -> Results of the last frame processed before it (if it was its reference or skipped
+            // because of it, i.e., no expired frame in between)
+            if (spMotionGate->isDeferred(tDatumPtr->id))
+            {
+                if (tDatumPtr->expired)
+                    spMotionGate->setExpired(tDatumPtr->id);
+                else if (spMotionGate->endDeferred(tDatumPtr->id) && mLastResultsValid)
+                {
+                    tDatumPtr->poseKeypoints = mPoseKeypoints.clone();
+                    tDatumPtr->poseScores = mPoseScores.clone();
+                    tDatumPtr->poseIds = mPoseIds.clone();
+                    tDatumPtr->faceRectangles = mFaceRectangles;
+                    tDatumPtr->faceKeypoints = mFaceKeypoints.clone();
+                    tDatumPtr->handRectangles = mHandRectangles;
+                    tDatumPtr->handKeypoints = {mHandKeypoints[0].clone(), mHandKeypoints[1].clone()};
+                }
+                // Its reference expired -> No results
+                else
+                    tDatumPtr->expired = true;
+            }
+            // Processed frame (or skipped one filled on the GPU threads) -> Saved for the following deferred frames
+            else if (!tDatumPtr->expired)
+            {
+                mLastResultsValid = true;
+                mPoseKeypoints = tDatumPtr->poseKeypoints.clone();
+                mPoseScores = tDatumPtr->poseScores.clone();
+                mPoseIds = tDatumPtr->poseIds.clone();
+                mFaceRectangles = tDatumPtr->faceRectangles;
+                mFaceKeypoints = tDatumPtr->faceKeypoints.clone();
+                mHandRectangles = tDatumPtr->handRectangles;
+                mHandKeypoints = {tDatumPtr->handKeypoints[0].clone(), tDatumPtr->handKeypoints[1].clone()};
+            }
+            else
+                mLastResultsValid = false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WMotionGate);
+}
+
+#endif // OPENPOSE_CORE_W_MOTION_GATE_HPP
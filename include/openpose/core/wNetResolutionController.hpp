@@ -0,0 +1,101 @@
+#ifndef OPENPOSE_CORE_W_NET_RESOLUTION_CONTROLLER_HPP
+#define OPENPOSE_CORE_W_NET_RESOLUTION_CONTROLLER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/core/netResolutionController.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    /**
+     * Worker that measures the per-frame latency for NetResolutionController. It must be added twice: once at the
+     * beginning of the pipeline (isStart = true, before WScaleAndSizeExtractor) and once at its end (isStart =
+     * false).
+     */
+    template<typename TDatums>
+    class WNetResolutionController : public Worker<TDatums>
+    {
+    public:
+        explicit WNetResolutionController(
+            const std::shared_ptr<NetResolutionController>& netResolutionController, const bool isStart);
+
+        virtual ~WNetResolutionController();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<NetResolutionController> spNetResolutionController;
+        const bool mIsStart;
+
+        DELETE_COPY(WNetResolutionController);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WNetResolutionController<TDatums>::WNetResolutionController(
+        const std::shared_ptr<NetResolutionController>& netResolutionController, const bool isStart) :
+        spNetResolutionController{netResolutionController},
+        mIsStart{isStart}
+    {
+    }
+
+    template<typename TDatums>
+    WNetResolutionController<TDatums>::~WNetResolutionController()
+    {
+    }
+
+    template<typename TDatums>
+    void WNetResolutionController<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WNetResolutionController<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Start/stop latency timer (all the elements of tDatums share the same id). Warm-up frames are not
+                // timed, as their latency includes the network loading and reshapes
+                const auto id = (*tDatums)[0]->id;
+                if (!(*tDatums)[0]->warmup)
+                {
+                    if (mIsStart)
+                        spNetResolutionController->frameStarted(id);
+                    else
+                        spNetResolutionController->frameFinished(id);
+                }
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WNetResolutionController);
+}
+
+#endif // OPENPOSE_CORE_W_NET_RESOLUTION_CONTROLLER_HPP
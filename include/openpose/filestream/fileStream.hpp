@@ -50,6 +50,12 @@ namespace op
         const std::vector<std::vector<std::array<float,3>>>& candidates, const std::string& fileName,
         const bool humanReadable);
 
+    // Same, but from non-owning views (no Array copies)
+    OP_API void savePeopleJson(
+        const std::vector<std::pair<ArrayView<const float>, std::string>>& keypointVector,
+        const std::vector<std::vector<std::array<float,3>>>& candidates, const std::string& fileName,
+        const bool humanReadable);
+
     // Save/load image
     OP_API void saveImage(
         const Matrix& matrix, const std::string& fullFilePath,
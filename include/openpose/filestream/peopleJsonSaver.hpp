@@ -17,6 +17,14 @@ namespace op
             const std::vector<std::pair<Array<float>, std::string>>& keypointVector,
             const std::vector<std::vector<std::array<float,3>>>& candidates, const std::string& fileName,
             const bool humanReadable = true) const;
+
+        /**
+         * Same, but from non-owning views (no Array copies). The viewed memory must be valid during the call.
+         */
+        void save(
+            const std::vector<std::pair<ArrayView<const float>, std::string>>& keypointVector,
+            const std::vector<std::vector<std::array<float,3>>>& candidates, const std::string& fileName,
+            const bool humanReadable = true) const;
     };
 }
 
@@ -75,19 +75,21 @@ namespace op
                     // Pose IDs from long long to float
                     Array<float> poseIds{tDatumPtr->poseIds};
 
-                    const std::vector<std::pair<Array<float>, std::string>> keypointVector{
+                    // Views (no Array copies), valid while tDatumPtr and poseIds are
+                    typedef ArrayView<const float> KeypointView;
+                    const std::vector<std::pair<KeypointView, std::string>> keypointVector{
                         // Pose IDs
-                        std::make_pair(poseIds, "person_id"),
+                        std::make_pair(KeypointView{poseIds}, "person_id"),
                         // 2D
-                        std::make_pair(tDatumPtr->poseKeypoints, "pose_keypoints_2d"),
-                        std::make_pair(tDatumPtr->faceKeypoints, "face_keypoints_2d"),
-                        std::make_pair(tDatumPtr->handKeypoints[0], "hand_left_keypoints_2d"),
-                        std::make_pair(tDatumPtr->handKeypoints[1], "hand_right_keypoints_2d"),
+                        std::make_pair(KeypointView{tDatumPtr->poseKeypoints}, "pose_keypoints_2d"),
+                        std::make_pair(KeypointView{tDatumPtr->faceKeypoints}, "face_keypoints_2d"),
+                        std::make_pair(KeypointView{tDatumPtr->handKeypoints[0]}, "hand_left_keypoints_2d"),
+                        std::make_pair(KeypointView{tDatumPtr->handKeypoints[1]}, "hand_right_keypoints_2d"),
                         // 3D
-                        std::make_pair(tDatumPtr->poseKeypoints3D, "pose_keypoints_3d"),
-                        std::make_pair(tDatumPtr->faceKeypoints3D, "face_keypoints_3d"),
-                        std::make_pair(tDatumPtr->handKeypoints3D[0], "hand_left_keypoints_3d"),
-                        std::make_pair(tDatumPtr->handKeypoints3D[1], "hand_right_keypoints_3d")
+                        std::make_pair(KeypointView{tDatumPtr->poseKeypoints3D}, "pose_keypoints_3d"),
+                        std::make_pair(KeypointView{tDatumPtr->faceKeypoints3D}, "face_keypoints_3d"),
+                        std::make_pair(KeypointView{tDatumPtr->handKeypoints3D[0]}, "hand_left_keypoints_3d"),
+                        std::make_pair(KeypointView{tDatumPtr->handKeypoints3D[1]}, "hand_right_keypoints_3d")
                     };
                     // Save keypoints
                     spPeopleJsonSaver->save(
@@ -23,6 +23,13 @@ DEFINE_bool(disable_multi_thread,       false,          "It would slightly reduc
                                                         " for 1) Cases where it is needed a low latency (e.g., webcam in real-time scenarios with"
                                                         " low-range GPU devices); and 2) Debugging OpenPose when it is crashing to locate the"
                                                         " error.");
+DEFINE_bool(latest_frame_wins,          false,          "Latest-frame-wins mode for live sources (e.g., webcam or IP camera). If a stage is slower"
+                                                        " than the previous ones, the oldest queued frames are dropped rather than blocking the"
+                                                        " pipeline, so the latency stays constant under overload. The number of frames dropped"
+                                                        " at each stage is displayed when closing OpenPose.");
+DEFINE_double(statistics_period,        -1.,            "If > 0, every `statistics_period` seconds (and when closing OpenPose), it logs the"
+                                                        " time-averaged occupancy and blocked push/pop time of each internal queue, and the"
+                                                        " average/max service time of each worker, in order to locate the bottleneck stage.");
 DEFINE_int32(profile_speed,             1000,           "If PROFILER_ENABLED was set in CMake or Makefile.config files, OpenPose will show some"
                                                         " runtime statistics at this frame number.");
 #ifndef OPENPOSE_FLAGS_DISABLE_POSE
@@ -52,6 +59,10 @@ DEFINE_int32(frame_rotate,              0,              "Rotate each frame, 4 po
 DEFINE_bool(frames_repeat,              false,          "Repeat frames when finished.");
 DEFINE_bool(process_real_time,          false,          "Enable to keep the original source frame rate (e.g., for video). If the processing time is"
                                                         " too long, it will skip frames. If it is too fast, it will slow it down.");
+DEFINE_double(frame_deadline,           -1.,            "Latency budget (in milliseconds) of each frame since it is read. Frames still in the"
+                                                        " pipeline after it skip the remaining body/face/hand estimation, rendering and output"
+                                                        " (e.g., display or saving) steps, so a load spike does not delay the following frames."
+                                                        " Select -1 to disable.");
 DEFINE_string(camera_parameter_path,    "models/cameraParameters/flir/", "String with the folder where the camera parameters are located. If there"
                                                         " is only 1 XML file (for single video, webcam, or images from the same camera), you must"
                                                         " specify the whole XML file path (ending in .xml).");
@@ -109,6 +120,11 @@ DEFINE_double(net_resolution_dynamic,   1.,             "This flag only applies
                                                         " is 656 width for a 368 height). E.g., `net_resolution_dynamic 10 net_resolution -1x368`"
                                                         " will clip to 6560x368 (10 x 656). Recommended 1 for small GPUs (to avoid out of memory"
                                                         " errors but maximize speed) and 0 for big GPUs (for maximum accuracy and speed).");
+DEFINE_double(latency_budget,           -1.,            "Target latency per frame (in milliseconds) for real-time inputs. If positive, OpenPose"
+                                                        " will measure the latency of each frame and dynamically reduce (or increase back) the net"
+                                                        " input height of `net_resolution` among 5 levels (from 100% to 50% of it), keeping the"
+                                                        " highest one that meets this budget. Select -1 (default) to disable it and always use"
+                                                        " `net_resolution`.");
 DEFINE_int32(scale_number,              1,              "Number of scales to average.");
 DEFINE_double(scale_gap,                0.25,           "Scale gap between scales. No effect unless scale_number > 1. Initial scale is always 1."
                                                         " If you want to change the initial scale, you actually want to multiply the"
@@ -177,12 +193,33 @@ DEFINE_int32(3d_views,                  -1,             "Complementary option fo
 // Extra algorithms
 DEFINE_bool(identification,             false,          "Experimental, not available yet. Whether to enable people identification across frames.");
 DEFINE_int32(tracking,                  -1,             "Experimental, not available yet. Whether to enable people tracking across frames. The"
-                                                        " value indicates the number of frames where tracking is run between each OpenPose keypoint"
-                                                        " detection. Select -1 (default) to disable it or 0 to run simultaneously OpenPose keypoint"
-                                                        " detector and tracking for potentially higher accuracy than only OpenPose.");
+                                                        " value indicates the maximum number of frames where tracking is run between each OpenPose"
+                                                        " keypoint detection (it is automatically reduced while the tracker loses keypoints, and the"
+                                                        " confidence of the tracked keypoints decays on each tracked frame). Select -1 (default) to"
+                                                        " disable it or 0 to run simultaneously OpenPose keypoint detector and tracking for"
+                                                        " potentially higher accuracy than only OpenPose.");
 DEFINE_int32(ik_threads,                0,              "Experimental, not available yet. Whether to enable inverse kinematics (IK) from 3-D"
                                                         " keypoints to obtain 3-D joint angles. By default (0 threads), it is disabled. Increasing"
                                                         " the number of threads will increase the speed but also the global system latency.");
+DEFINE_int32(roi_refresh,               -1,             "Experimental. Whether to run the body network only on the area occupied by the people"
+                                                        " detected in the previous frame (faster for static cameras with few people). Select -1"
+                                                        " (default) to disable it, 0 to only run on the whole frame when people are lost, or N > 0"
+                                                        " to also run on the whole frame every N frames (e.g., to detect new people). Only"
+                                                        " applied with `--scale_number 1`.");
+DEFINE_double(motion_threshold,         -1.,            "Experimental. Whether to skip the body network on frames with negligible scene change"
+                                                        " (e.g., static cameras), reusing the body keypoints of the last processed frame. The"
+                                                        " value is the maximum mean absolute difference per pixel (gray levels in [0, 255])"
+                                                        " between 64-pixel-wide thumbnails of the current and last processed frames (e.g., 2)."
+                                                        " Select -1 (default) to disable it. Skip statistics are printed when closing OpenPose.");
+DEFINE_int32(motion_max_skip,           10,             "Maximum number of consecutive frames skipped by `--motion_threshold`.");
+DEFINE_int32(elastic_threads,           0,              "Maximum number of threads of each CPU stage that can run in parallel (3-D"
+                                                        " triangulation, IK and CPU rendering). Only 1 (or the default number) of them is active"
+                                                        " at the beginning, and more are activated while that stage is the bottleneck (its input"
+                                                        " queue stays full), or parked again when it is idle. Select 0 (default) to disable it.");
+DEFINE_bool(pin_threads,                false,          "Whether to pin each thread to the CPUs of a NUMA node (Linux), so threads do not migrate"
+                                                        " across sockets and their buffers stay on the local node: each GPU thread on the node"
+                                                        " of its GPU, and the other ones on the node of the first GPU. Recommended for"
+                                                        " multi-socket servers.");
 // OpenPose Rendering
 DEFINE_int32(part_to_show,              0,              "Prediction channel to visualize: 0 (default) for all the body parts, 1 for the background"
                                                         " heat map, 2 for the superposition of heatmaps, 3 for the superposition of PAFs,"
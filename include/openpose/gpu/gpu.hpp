@@ -9,6 +9,12 @@ namespace op
     OP_API int getGpuNumber();
 
     OP_API GpuMode getGpuMode();
+
+    /**
+     * NUMA node the given GPU is attached to, read from /sys/bus/pci/devices/<PCI bus id>/numa_node (Linux and
+     * CUDA only). It returns -1 if unknown (e.g., single-node systems, OpenCL or CPU-only builds).
+     */
+    OP_API int getGpuNumaNode(const int gpuId);
 }
 
 #endif // OPENPOSE_GPU_GPU_HPP
@@ -2,6 +2,7 @@
 #define OPENPOSE_HAND_HAND_DETECTOR_HPP
 
 #include <mutex>
+#include <unordered_map>
 #include <openpose/core/common.hpp>
 #include <openpose/pose/enumClasses.hpp>
 
@@ -34,16 +35,31 @@ namespace op
             Size,
         };
 
+        // Uniform grid (spatial hash) over the centers of the previous hand rectangles, so each new hand is only
+        // compared with the previous hands in its neighbouring cells rather than with all of them
+        struct HandGrid
+        {
+            std::vector<Rectangle<float>> rectangles;
+            std::unordered_map<unsigned long long, std::vector<unsigned int>> cells;
+            float cellSize;
+        };
+
         const std::array<unsigned int, (int)PosePart::Size> mPoseIndexes;
         std::vector<std::array<Point<float>, (int)PosePart::Size>> mPoseTrack;
-        std::vector<Rectangle<float>> mHandLeftPrevious;
-        std::vector<Rectangle<float>> mHandRightPrevious;
+        HandGrid mHandLeftPrevious;
+        HandGrid mHandRightPrevious;
         unsigned long long mCurrentId;
         std::mutex mMutex;
 
         std::array<unsigned int, (int)PosePart::Size> getPoseKeypoints(const PoseModel poseModel,
                                                                        const std::array<std::string, (int)PosePart::Size>& poseStrings) const;
 
+        static void resetGrid(HandGrid& handGrid);
+
+        static void fillGrid(HandGrid& handGrid);
+
+        static void trackHand(Rectangle<float>& currentRectangle, const HandGrid& previousHands);
+
         DELETE_COPY(HandDetector);
     };
 }
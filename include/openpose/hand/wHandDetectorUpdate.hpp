@@ -63,7 +63,9 @@ namespace op
                 const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
                 // Detect people hand
                 for (auto& tDatumPtr : *tDatums)
-                    spHandDetector->updateTracker(tDatumPtr->handKeypoints, tDatumPtr->id);
+                    // Warm-up frames do not replace the tracked hands
+                    if (!tDatumPtr->warmup)
+                        spHandDetector->updateTracker(tDatumPtr->handKeypoints, tDatumPtr->id);
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
@@ -4,6 +4,7 @@
 #include <openpose/core/common.hpp>
 #include <openpose/core/enumClasses.hpp>
 #include <openpose/core/keepTopNPeople.hpp>
+#include <openpose/core/motionGate.hpp>
 #include <openpose/pose/poseParameters.hpp>
 #include <openpose/pose/poseExtractorNet.hpp>
 #include <openpose/tracking/personIdExtractor.hpp>
@@ -18,19 +19,43 @@ namespace op
                       const std::shared_ptr<KeepTopNPeople>& keepTopNPeople = nullptr,
                       const std::shared_ptr<PersonIdExtractor>& personIdExtractor = nullptr,
                       const std::shared_ptr<std::vector<std::shared_ptr<PersonTracker>>>& personTracker = {},
-                      const int numberPeopleMax = -1, const int tracking = -1);
+                      const int numberPeopleMax = -1, const int tracking = -1, const int roiRefresh = -1,
+                      const std::shared_ptr<MotionGate>& motionGate = nullptr);
 
         virtual ~PoseExtractor();
 
         void initializationOnThread();
 
+        /**
+         * @param warmup Whether it is a frame of Wrapper::warmup() (Datum::warmup). It always runs the body network on
+         * the whole frame, and it does not modify the state kept among frames (motion gate, tracking key frames and
+         * ROI).
+         */
         void forwardPass(const std::vector<Array<float>>& inputNetData,
                          const Point<int>& inputDataSize,
                          const std::vector<double>& scaleRatios,
                          const Array<float>& poseNetOutput = Array<float>{},
-                         const long long frameId = -1ll);
+                         const long long frameId = -1ll,
+                         const bool warmup = false);
+
+        /**
+         * Called instead of forwardPass() for the frames whose deadline (Datum::deadline) passed before it, so the
+         * frames depending on them (MotionGate) do not expect their results.
+         */
+        void setExpired(const long long frameId);
+
+        /**
+         * Whether the last frame of forwardPass() was deferred by the MotionGate: its results are empty until the
+         * WMotionGate after the GPU threads fills them, so it must not update the person IDs or trackers.
+         */
+        bool isDeferred() const;
 
         // PoseExtractorNet functions
+        /**
+         * If the ROI mode is enabled (roiRefresh > -1) and the last frame was processed on a crop, the heat maps
+         * only cover that crop (see getRoi()), while keypoints and candidates are already mapped back to frame
+         * coordinates.
+         */
         Array<float> getHeatMapsCopy() const;
 
         std::vector<std::vector<std::array<float, 3>>> getCandidatesCopy() const;
@@ -41,6 +66,12 @@ namespace op
 
         float getScaleNetToOutput() const;
 
+        /**
+         * Region of the input frame in which the body network was run on the last call to forwardPass. It is the
+         * whole frame if the ROI mode is disabled or a full-frame refresh was run.
+         */
+        Rectangle<float> getRoi() const;
+
         // KeepTopNPeople functions
         void keepTopPeople(Array<float>& poseKeypoints, const Array<float>& poseScores) const;
 
@@ -66,10 +97,29 @@ namespace op
     private:
         const int mNumberPeopleMax;
         const int mTracking;
+        const int mRoiRefresh;
+        // ROI mode state (each GPU thread owns its own PoseExtractor, so no mutex is required)
+        Rectangle<float> mRoi;
+        Rectangle<float> mNextRoi;
+        int mRoiPreviousPeople;
+        int mRoiFramesSinceRefresh;
+        Array<float> mRoiNetInput;
+        Array<float> mRoiPoseKeypoints;
         const std::shared_ptr<PoseExtractorNet> spPoseExtractorNet;
         const std::shared_ptr<KeepTopNPeople> spKeepTopNPeople;
         const std::shared_ptr<PersonIdExtractor> spPersonIdExtractor;
         const std::shared_ptr<std::vector<std::shared_ptr<PersonTracker>>> spPersonTrackers;
+        const std::shared_ptr<MotionGate> spMotionGate;
+        // Motion gate state (results reused from a previous frame)
+        bool mGated;
+        bool mDeferred;
+        Array<float> mGatedPoseKeypoints;
+        Array<float> mGatedPoseScores;
+
+        bool roiForwardPass(const Array<float>& inputNetData, const double scaleInputToNetInput,
+                            const Array<float>& poseNetOutput);
+
+        void updateNextRoi(const Point<int>& inputDataSize);
 
         DELETE_COPY(PoseExtractor);
     };
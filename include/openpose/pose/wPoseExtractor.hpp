@@ -19,6 +19,8 @@ namespace op
 
         void work(TDatums& tDatums);
 
+        void workExpired(TDatums& tDatums);
+
     private:
         std::shared_ptr<PoseExtractor> spPoseExtractor;
 
@@ -77,7 +79,8 @@ namespace op
                     // OpenPose net forward pass
                     spPoseExtractor->forwardPass(
                         tDatumPtr->inputNetData, Point<int>{tDatumPtr->cvInputData.cols(), tDatumPtr->cvInputData.rows()},
-                        tDatumPtr->scaleInputToNetInputs, tDatumPtr->poseNetOutput, tDatumPtr->id);
+                        tDatumPtr->scaleInputToNetInputs, tDatumPtr->poseNetOutput, tDatumPtr->id,
+                        tDatumPtr->warmup);
                     // OpenPose keypoint detector
                     tDatumPtr->poseCandidates = spPoseExtractor->getCandidatesCopy();
                     tDatumPtr->poseHeatMaps = spPoseExtractor->getHeatMapsCopy();
@@ -86,6 +89,10 @@ namespace op
                     tDatumPtr->scaleNetToOutput = spPoseExtractor->getScaleNetToOutput();
                     // Keep desired top N people
                     spPoseExtractor->keepTopPeople(tDatumPtr->poseKeypoints, tDatumPtr->poseScores);
+                    // Warm-up and deferred (MotionGate, still without results) frames do not modify the person IDs
+                    // or trackers
+                    if (tDatumPtr->warmup || spPoseExtractor->isDeferred())
+                        continue;
                     // ID extractor (experimental)
                     tDatumPtr->poseIds = spPoseExtractor->extractIdsLockThread(
                         tDatumPtr->poseKeypoints, tDatumPtr->cvInputData, i, tDatumPtr->id);
@@ -108,6 +115,23 @@ namespace op
         }
     }
 
+    template<typename TDatums>
+    void WPoseExtractor<TDatums>::workExpired(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+                for (const auto& tDatumPtr : *tDatums)
+                    spPoseExtractor->setExpired(tDatumPtr->id);
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     COMPILE_TEMPLATE_DATUM(WPoseExtractor);
 }
 
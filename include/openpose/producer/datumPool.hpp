@@ -0,0 +1,195 @@
+#ifndef OPENPOSE_PRODUCER_DATUM_POOL_HPP
+#define OPENPOSE_PRODUCER_DATUM_POOL_HPP
+
+#include <atomic>
+#include <openpose/core/common.hpp>
+#include <openpose/core/datum.hpp>
+#include <openpose/thread/mpmcRingBuffer.hpp>
+
+namespace op
+{
+    /**
+     * Recycling pool of TDatums (std::shared_ptr<std::vector<std::shared_ptr<TDatum>>>), so the producer does not
+     * allocate and free a new one (plus its Datums and their buffers) for every frame.
+     * The TDatums returned by get() go back to the pool when their last copy is released, wherever that happens
+     * (e.g., in the last worker of the pipeline or in the user code), through a lock-free return queue. If that
+     * queue is full or the pool no longer exists, they are simply freed.
+     * Recycled Datums are cleared, but they keep their largest buffers (inputNetData and outputData), which are
+     * reused in place by the following frames if their shapes match (see Array::reset).
+     */
+    template<typename TDatum>
+    class DatumPool
+    {
+    public:
+        /**
+         * @param maxSize Maximum number of idle TDatums kept by the pool.
+         */
+        explicit DatumPool(const unsigned long long maxSize = 8ull);
+
+        virtual ~DatumPool();
+
+        /**
+         * It returns a TDatums with numberDatums (not null) Datums, recycled if possible. It can be called from any
+         * thread.
+         */
+        std::shared_ptr<std::vector<std::shared_ptr<TDatum>>> get(const unsigned long long numberDatums = 1ull);
+
+        unsigned long long getNumberAllocated() const;
+
+        unsigned long long getNumberRecycled() const;
+
+    private:
+        typedef std::vector<std::shared_ptr<TDatum>> TDatumsRaw;
+
+        // Shared with the deleters of the TDatums in use, so it outlives the pool if required
+        struct ReturnQueue
+        {
+            MpmcRingBuffer<TDatumsRaw*> mpmcRingBuffer;
+
+            explicit ReturnQueue(const unsigned long long maxSize) :
+                mpmcRingBuffer{maxSize}
+            {
+            }
+
+            ~ReturnQueue()
+            {
+                TDatumsRaw* tDatumsRaw;
+                while (mpmcRingBuffer.tryPop(tDatumsRaw))
+                    delete tDatumsRaw;
+            }
+        };
+
+        std::shared_ptr<ReturnQueue> spReturnQueue;
+        std::atomic<unsigned long long> mNumberAllocated;
+        std::atomic<unsigned long long> mNumberRecycled;
+
+        void recycle(std::shared_ptr<TDatum>& tDatumPtr);
+
+        DELETE_COPY(DatumPool);
+    };
+}
+
+
+
+
+
+// Implementation
+namespace op
+{
+    template<typename TDatum>
+    DatumPool<TDatum>::DatumPool(const unsigned long long maxSize) :
+        spReturnQueue{std::make_shared<ReturnQueue>(maxSize > 0ull ? maxSize : 1ull)},
+        mNumberAllocated{0ull},
+        mNumberRecycled{0ull}
+    {
+    }
+
+    template<typename TDatum>
+    DatumPool<TDatum>::~DatumPool()
+    {
+        try
+        {
+            if (mNumberAllocated + mNumberRecycled > 0ull)
+                opLog("Datum pool: " + std::to_string(getNumberRecycled()) + " of "
+                      + std::to_string(getNumberAllocated() + getNumberRecycled()) + " elements recycled.",
+                      Priority::Normal);
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatum>
+    std::shared_ptr<std::vector<std::shared_ptr<TDatum>>> DatumPool<TDatum>::get(
+        const unsigned long long numberDatums)
+    {
+        try
+        {
+            // Recycled or new element
+            TDatumsRaw* tDatumsRaw;
+            if (spReturnQueue->mpmcRingBuffer.tryPop(tDatumsRaw))
+                mNumberRecycled++;
+            else
+            {
+                tDatumsRaw = new TDatumsRaw{};
+                mNumberAllocated++;
+            }
+            tDatumsRaw->resize(numberDatums);
+            for (auto& tDatumPtr : *tDatumsRaw)
+                recycle(tDatumPtr);
+            // Deleter: Back to the pool (if it still exists and is not full)
+            const std::weak_ptr<ReturnQueue> returnQueue = spReturnQueue;
+            return std::shared_ptr<TDatumsRaw>(
+                tDatumsRaw,
+                [returnQueue](TDatumsRaw* tDatumsRawToReturn)
+                {
+                    const auto spReturnQueueLocked = returnQueue.lock();
+                    if (spReturnQueueLocked == nullptr
+                        || !spReturnQueueLocked->mpmcRingBuffer.tryPush(tDatumsRawToReturn))
+                        delete tDatumsRawToReturn;
+                });
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    template<typename TDatum>
+    unsigned long long DatumPool<TDatum>::getNumberAllocated() const
+    {
+        try
+        {
+            return mNumberAllocated;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template<typename TDatum>
+    unsigned long long DatumPool<TDatum>::getNumberRecycled() const
+    {
+        try
+        {
+            return mNumberRecycled;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template<typename TDatum>
+    void DatumPool<TDatum>::recycle(std::shared_ptr<TDatum>& tDatumPtr)
+    {
+        try
+        {
+            // Missing or still used somewhere else (e.g., the views split by WDatumProducer) -> New one
+            if (tDatumPtr == nullptr || tDatumPtr.use_count() > 1)
+                tDatumPtr = std::make_shared<TDatum>();
+            // Clear it, but keep its largest buffers so they can be reused in place
+            else
+            {
+                auto inputNetData = std::move(tDatumPtr->inputNetData);
+                auto outputData = std::move(tDatumPtr->outputData);
+                *tDatumPtr = TDatum{};
+                tDatumPtr->inputNetData = std::move(inputNetData);
+                tDatumPtr->outputData = std::move(outputData);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    extern template class DatumPool<BASE_DATUM>;
+}
+
+#endif // OPENPOSE_PRODUCER_DATUM_POOL_HPP
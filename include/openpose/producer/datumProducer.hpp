@@ -2,10 +2,12 @@
 #define OPENPOSE_PRODUCER_DATUM_PRODUCER_HPP
 
 #include <atomic>
+#include <chrono>
 #include <limits> // std::numeric_limits
 #include <openpose/core/common.hpp>
 #include <openpose/core/datum.hpp>
 #include <openpose/utilities/fastMath.hpp>
+#include <openpose/producer/datumPool.hpp>
 #include <openpose/producer/producer.hpp>
 
 namespace op
@@ -18,7 +20,8 @@ namespace op
             const std::shared_ptr<Producer>& producerSharedPtr,
             const unsigned long long frameFirst = 0, const unsigned long long frameStep = 1,
             const unsigned long long frameLast = std::numeric_limits<unsigned long long>::max(),
-            const std::shared_ptr<std::pair<std::atomic<bool>, std::atomic<int>>>& videoSeekSharedPtr = nullptr);
+            const std::shared_ptr<std::pair<std::atomic<bool>, std::atomic<int>>>& videoSeekSharedPtr = nullptr,
+            const double frameDeadline = -1.);
 
         virtual ~DatumProducer();
 
@@ -31,6 +34,9 @@ namespace op
         unsigned long long mFrameStep;
         unsigned int mNumberConsecutiveEmptyFrames;
         std::shared_ptr<std::pair<std::atomic<bool>, std::atomic<int>>> spVideoSeek;
+        const double mFrameDeadline;
+        // Datums released by the pipeline are recycled for the next frames
+        DatumPool<TDatum> mDatumPool;
 
         void checkIfTooManyConsecutiveEmptyFrames(
             unsigned int& numberConsecutiveEmptyFrames, const bool emptyFrame) const;
@@ -69,14 +75,16 @@ namespace op
         const std::shared_ptr<Producer>& producerSharedPtr,
         const unsigned long long frameFirst, const unsigned long long frameStep,
         const unsigned long long frameLast,
-        const std::shared_ptr<std::pair<std::atomic<bool>, std::atomic<int>>>& videoSeekSharedPtr) :
+        const std::shared_ptr<std::pair<std::atomic<bool>, std::atomic<int>>>& videoSeekSharedPtr,
+        const double frameDeadline) :
         mNumberFramesToProcess{(frameLast != std::numeric_limits<unsigned long long>::max()
                                 ? frameLast - frameFirst : frameLast)},
         spProducer{producerSharedPtr},
         mGlobalCounter{0ll},
         mFrameStep{frameStep},
         mNumberConsecutiveEmptyFrames{0u},
-        spVideoSeek{videoSeekSharedPtr}
+        spVideoSeek{videoSeekSharedPtr},
+        mFrameDeadline{frameDeadline}
     {
         try
         {
@@ -102,7 +110,7 @@ namespace op
             const bool datumProducerRunning = datumProducerConstructorRunningAndGetDatumIsDatumProducerRunning(
                 spProducer, mNumberFramesToProcess, mGlobalCounter);
             // If device is open
-            auto datums = std::make_shared<std::vector<std::shared_ptr<TDatum>>>();
+            std::shared_ptr<std::vector<std::shared_ptr<TDatum>>> datums;
             if (datumProducerRunning)
             {
                 // Fast forward/backward - Seek to specific frame index desired
@@ -121,12 +129,10 @@ namespace op
                     const std::vector<Matrix> cameraMatrices = spProducer->getCameraMatrices();
                     const std::vector<Matrix> cameraExtrinsics = spProducer->getCameraExtrinsics();
                     const std::vector<Matrix> cameraIntrinsics = spProducer->getCameraIntrinsics();
-                    // Resize datum
-                    datums->resize(matrices.size());
-                    // Datum cannot be assigned before resize()
-                    auto& datumPtr = (*datums)[0];
-                    datumPtr = std::make_shared<TDatum>();
+                    // Recycled (or new) datums
+                    datums = mDatumPool.get(matrices.size());
                     // Filling first element
+                    auto& datumPtr = (*datums)[0];
                     std::swap(datumPtr->name, nextFrameName);
                     datumPtr->frameNumber = nextFrameNumber;
                     datumPtr->cvInputData = matrices[0];
@@ -146,7 +152,6 @@ namespace op
                         for (auto i = 1u ; i < datums->size() ; i++)
                         {
                             auto& datumIPtr = (*datums)[i];
-                            datumIPtr = std::make_shared<TDatum>();
                             datumIPtr->name = datumPtr->name;
                             datumIPtr->frameNumber = datumPtr->frameNumber;
                             datumIPtr->cvInputData = matrices[i];
@@ -160,6 +165,14 @@ namespace op
                             }
                         }
                     }
+                    // Latency budget (counted since the frame was read)
+                    if (mFrameDeadline > 0.)
+                    {
+                        const auto deadline = std::chrono::steady_clock::now()
+                            + std::chrono::microseconds{(long long)(1e3 * mFrameDeadline)};
+                        for (auto& datumIPtr : *datums)
+                            datumIPtr->deadline = deadline;
+                    }
                     // Check producer is running
                     if ((*datums)[0]->cvInputData.empty())
                         datums = nullptr;
@@ -167,7 +180,11 @@ namespace op
                     if (datums != nullptr)
                         mGlobalCounter += mFrameStep;
                 }
+                else
+                    datums = std::make_shared<std::vector<std::shared_ptr<TDatum>>>();
             }
+            else
+                datums = std::make_shared<std::vector<std::shared_ptr<TDatum>>>();
             // Return result
             return std::make_pair(datumProducerRunning, datums);
         }
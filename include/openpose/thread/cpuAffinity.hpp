@@ -0,0 +1,35 @@
+#ifndef OPENPOSE_THREAD_CPU_AFFINITY_HPP
+#define OPENPOSE_THREAD_CPU_AFFINITY_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Logical CPUs of each NUMA node (indexed by node id, empty for the nodes without CPUs), read from
+     * /sys/devices/system/node/node*\/cpulist. If the topology is not available (e.g., non-Linux OS or kernel without
+     * NUMA support), it returns a single node with all the CPUs.
+     */
+    OP_API std::vector<std::vector<int>> getNumaNodeCpus();
+
+    /**
+     * It parses a Linux CPU list, e.g., "0-3,8-11" -> {0, 1, 2, 3, 8, 9, 10, 11}.
+     */
+    OP_API std::vector<int> parseCpuList(const std::string& cpuList);
+
+    /**
+     * CPUs the calling thread is allowed to run on. Empty if not supported.
+     */
+    OP_API std::vector<int> getThreadCpus();
+
+    /**
+     * It pins the calling thread to the given CPUs. As Linux places each memory page on the NUMA node of the thread
+     * that first writes it, the buffers a pinned thread allocates and fills (e.g., in initializationOnThread() or
+     * on the first frame) stay on its node.
+     * @param cpus CPUs to run on. If empty, nothing is changed.
+     * @return Whether the affinity was applied (false if empty or not supported).
+     */
+    OP_API bool setThreadCpus(const std::vector<int>& cpus);
+}
+
+#endif // OPENPOSE_THREAD_CPU_AFFINITY_HPP
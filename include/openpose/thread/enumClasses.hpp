@@ -22,6 +22,36 @@ namespace op
          */
         Synchronous,
     };
+
+    /**
+     * ThreadManager execution backend, i.e., how the thread ids given to ThreadManager::add are run.
+     */
+    enum class ThreadManagerBackend : unsigned char
+    {
+        Threads,        /**< Each thread id runs on its own std::thread (default). */
+        /**
+         * Each thread id is a task of a fixed-size pool of threads (one per core by default), and each pool thread
+         * runs whichever task has its input ready, stealing tasks from the other pool threads when its own ones are
+         * idle. A task never runs on 2 pool threads at the same time, so the order inside each stage is kept.
+         * Thread ids marked with ThreadManager::addDedicatedThread (e.g., workers with thread-local state such as
+         * the GPU context) still get their own std::thread.
+         */
+        WorkStealing,
+    };
+
+    /**
+     * What a queue does when an element is pushed into it while it is full.
+     */
+    enum class QueueFullPolicy : unsigned char
+    {
+        Block,              /**< Wait until there is room (default), so no element is ever lost. */
+        /**
+         * Drop the oldest queued element (latest-frame-wins). A slower consumer always gets the freshest element and
+         * the latency stays constant under overload rather than growing until the queues fill. Meant for live
+         * sources (e.g., webcam or IP camera).
+         */
+        OverwriteOldest,
+    };
 }
 
 #endif // OPENPOSE_THREAD_ENUM_CLASSES_HPP
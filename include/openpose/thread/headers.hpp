@@ -2,15 +2,20 @@
 #define OPENPOSE_THREAD_HEADERS_HPP
 
 // thread module
+#include <openpose/thread/cpuAffinity.hpp>
 #include <openpose/thread/enumClasses.hpp>
+#include <openpose/thread/mpmcRingBuffer.hpp>
 #include <openpose/thread/priorityQueue.hpp>
 #include <openpose/thread/queue.hpp>
 #include <openpose/thread/queueBase.hpp>
+#include <openpose/thread/ringBufferQueue.hpp>
+#include <openpose/thread/spscRingBuffer.hpp>
 #include <openpose/thread/subThread.hpp>
 #include <openpose/thread/subThreadNoQueue.hpp>
 #include <openpose/thread/subThreadQueueIn.hpp>
 #include <openpose/thread/subThreadQueueInOut.hpp>
 #include <openpose/thread/subThreadQueueOut.hpp>
+#include <openpose/thread/telemetry.hpp>
 #include <openpose/thread/thread.hpp>
 #include <openpose/thread/threadManager.hpp>
 #include <openpose/thread/worker.hpp>
@@ -20,5 +25,6 @@
 #include <openpose/thread/wIdGenerator.hpp>
 #include <openpose/thread/wQueueAssembler.hpp>
 #include <openpose/thread/wQueueOrderer.hpp>
+#include <openpose/thread/workStealingScheduler.hpp>
 
 #endif // OPENPOSE_THREAD_HEADERS_HPP
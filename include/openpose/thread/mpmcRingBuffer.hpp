@@ -0,0 +1,204 @@
+#ifndef OPENPOSE_THREAD_MPMC_RING_BUFFER_HPP
+#define OPENPOSE_THREAD_MPMC_RING_BUFFER_HPP
+
+#include <atomic>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Lock-free bounded multi-producer/multi-consumer ring buffer (D. Vyukov's bounded MPMC queue).
+     * Each slot holds a sequence number that tells producers and consumers whether it is free or filled for their
+     * turn, so a push or pop only costs one compare-and-swap on the shared counter plus one store on the slot.
+     * size() and empty() can be called from any thread, but they are only a snapshot.
+     * The algorithm needs at least 2 slots (otherwise "filled for this lap" and "free for the next one" would have the
+     * same sequence number), so a capacity of 1 uses 2 slots and also checks the consumer counter when pushing.
+     */
+    template<typename T>
+    class MpmcRingBuffer
+    {
+    public:
+        explicit MpmcRingBuffer(const size_t capacity);
+
+        virtual ~MpmcRingBuffer();
+
+        bool tryPush(const T& t);
+
+        bool tryPop(T& t);
+
+        size_t size() const;
+
+        bool empty() const;
+
+        inline size_t capacity() const
+        {
+            return mCapacity;
+        }
+
+    private:
+        static const size_t CACHE_LINE_SIZE = 64;
+
+        struct Slot
+        {
+            std::atomic<size_t> sequence;
+            T t;
+        };
+
+        const size_t mCapacity;
+        const size_t mNumberSlots;
+        std::unique_ptr<Slot[]> upSlots;
+        char mPadding0[CACHE_LINE_SIZE];
+        std::atomic<size_t> mEnqueuePosition;
+        char mPadding1[CACHE_LINE_SIZE];
+        std::atomic<size_t> mDequeuePosition;
+        char mPadding2[CACHE_LINE_SIZE];
+
+        DELETE_COPY(MpmcRingBuffer);
+    };
+}
+
+
+
+
+
+// Implementation
+namespace op
+{
+    template<typename T>
+    MpmcRingBuffer<T>::MpmcRingBuffer(const size_t capacity) :
+        mCapacity{capacity},
+        mNumberSlots{capacity < 2 ? 2 : capacity},
+        upSlots{new Slot[mNumberSlots]},
+        mEnqueuePosition{0},
+        mDequeuePosition{0}
+    {
+        try
+        {
+            if (capacity < 1)
+                error("The capacity must be at least 1.", __LINE__, __FUNCTION__, __FILE__);
+            for (auto i = 0u ; i < mNumberSlots ; i++)
+                upSlots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename T>
+    MpmcRingBuffer<T>::~MpmcRingBuffer()
+    {
+    }
+
+    template<typename T>
+    bool MpmcRingBuffer<T>::tryPush(const T& t)
+    {
+        try
+        {
+            auto position = mEnqueuePosition.load(std::memory_order_relaxed);
+            Slot* slot;
+            while (true)
+            {
+                slot = &upSlots[position % mNumberSlots];
+                const auto sequence = slot->sequence.load(std::memory_order_acquire);
+                const auto difference = (long long)sequence - (long long)position;
+                // Free slot for this position -> claim it
+                if (difference == 0)
+                {
+                    // Extra slot (capacity 1) -> full if the previous element was not popped yet
+                    if (mCapacity < mNumberSlots
+                        && position - mDequeuePosition.load(std::memory_order_acquire) >= mCapacity)
+                        return false;
+                    if (mEnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                }
+                // Slot not consumed yet since the previous lap -> full
+                else if (difference < 0)
+                    return false;
+                // Another producer claimed it -> retry with the updated position
+                else
+                    position = mEnqueuePosition.load(std::memory_order_relaxed);
+            }
+            slot->t = t;
+            slot->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename T>
+    bool MpmcRingBuffer<T>::tryPop(T& t)
+    {
+        try
+        {
+            auto position = mDequeuePosition.load(std::memory_order_relaxed);
+            Slot* slot;
+            while (true)
+            {
+                slot = &upSlots[position % mNumberSlots];
+                const auto sequence = slot->sequence.load(std::memory_order_acquire);
+                const auto difference = (long long)sequence - (long long)(position + 1);
+                // Filled slot for this position -> claim it
+                if (difference == 0)
+                {
+                    if (mDequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                }
+                // Slot not filled yet -> empty
+                else if (difference < 0)
+                    return false;
+                // Another consumer claimed it -> retry with the updated position
+                else
+                    position = mDequeuePosition.load(std::memory_order_relaxed);
+            }
+            t = std::move(slot->t);
+            // Release the slot content (e.g., the shared_ptr) right away rather than when it is overwritten
+            slot->t = T{};
+            slot->sequence.store(position + mNumberSlots, std::memory_order_release);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename T>
+    size_t MpmcRingBuffer<T>::size() const
+    {
+        try
+        {
+            // Claimed (not necessarily finished) positions. Dequeue first, so enqueue >= dequeue
+            const auto dequeuePosition = mDequeuePosition.load(std::memory_order_acquire);
+            const auto enqueuePosition = mEnqueuePosition.load(std::memory_order_acquire);
+            const auto size = enqueuePosition - dequeuePosition;
+            return (size < mCapacity ? size : mCapacity);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0;
+        }
+    }
+
+    template<typename T>
+    bool MpmcRingBuffer<T>::empty() const
+    {
+        try
+        {
+            return size() == 0;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+}
+
+#endif // OPENPOSE_THREAD_MPMC_RING_BUFFER_HPP
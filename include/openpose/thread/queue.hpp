@@ -72,7 +72,10 @@ namespace op
 
             tDatums = {std::move(this->mTQueue.front())};
             this->mTQueue.pop();
-            this->mConditionVariable.notify_one();
+            this->mTelemetry.recordPop(this->mTQueue.size());
+            this->mConditionVariable.notify_all();
+            if (this->mNotifier)
+                this->mNotifier();
             return true;
         }
         catch (const std::exception& e)
@@ -1,10 +1,16 @@
 #ifndef OPENPOSE_THREAD_QUEUE_BASE_HPP
 #define OPENPOSE_THREAD_QUEUE_BASE_HPP
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <functional>
 #include <mutex>
 #include <queue> // std::queue & std::priority_queue
+#include <vector>
 #include <openpose/core/common.hpp>
+#include <openpose/thread/enumClasses.hpp>
+#include <openpose/thread/telemetry.hpp>
 
 namespace op
 {
@@ -36,6 +42,21 @@ namespace op
 
         bool waitAndPop();
 
+        /**
+         * Analogous to waitAndPop(TDatums&), but it also returns (false) as soon as the pushers are stopped (so the
+         * caller can check isRunning()) or `interrupt` returns true. `interrupt` (which can be empty) is evaluated
+         * with the queue mutex locked, so it must not lock this queue, and it is only re-evaluated when this queue
+         * changes or wakeUp() is called (e.g., by a stop listener of another queue, see addStopListener).
+         */
+        bool waitAndPop(TDatums& tDatums, const std::function<bool()>& interrupt);
+
+        /**
+         * It blocks until there is room for a new element or the pushers are stopped. With
+         * QueueFullPolicy::OverwriteOldest there is always room, so it returns true right away.
+         * @return Whether the queue is not full.
+         */
+        bool waitUntilNotFull();
+
         bool empty() const;
 
         void stop();
@@ -46,25 +67,98 @@ namespace op
 
         void addPusher();
 
+        /**
+         * It parks (active = false) or resumes one of the pushers added with addPusher() (see SubThread::setActive),
+         * so the default maximum size (the maximum number of poppers or pushers) only counts the active ones. Parked
+         * pushers must still call stopPusher() when closing.
+         */
+        void setPusherActive(const bool active);
+
+        /**
+         * Hint sent by ThreadManager with whether a single thread pushes into and pops from this queue. The mutex-based
+         * queues are valid for any number of threads, so it is ignored (see RingBufferQueue).
+         */
+        inline void setEndpoints(const bool, const bool)
+        {
+        }
+
+        /**
+         * Function called after each element is pushed or popped, and when the queue is stopped (e.g., to wake up
+         * the ThreadManagerBackend::WorkStealing pool). It might be called while the queue mutex is locked, so it must
+         * not call this queue. It must be set before the queue is used.
+         */
+        void setNotifier(const std::function<void()>& notifier);
+
+        /**
+         * Function called once the queue is stopped (stop() or the last stopPusher()), without the queue mutex locked,
+         * e.g., to wakeUp() the threads waiting on another queue for something that depends on this one (see
+         * SubThreadQueueInOut). It must be added before the queue is used.
+         */
+        void addStopListener(const std::function<void()>& stopListener);
+
+        /**
+         * It wakes up the threads blocked on this queue, so they re-evaluate their wait condition (e.g., the
+         * `interrupt` of waitAndPop(TDatums&, interrupt)).
+         */
+        void wakeUp();
+
         bool isRunning() const;
 
+        /**
+         * Whether the queue was stopped (stop()) or its last pusher stopped while it was empty, i.e., nothing else
+         * will be popped from it. Unlike isRunning(), it does not lock the queue, so it can be the `interrupt` of a
+         * wait on another queue.
+         */
+        bool isPopStopped() const;
+
         bool isFull() const;
 
+        /**
+         * Whether an element can be pushed right away, i.e., the queue is not full or it overwrites its oldest element
+         * (QueueFullPolicy::OverwriteOldest).
+         */
+        bool hasRoom() const;
+
+        /**
+         * It selects what pushing into a full queue does (see QueueFullPolicy). With QueueFullPolicy::OverwriteOldest,
+         * tryX() and waitAndX() drop the oldest element rather than failing or waiting. It must be called before the
+         * queue is used.
+         */
+        void setFullPolicy(const QueueFullPolicy fullPolicy);
+
+        /**
+         * Number of elements dropped to make room for newer ones (QueueFullPolicy::OverwriteOldest, forceEmplace() or
+         * forcePush()).
+         */
+        unsigned long long getNumberDropped() const;
+
         size_t size() const;
 
         void clear();
 
+        /**
+         * Snapshot of the push/pop counts, time-averaged occupancy and blocked waits of this queue (see
+         * QueueTelemetry). It can be called from any thread.
+         */
+        QueueStatistics getStatistics() const;
+
         virtual TDatums front() const = 0;
 
     protected:
         mutable std::mutex mMutex;
         long long mPoppers;
         long long mPushers;
+        long long mParkedPushers;
         long long mMaxPoppersPushers;
-        bool mPopIsStopped;
-        bool mPushIsStopped;
+        std::atomic<bool> mPopIsStopped;
+        std::atomic<bool> mPushIsStopped;
         std::condition_variable mConditionVariable;
+        std::function<void()> mNotifier;
+        std::vector<std::function<void()>> mStopListeners;
+        QueueFullPolicy mFullPolicy;
+        unsigned long long mNumberDropped;
         TQueue mTQueue;
+        QueueTelemetry mTelemetry;
 
         virtual bool pop(TDatums& tDatums) = 0;
 
@@ -73,12 +167,19 @@ namespace op
     private:
         const long long mMaxSize;
 
+        // mConditionVariable.wait(lock, predicate), timing the wait if it actually blocks
+        template<typename TPredicate>
+        void wait(std::unique_lock<std::mutex>& lock, const TPredicate& predicate, const bool pushing);
+
         bool emplace(TDatums& tDatums);
 
         bool push(const TDatums& tDatums);
 
         bool pop();
 
+        // If full and QueueFullPolicy::OverwriteOldest, it drops the oldest element. Called with mMutex locked
+        void dropOldestIfOverwriting();
+
         void updateMaxPoppersPushers();
 
         DELETE_COPY(QueueBase);
@@ -98,8 +199,12 @@ namespace op
     QueueBase<TDatums, TQueue>::QueueBase(const long long maxSize) :
         mPoppers{0ll},
         mPushers{0ll},
+        mParkedPushers{0ll},
+        mMaxPoppersPushers{0ll},
         mPopIsStopped{false},
         mPushIsStopped{false},
+        mFullPolicy{QueueFullPolicy::Block},
+        mNumberDropped{0ull},
         mMaxSize{maxSize}
     {
     }
@@ -127,7 +232,11 @@ namespace op
         {
             const std::lock_guard<std::mutex> lock{mMutex};
             if (mTQueue.size() >= getMaxSize())
+            {
                 mTQueue.pop();
+                mNumberDropped++;
+                mTelemetry.recordSize(mTQueue.size());
+            }
             return emplace(tDatums);
         }
         catch (const std::exception& e)
@@ -143,6 +252,7 @@ namespace op
         try
         {
             const std::lock_guard<std::mutex> lock{mMutex};
+            dropOldestIfOverwriting();
             if (mTQueue.size() >= getMaxSize())
                 return false;
             return emplace(tDatums);
@@ -160,7 +270,8 @@ namespace op
         try
         {
             std::unique_lock<std::mutex> lock{mMutex};
-            mConditionVariable.wait(lock, [this]{return mTQueue.size() < getMaxSize() || mPushIsStopped; });
+            dropOldestIfOverwriting();
+            wait(lock, [this]{return mTQueue.size() < getMaxSize() || mPushIsStopped; }, true);
             return emplace(tDatums);
         }
         catch (const std::exception& e)
@@ -177,7 +288,11 @@ namespace op
         {
             const std::lock_guard<std::mutex> lock{mMutex};
             if (mTQueue.size() >= getMaxSize())
+            {
                 mTQueue.pop();
+                mNumberDropped++;
+                mTelemetry.recordSize(mTQueue.size());
+            }
             return push(tDatums);
         }
         catch (const std::exception& e)
@@ -193,6 +308,7 @@ namespace op
         try
         {
             const std::lock_guard<std::mutex> lock{mMutex};
+            dropOldestIfOverwriting();
             if (mTQueue.size() >= getMaxSize())
                 return false;
             return push(tDatums);
@@ -210,7 +326,8 @@ namespace op
         try
         {
             std::unique_lock<std::mutex> lock{mMutex};
-            mConditionVariable.wait(lock, [this]{return mTQueue.size() < getMaxSize() || mPushIsStopped; });
+            dropOldestIfOverwriting();
+            wait(lock, [this]{return mTQueue.size() < getMaxSize() || mPushIsStopped; }, true);
             return push(tDatums);
         }
         catch (const std::exception& e)
@@ -256,7 +373,7 @@ namespace op
         try
         {
             std::unique_lock<std::mutex> lock{mMutex};
-            mConditionVariable.wait(lock, [this]{return !mTQueue.empty() || mPopIsStopped; });
+            wait(lock, [this]{return !mTQueue.empty() || mPopIsStopped; }, false);
             return pop(tDatums);
         }
         catch (const std::exception& e)
@@ -272,7 +389,7 @@ namespace op
         try
         {
             std::unique_lock<std::mutex> lock{mMutex};
-            mConditionVariable.wait(lock, [this]{return !mTQueue.empty() || mPopIsStopped; });
+            wait(lock, [this]{return !mTQueue.empty() || mPopIsStopped; }, false);
             return pop();
         }
         catch (const std::exception& e)
@@ -282,6 +399,42 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TQueue>
+    bool QueueBase<TDatums, TQueue>::waitAndPop(TDatums& tDatums, const std::function<bool()>& interrupt)
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            wait(lock, [this, &interrupt]{
+                return !mTQueue.empty() || mPopIsStopped || mPushIsStopped || (interrupt && interrupt());
+            }, false);
+            return pop(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    bool QueueBase<TDatums, TQueue>::waitUntilNotFull()
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            if (mFullPolicy == QueueFullPolicy::OverwriteOldest)
+                return true;
+            wait(lock, [this]{return mTQueue.size() < getMaxSize() || mPushIsStopped; }, true);
+            return mTQueue.size() < getMaxSize();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     template<typename TDatums, typename TQueue>
     bool QueueBase<TDatums, TQueue>::empty() const
     {
@@ -303,12 +456,22 @@ namespace op
         try
         {
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-            const std::lock_guard<std::mutex> lock{mMutex};
-            mPopIsStopped = {true};
-            mPushIsStopped = {true};
-            while (!mTQueue.empty())
-                mTQueue.pop();
-            mConditionVariable.notify_all();
+            std::vector<std::function<void()>> stopListeners;
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mPopIsStopped = {true};
+                mPushIsStopped = {true};
+                while (!mTQueue.empty())
+                    mTQueue.pop();
+                mTelemetry.recordSize(0ull);
+                mConditionVariable.notify_all();
+                if (mNotifier)
+                    mNotifier();
+                stopListeners = mStopListeners;
+            }
+            // Without mMutex locked, since they might wait for the mutex of other queues
+            for (const auto& stopListener : stopListeners)
+                stopListener();
         }
         catch (const std::exception& e)
         {
@@ -322,15 +485,24 @@ namespace op
         try
         {
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-            const std::lock_guard<std::mutex> lock{mMutex};
-            mPushers--;
-            if (mPushers == 0)
+            std::vector<std::function<void()>> stopListeners;
             {
-                mPushIsStopped = {true};
-                if (mTQueue.empty())
-                    mPopIsStopped = {true};
-                mConditionVariable.notify_all();
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mPushers--;
+                if (mPushers == 0)
+                {
+                    mPushIsStopped = {true};
+                    if (mTQueue.empty())
+                        mPopIsStopped = {true};
+                    mConditionVariable.notify_all();
+                    if (mNotifier)
+                        mNotifier();
+                    stopListeners = mStopListeners;
+                }
             }
+            // Without mMutex locked, since they might wait for the mutex of other queues
+            for (const auto& stopListener : stopListeners)
+                stopListener();
         }
         catch (const std::exception& e)
         {
@@ -370,6 +542,66 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::setPusherActive(const bool active)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mParkedPushers += (active ? -1 : 1);
+            updateMaxPoppersPushers();
+            // Resumed pusher -> larger default maximum size, so the pushers waiting for room might proceed
+            mConditionVariable.notify_all();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::setNotifier(const std::function<void()>& notifier)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mNotifier = notifier;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::addStopListener(const std::function<void()>& stopListener)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mStopListeners.emplace_back(stopListener);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::wakeUp()
+    {
+        try
+        {
+            // Taking the mutex guarantees that a waiter that already evaluated its condition is sleeping
+            { const std::lock_guard<std::mutex> lock{mMutex}; }
+            mConditionVariable.notify_all();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename TDatums, typename TQueue>
     bool QueueBase<TDatums, TQueue>::isRunning() const
     {
@@ -385,6 +617,20 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TQueue>
+    bool QueueBase<TDatums, TQueue>::isPopStopped() const
+    {
+        try
+        {
+            return mPopIsStopped;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     template<typename TDatums, typename TQueue>
     bool QueueBase<TDatums, TQueue>::isFull() const
     {
@@ -400,6 +646,50 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TQueue>
+    bool QueueBase<TDatums, TQueue>::hasRoom() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            return mFullPolicy == QueueFullPolicy::OverwriteOldest || mTQueue.size() < getMaxSize();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::setFullPolicy(const QueueFullPolicy fullPolicy)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mFullPolicy = {fullPolicy};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    unsigned long long QueueBase<TDatums, TQueue>::getNumberDropped() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            return mNumberDropped;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
     template<typename TDatums, typename TQueue>
     size_t QueueBase<TDatums, TQueue>::size() const
     {
@@ -423,6 +713,7 @@ namespace op
             const std::lock_guard<std::mutex> lock{mMutex};
             while (!mTQueue.empty())
                 mTQueue.pop();
+            mTelemetry.recordSize(0ull);
         }
         catch (const std::exception& e)
         {
@@ -430,6 +721,22 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TQueue>
+    QueueStatistics QueueBase<TDatums, TQueue>::getStatistics() const
+    {
+        try
+        {
+            auto queueStatistics = mTelemetry.getStatistics();
+            queueStatistics.numberDropped = getNumberDropped();
+            return queueStatistics;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return QueueStatistics{};
+        }
+    }
+
     template<typename TDatums, typename TQueue>
     unsigned long long QueueBase<TDatums, TQueue>::getMaxSize() const
     {
@@ -453,7 +760,10 @@ namespace op
                 return false;
 
             mTQueue.emplace(tDatums);
+            mTelemetry.recordPush(mTQueue.size());
             mConditionVariable.notify_all();
+            if (mNotifier)
+                mNotifier();
             return true;
         }
         catch (const std::exception& e)
@@ -472,7 +782,10 @@ namespace op
                 return false;
 
             mTQueue.push(tDatums);
+            mTelemetry.recordPush(mTQueue.size());
             mConditionVariable.notify_all();
+            if (mNotifier)
+                mNotifier();
             return true;
         }
         catch (const std::exception& e)
@@ -491,7 +804,10 @@ namespace op
                 return false;
 
             mTQueue.pop();
+            mTelemetry.recordPop(mTQueue.size());
             mConditionVariable.notify_all();
+            if (mNotifier)
+                mNotifier();
             return true;
         }
         catch (const std::exception& e)
@@ -501,12 +817,55 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TQueue>
+    template<typename TPredicate>
+    void QueueBase<TDatums, TQueue>::wait(
+        std::unique_lock<std::mutex>& lock, const TPredicate& predicate, const bool pushing)
+    {
+        try
+        {
+            if (!predicate())
+            {
+                const auto start = std::chrono::steady_clock::now();
+                mConditionVariable.wait(lock, predicate);
+                const auto waitTime = std::chrono::steady_clock::now() - start;
+                if (pushing)
+                    mTelemetry.recordPushWait(waitTime);
+                else
+                    mTelemetry.recordPopWait(waitTime);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::dropOldestIfOverwriting()
+    {
+        try
+        {
+            if (mFullPolicy == QueueFullPolicy::OverwriteOldest && !mPushIsStopped
+                && !mTQueue.empty() && mTQueue.size() >= getMaxSize())
+            {
+                mTQueue.pop();
+                mNumberDropped++;
+                mTelemetry.recordSize(mTQueue.size());
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename TDatums, typename TQueue>
     void QueueBase<TDatums, TQueue>::updateMaxPoppersPushers()
     {
         try
         {
-            mMaxPoppersPushers = fastMax(mPoppers, mPushers);
+            mMaxPoppersPushers = fastMax(mPoppers, mPushers - mParkedPushers);
         }
         catch (const std::exception& e)
         {
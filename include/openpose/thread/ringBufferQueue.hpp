@@ -0,0 +1,875 @@
+#ifndef OPENPOSE_THREAD_RING_BUFFER_QUEUE_HPP
+#define OPENPOSE_THREAD_RING_BUFFER_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include <openpose/core/common.hpp>
+#include <openpose/thread/enumClasses.hpp>
+#include <openpose/thread/mpmcRingBuffer.hpp>
+#include <openpose/thread/spscRingBuffer.hpp>
+#include <openpose/thread/telemetry.hpp>
+
+namespace op
+{
+    /**
+     * Bounded lock-free queue that can be used as the TQueue template parameter of ThreadManager instead of Queue.
+     * Elements are stored in a SpscRingBuffer if the queue has a single producer and a single consumer thread, or in
+     * a MpmcRingBuffer otherwise. ThreadManager chooses for each queue by calling setEndpoints() once its threads are
+     * configured; if it was not called, the MPMC version is used.
+     * Pushing and popping do not take any lock. The mutex and condition variable are only used to put the
+     * waitAndX() callers to sleep, and they are only notified if someone is actually waiting.
+     * Differences with Queue:
+     *  - The storage is allocated once (by setEndpoints() or the first time it is used), with as many elements as
+     *    the maximum size (capped to MAX_CAPACITY), so the pushers (addPusher()) must be added before that.
+     *  - stop() does not release the queued elements (that would pop from a non-consumer thread), they are released
+     *    by clear() (only from the consumer thread while running) or the destructor.
+     *  - forceEmplace(), forcePush() and front() are not provided, since they would need to pop/peek from the producer
+     *    side. For the same reason, QueueFullPolicy::OverwriteOldest always uses the MPMC version.
+     */
+    template<typename TDatums>
+    class RingBufferQueue
+    {
+    public:
+        explicit RingBufferQueue(const long long maxSize = -1);
+
+        virtual ~RingBufferQueue();
+
+        /**
+         * It tells the queue whether a single thread pushes into it and a single thread pops from it, so it can use
+         * the SPSC ring buffer. It must be called before the queue is used.
+         */
+        void setEndpoints(const bool singleProducer, const bool singleConsumer);
+
+        /**
+         * Function called after each element is pushed or popped, and when the queue is stopped (e.g., to wake up
+         * the ThreadManagerBackend::WorkStealing pool). It must be set before the queue is used.
+         */
+        void setNotifier(const std::function<void()>& notifier);
+
+        /**
+         * Analogous to QueueBase::addStopListener. It must be added before the queue is used.
+         */
+        void addStopListener(const std::function<void()>& stopListener);
+
+        /**
+         * Analogous to QueueBase::wakeUp.
+         */
+        void wakeUp();
+
+        /**
+         * Analogous to QueueBase::setFullPolicy. It must be called before the queue is used.
+         */
+        void setFullPolicy(const QueueFullPolicy fullPolicy);
+
+        bool tryEmplace(TDatums& tDatums);
+
+        bool waitAndEmplace(TDatums& tDatums);
+
+        bool tryPush(const TDatums& tDatums);
+
+        bool waitAndPush(const TDatums& tDatums);
+
+        bool tryPop(TDatums& tDatums);
+
+        bool tryPop();
+
+        bool waitAndPop(TDatums& tDatums);
+
+        bool waitAndPop();
+
+        /**
+         * Analogous to QueueBase::waitAndPop(TDatums&, interrupt).
+         */
+        bool waitAndPop(TDatums& tDatums, const std::function<bool()>& interrupt);
+
+        bool waitUntilNotFull();
+
+        bool empty() const;
+
+        void stop();
+
+        void stopPusher();
+
+        void addPopper();
+
+        void addPusher();
+
+        /**
+         * Analogous to QueueBase::setPusherActive, but the storage is allocated once with the size given by all the
+         * pushers, so it is ignored.
+         */
+        inline void setPusherActive(const bool)
+        {
+        }
+
+        bool isRunning() const;
+
+        /**
+         * Analogous to QueueBase::isPopStopped.
+         */
+        bool isPopStopped() const;
+
+        bool isFull() const;
+
+        bool hasRoom() const;
+
+        unsigned long long getNumberDropped() const;
+
+        size_t size() const;
+
+        void clear();
+
+        /**
+         * Analogous to QueueBase::getStatistics. Recording them only costs a few relaxed atomic operations per push
+         * and pop, so the queue stays lock-free.
+         */
+        QueueStatistics getStatistics() const;
+
+        /**
+         * Whether the SPSC ring buffer is used. Calling it allocates the storage, as any other function.
+         */
+        bool isSingleProducerConsumer() const;
+
+    private:
+        static const unsigned long long MAX_CAPACITY = 1ull << 16;
+
+        const long long mMaxSize;
+        long long mPoppers;
+        long long mPushers;
+        bool mSingleProducer;
+        bool mSingleConsumer;
+        QueueFullPolicy mFullPolicy;
+        std::atomic<unsigned long long> mNumberDropped;
+        std::atomic<bool> mPopIsStopped;
+        std::atomic<bool> mPushIsStopped;
+        // Storage (only one of them is allocated, lazily, so mutable)
+        mutable std::once_flag mInitializeFlag;
+        mutable std::unique_ptr<SpscRingBuffer<TDatums>> upSpscRingBuffer;
+        mutable std::unique_ptr<MpmcRingBuffer<TDatums>> upMpmcRingBuffer;
+        // Sleeping waiters
+        mutable std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        std::atomic<int> mWaiters;
+        std::function<void()> mNotifier;
+        std::vector<std::function<void()>> mStopListeners;
+        QueueTelemetry mTelemetry;
+
+        void initialize() const;
+
+        unsigned long long getMaxSize() const;
+
+        size_t getCapacity() const;
+
+        bool push(const TDatums& tDatums);
+
+        // push() that drops the oldest elements if the queue is full and QueueFullPolicy::OverwriteOldest
+        bool pushOrOverwrite(const TDatums& tDatums);
+
+        bool pop(TDatums& tDatums);
+
+        // It times the wait (as a push or pop wait) if it actually blocks
+        template<typename TPredicate>
+        void wait(const TPredicate& predicate, const bool pushing);
+
+        void notify();
+
+        DELETE_COPY(RingBufferQueue);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/core/datum.hpp>
+#include <openpose/utilities/fastMath.hpp>
+namespace op
+{
+    template<typename TDatums>
+    RingBufferQueue<TDatums>::RingBufferQueue(const long long maxSize) :
+        mMaxSize{maxSize},
+        mPoppers{0ll},
+        mPushers{0ll},
+        mSingleProducer{false},
+        mSingleConsumer{false},
+        mFullPolicy{QueueFullPolicy::Block},
+        mNumberDropped{0ull},
+        mPopIsStopped{false},
+        mPushIsStopped{false},
+        mWaiters{0}
+    {
+    }
+
+    template<typename TDatums>
+    RingBufferQueue<TDatums>::~RingBufferQueue()
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            stop();
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::setEndpoints(const bool singleProducer, const bool singleConsumer)
+    {
+        try
+        {
+            mSingleProducer = {singleProducer};
+            mSingleConsumer = {singleConsumer};
+            initialize();
+            if ((upSpscRingBuffer != nullptr)
+                != (singleProducer && singleConsumer && mFullPolicy == QueueFullPolicy::Block))
+                error("setEndpoints() must be called before the queue is used.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::setNotifier(const std::function<void()>& notifier)
+    {
+        try
+        {
+            mNotifier = notifier;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::addStopListener(const std::function<void()>& stopListener)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mStopListeners.emplace_back(stopListener);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::wakeUp()
+    {
+        try
+        {
+            // Taking the mutex guarantees that a waiter that already evaluated its condition is sleeping
+            { const std::lock_guard<std::mutex> lock{mMutex}; }
+            mConditionVariable.notify_all();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::setFullPolicy(const QueueFullPolicy fullPolicy)
+    {
+        try
+        {
+            mFullPolicy = {fullPolicy};
+            // Not isSingleProducerConsumer(), which would allocate the storage
+            if (fullPolicy == QueueFullPolicy::OverwriteOldest && upSpscRingBuffer != nullptr)
+                error("setFullPolicy() must be called before the queue is used.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::tryEmplace(TDatums& tDatums)
+    {
+        try
+        {
+            return tryPush(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::waitAndEmplace(TDatums& tDatums)
+    {
+        try
+        {
+            return waitAndPush(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::tryPush(const TDatums& tDatums)
+    {
+        try
+        {
+            if (mPushIsStopped)
+                return false;
+            return pushOrOverwrite(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::waitAndPush(const TDatums& tDatums)
+    {
+        try
+        {
+            while (!mPushIsStopped)
+            {
+                if (pushOrOverwrite(tDatums))
+                    return true;
+                wait([this]{ return size() < getCapacity() || mPushIsStopped; }, true);
+            }
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::tryPop(TDatums& tDatums)
+    {
+        try
+        {
+            if (mPopIsStopped)
+                return false;
+            return pop(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::tryPop()
+    {
+        try
+        {
+            TDatums tDatums;
+            return tryPop(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::waitAndPop(TDatums& tDatums)
+    {
+        try
+        {
+            while (!mPopIsStopped)
+            {
+                if (pop(tDatums))
+                    return true;
+                wait([this]{ return !empty() || mPopIsStopped; }, false);
+            }
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::waitAndPop()
+    {
+        try
+        {
+            TDatums tDatums;
+            return waitAndPop(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::waitAndPop(TDatums& tDatums, const std::function<bool()>& interrupt)
+    {
+        try
+        {
+            if (mPopIsStopped)
+                return false;
+            if (pop(tDatums))
+                return true;
+            wait([this, &interrupt]{
+                return !empty() || mPopIsStopped || mPushIsStopped || (interrupt && interrupt());
+            }, false);
+            return tryPop(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::waitUntilNotFull()
+    {
+        try
+        {
+            if (mFullPolicy == QueueFullPolicy::OverwriteOldest)
+                return true;
+            wait([this]{ return size() < getCapacity() || mPushIsStopped; }, true);
+            return size() < getCapacity();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::empty() const
+    {
+        try
+        {
+            return size() == 0;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::stop()
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            std::vector<std::function<void()>> stopListeners;
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mPopIsStopped = {true};
+                mPushIsStopped = {true};
+                stopListeners = mStopListeners;
+            }
+            mConditionVariable.notify_all();
+            if (mNotifier)
+                mNotifier();
+            for (const auto& stopListener : stopListeners)
+                stopListener();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::stopPusher()
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            std::vector<std::function<void()>> stopListeners;
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mPushers--;
+                if (mPushers == 0)
+                {
+                    mPushIsStopped = {true};
+                    if (empty())
+                        mPopIsStopped = {true};
+                    stopListeners = mStopListeners;
+                }
+            }
+            mConditionVariable.notify_all();
+            if (mNotifier)
+                mNotifier();
+            for (const auto& stopListener : stopListeners)
+                stopListener();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::addPopper()
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mPoppers++;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::addPusher()
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mPushers++;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::isRunning() const
+    {
+        try
+        {
+            return !(mPushIsStopped && (mPopIsStopped || empty()));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::isPopStopped() const
+    {
+        try
+        {
+            return mPopIsStopped;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::isFull() const
+    {
+        try
+        {
+            return size() >= getCapacity();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::hasRoom() const
+    {
+        try
+        {
+            return mFullPolicy == QueueFullPolicy::OverwriteOldest || !isFull();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    template<typename TDatums>
+    unsigned long long RingBufferQueue<TDatums>::getNumberDropped() const
+    {
+        try
+        {
+            return mNumberDropped;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template<typename TDatums>
+    size_t RingBufferQueue<TDatums>::size() const
+    {
+        try
+        {
+            initialize();
+            return (upSpscRingBuffer != nullptr ? upSpscRingBuffer->size() : upMpmcRingBuffer->size());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0;
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::clear()
+    {
+        try
+        {
+            TDatums tDatums;
+            while (pop(tDatums))
+                tDatums = TDatums{};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    QueueStatistics RingBufferQueue<TDatums>::getStatistics() const
+    {
+        try
+        {
+            auto queueStatistics = mTelemetry.getStatistics();
+            queueStatistics.numberDropped = getNumberDropped();
+            return queueStatistics;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return QueueStatistics{};
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::isSingleProducerConsumer() const
+    {
+        try
+        {
+            initialize();
+            return upSpscRingBuffer != nullptr;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::initialize() const
+    {
+        try
+        {
+            // No mMutex here, the waiters call it while holding it
+            std::call_once(mInitializeFlag, [this]{
+                const auto capacity = size_t(fastMin(getMaxSize(), MAX_CAPACITY));
+                // Overwriting pops from the producer side -> MPMC
+                if (mSingleProducer && mSingleConsumer && mFullPolicy == QueueFullPolicy::Block)
+                    upSpscRingBuffer.reset(new SpscRingBuffer<TDatums>{capacity});
+                else
+                    upMpmcRingBuffer.reset(new MpmcRingBuffer<TDatums>{capacity});
+            });
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    unsigned long long RingBufferQueue<TDatums>::getMaxSize() const
+    {
+        try
+        {
+            return (mMaxSize > 0 ? mMaxSize : fastMax(1ll, fastMax(mPoppers, mPushers)));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 1ull;
+        }
+    }
+
+    template<typename TDatums>
+    size_t RingBufferQueue<TDatums>::getCapacity() const
+    {
+        try
+        {
+            initialize();
+            return (upSpscRingBuffer != nullptr ? upSpscRingBuffer->capacity() : upMpmcRingBuffer->capacity());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 1;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::push(const TDatums& tDatums)
+    {
+        try
+        {
+            initialize();
+            const auto pushed = (upSpscRingBuffer != nullptr
+                ? upSpscRingBuffer->tryPush(tDatums) : upMpmcRingBuffer->tryPush(tDatums));
+            if (pushed)
+            {
+                mTelemetry.recordPush(size());
+                notify();
+            }
+            return pushed;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::pushOrOverwrite(const TDatums& tDatums)
+    {
+        try
+        {
+            if (push(tDatums))
+                return true;
+            if (mFullPolicy == QueueFullPolicy::Block)
+                return false;
+            // Full -> drop the oldest one and retry (the consumers might be popping meanwhile, so it might take a few
+            // attempts)
+            TDatums tDatumsDropped;
+            while (!mPushIsStopped)
+            {
+                if (upMpmcRingBuffer->tryPop(tDatumsDropped))
+                {
+                    mNumberDropped++;
+                    mTelemetry.recordSize(size());
+                    tDatumsDropped = TDatums{};
+                }
+                if (push(tDatums))
+                    return true;
+            }
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::pop(TDatums& tDatums)
+    {
+        try
+        {
+            initialize();
+            const auto popped = (upSpscRingBuffer != nullptr
+                ? upSpscRingBuffer->tryPop(tDatums) : upMpmcRingBuffer->tryPop(tDatums));
+            if (popped)
+            {
+                mTelemetry.recordPop(size());
+                notify();
+            }
+            return popped;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    template<typename TPredicate>
+    void RingBufferQueue<TDatums>::wait(const TPredicate& predicate, const bool pushing)
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            mWaiters++;
+            // Pairs with the fence in notify(): either notify() sees this waiter or the predicate sees its change
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!predicate())
+            {
+                const auto start = std::chrono::steady_clock::now();
+                mConditionVariable.wait(lock, predicate);
+                const auto waitTime = std::chrono::steady_clock::now() - start;
+                if (pushing)
+                    mTelemetry.recordPushWait(waitTime);
+                else
+                    mTelemetry.recordPopWait(waitTime);
+            }
+            mWaiters--;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::notify()
+    {
+        try
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (mWaiters > 0)
+            {
+                // Taking the mutex guarantees that a waiter that already checked its predicate is sleeping
+                { const std::lock_guard<std::mutex> lock{mMutex}; }
+                mConditionVariable.notify_all();
+            }
+            if (mNotifier)
+                mNotifier();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(RingBufferQueue);
+}
+
+#endif // OPENPOSE_THREAD_RING_BUFFER_QUEUE_HPP
@@ -0,0 +1,170 @@
+#ifndef OPENPOSE_THREAD_SPSC_RING_BUFFER_HPP
+#define OPENPOSE_THREAD_SPSC_RING_BUFFER_HPP
+
+#include <atomic>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Lock-free bounded single-producer/single-consumer ring buffer.
+     * tryPush() must only be called from one (producer) thread and tryPop() from one (consumer) thread at a time.
+     * size() and empty() can be called from any thread, but they are only a snapshot.
+     * The producer and consumer counters are kept on different cache lines, and each side caches the last known value
+     * of the other one, so the shared cache lines are only read when the buffer looks full/empty. The counters only
+     * grow (the slot is counter % capacity), so any thread can compute a valid size() from them.
+     */
+    template<typename T>
+    class SpscRingBuffer
+    {
+    public:
+        explicit SpscRingBuffer(const size_t capacity);
+
+        virtual ~SpscRingBuffer();
+
+        bool tryPush(const T& t);
+
+        bool tryPop(T& t);
+
+        size_t size() const;
+
+        bool empty() const;
+
+        inline size_t capacity() const
+        {
+            return mCapacity;
+        }
+
+    private:
+        static const size_t CACHE_LINE_SIZE = 64;
+
+        const size_t mCapacity;
+        std::vector<T> mBuffer;
+        char mPadding0[CACHE_LINE_SIZE];
+        // Consumer side
+        std::atomic<size_t> mHead;
+        size_t mCachedTail;
+        char mPadding1[CACHE_LINE_SIZE];
+        // Producer side
+        std::atomic<size_t> mTail;
+        size_t mCachedHead;
+        char mPadding2[CACHE_LINE_SIZE];
+
+        DELETE_COPY(SpscRingBuffer);
+    };
+}
+
+
+
+
+
+// Implementation
+namespace op
+{
+    template<typename T>
+    SpscRingBuffer<T>::SpscRingBuffer(const size_t capacity) :
+        mCapacity{capacity},
+        mBuffer(capacity),
+        mHead{0},
+        mCachedTail{0},
+        mTail{0},
+        mCachedHead{0}
+    {
+        try
+        {
+            if (capacity < 1)
+                error("The capacity must be at least 1.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename T>
+    SpscRingBuffer<T>::~SpscRingBuffer()
+    {
+    }
+
+    template<typename T>
+    bool SpscRingBuffer<T>::tryPush(const T& t)
+    {
+        try
+        {
+            const auto tail = mTail.load(std::memory_order_relaxed);
+            if (tail - mCachedHead == mCapacity)
+            {
+                mCachedHead = mHead.load(std::memory_order_acquire);
+                if (tail - mCachedHead == mCapacity)
+                    return false;
+            }
+            mBuffer[tail % mCapacity] = t;
+            mTail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename T>
+    bool SpscRingBuffer<T>::tryPop(T& t)
+    {
+        try
+        {
+            const auto head = mHead.load(std::memory_order_relaxed);
+            if (head == mCachedTail)
+            {
+                mCachedTail = mTail.load(std::memory_order_acquire);
+                if (head == mCachedTail)
+                    return false;
+            }
+            auto& slot = mBuffer[head % mCapacity];
+            t = std::move(slot);
+            // Release the slot content (e.g., the shared_ptr) right away rather than when it is overwritten
+            slot = T{};
+            mHead.store(head + 1, std::memory_order_release);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename T>
+    size_t SpscRingBuffer<T>::size() const
+    {
+        try
+        {
+            // Head first, so tail >= head. The tail might have moved meanwhile, so it is clamped to the capacity
+            const auto head = mHead.load(std::memory_order_acquire);
+            const auto tail = mTail.load(std::memory_order_acquire);
+            return (tail - head < mCapacity ? tail - head : mCapacity);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0;
+        }
+    }
+
+    template<typename T>
+    bool SpscRingBuffer<T>::empty() const
+    {
+        try
+        {
+            return mHead.load(std::memory_order_acquire) == mTail.load(std::memory_order_acquire);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+}
+
+#endif // OPENPOSE_THREAD_SPSC_RING_BUFFER_HPP
@@ -1,7 +1,14 @@
 #ifndef OPENPOSE_THREAD_SUB_THREAD_HPP
 #define OPENPOSE_THREAD_SUB_THREAD_HPP
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread> // std::this_thread
 #include <openpose/core/common.hpp>
+#include <openpose/thread/telemetry.hpp>
 #include <openpose/thread/worker.hpp>
 
 namespace op
@@ -19,16 +26,89 @@ namespace op
 
         virtual bool work() = 0;
 
+        /**
+         * Whether work() would make progress right now without waiting (input available, room in the output, or a
+         * queue stopped so the SubThread can be closed). Used by the WorkStealing ThreadManagerBackend to only run
+         * the stages that are ready.
+         */
+        virtual bool isReady() const = 0;
+
+        /**
+         * If enabled, work() sleeps on the queue condition variables (woken up when an element arrives, room frees
+         * up or either queue is stopped) rather than polling them every 100 microseconds.
+         * It must only be enabled if this SubThread is the only one in its Thread, otherwise it would stall the other
+         * SubThreads sharing that Thread while waiting.
+         */
+        void setBlocking(const bool blocking);
+
+        /**
+         * Service time of each TWorker (in order), i.e., the duration of its work() calls that consumed or produced
+         * an element. It can be called from any thread.
+         */
+        std::vector<WorkerStatistics> getWorkerStatistics() const;
+
+        /**
+         * Inactive (parked) SubThreads do not pop from their input queue, so the other replicas of the same stage get
+         * all the elements (see ThreadManager::addElasticStage). If blocking, they sleep until they are activated
+         * again. Once nothing else will be pushed into the input queue, they resume anyway, so they help draining it
+         * and close normally. It can be called from any thread while running.
+         */
+        virtual void setActive(const bool active);
+
+        inline bool isActive() const
+        {
+            return spParking->mActive;
+        }
+
     protected:
         inline size_t getTWorkersSize() const
         {
             return mTWorkers.size();
         }
 
+        inline bool isBlocking() const
+        {
+            return mBlocking;
+        }
+
         bool workTWorkers(TDatums& tDatums, const bool inputIsRunning);
 
+        // Whether any TWorker can output elements without new input, i.e., work() must not wait for the input queue
+        bool hasPendingOutput() const;
+
+        // Whether work() must leave the input queue alone: inactive, nothing buffered and the input still running
+        bool isParked(const bool inputIsRunning) const;
+
+        // Idle wait of a parked SubThread, until setActive(true) or the input queue stop listener is called
+        void waitWhileParked() const;
+
+        // Function to add as stop listener of the input queue (see QueueBase::addStopListener), so parked SubThreads
+        // resume once nothing else will be pushed into it
+        std::function<void()> getInputStopListener() const;
+
     private:
+        // State of setActive(), shared with the input queue stop listener (the queue might outlive this SubThread)
+        struct Parking
+        {
+            std::mutex mMutex;
+            std::condition_variable mConditionVariable;
+            std::atomic<bool> mActive;
+            std::atomic<bool> mInputIsStopped;
+
+            Parking() :
+                mActive{true},
+                mInputIsStopped{false}
+            {
+            }
+        };
+
         std::vector<TWorker> mTWorkers;
+        bool mBlocking;
+        const std::shared_ptr<Parking> spParking;
+        std::vector<std::unique_ptr<WorkerTelemetry>> mTelemetries;
+
+        // mTWorkers[index]->checkAndWork(tDatums), recording its service time
+        bool checkAndWork(const size_t index, TDatums& tDatums);
 
         DELETE_COPY(SubThread);
     };
@@ -43,8 +123,19 @@ namespace op
 {
     template<typename TDatums, typename TWorker>
     SubThread<TDatums, TWorker>::SubThread(const std::vector<TWorker>& tWorkers) :
-        mTWorkers{tWorkers}
+        mTWorkers{tWorkers},
+        mBlocking{false},
+        spParking{std::make_shared<Parking>()}
     {
+        try
+        {
+            for (const auto& tWorker : mTWorkers)
+                mTelemetries.emplace_back(new WorkerTelemetry{typeid(*tWorker)});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     template<typename TDatums, typename TWorker>
@@ -52,6 +143,19 @@ namespace op
     {
     }
 
+    template<typename TDatums, typename TWorker>
+    void SubThread<TDatums, TWorker>::setBlocking(const bool blocking)
+    {
+        try
+        {
+            mBlocking = {blocking};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename TDatums, typename TWorker>
     bool SubThread<TDatums, TWorker>::workTWorkers(TDatums& tDatums, const bool inputIsRunning)
     {
@@ -74,12 +178,12 @@ namespace op
                 // Iterate over all workers and check whether some of them stopped
                 auto allRunning = true;
                 auto lastOneStopped = false;
-                for (auto& worker : mTWorkers)
+                for (auto i = 0u ; i < mTWorkers.size() ; i++)
                 {
                     if (lastOneStopped)
-                        worker->tryStop();
+                        mTWorkers[i]->tryStop();
 
-                    if (!worker->checkAndWork(tDatums))
+                    if (!checkAndWork(i, tDatums))
                     {
                         allRunning = false;
                         lastOneStopped = true;
@@ -101,7 +205,7 @@ namespace op
                         auto lastIndexNotRunning = 0ull;
                         for (auto i = mTWorkers.size() - 1 ; i > 0 ; i--)
                         {
-                            if (!mTWorkers[i]->checkAndWork(tDatums))
+                            if (!checkAndWork(i, tDatums))
                             {
                                 lastIndexNotRunning = i;
                                 break;
@@ -137,6 +241,137 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TWorker>
+    void SubThread<TDatums, TWorker>::setActive(const bool active)
+    {
+        try
+        {
+            {
+                const std::lock_guard<std::mutex> lock{spParking->mMutex};
+                spParking->mActive = {active};
+            }
+            spParking->mConditionVariable.notify_all();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    std::vector<WorkerStatistics> SubThread<TDatums, TWorker>::getWorkerStatistics() const
+    {
+        try
+        {
+            std::vector<WorkerStatistics> workerStatistics;
+            for (const auto& telemetry : mTelemetries)
+                workerStatistics.emplace_back(telemetry->getStatistics());
+            return workerStatistics;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    bool SubThread<TDatums, TWorker>::checkAndWork(const size_t index, TDatums& tDatums)
+    {
+        try
+        {
+            // Idle calls (no input nor output, e.g., a consumer waiting for data) are not service time
+            const auto hadInput = (tDatums != nullptr);
+            const auto start = std::chrono::steady_clock::now();
+            const auto running = mTWorkers[index]->checkAndWork(tDatums);
+            if (hadInput || tDatums != nullptr)
+                mTelemetries[index]->record(std::chrono::steady_clock::now() - start);
+            return running;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    bool SubThread<TDatums, TWorker>::hasPendingOutput() const
+    {
+        try
+        {
+            for (const auto& tWorker : mTWorkers)
+                if (tWorker->isRunning() && tWorker->hasPendingOutput())
+                    return true;
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    bool SubThread<TDatums, TWorker>::isParked(const bool inputIsRunning) const
+    {
+        try
+        {
+            return !spParking->mActive && !spParking->mInputIsStopped && inputIsRunning && !hasPendingOutput();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void SubThread<TDatums, TWorker>::waitWhileParked() const
+    {
+        try
+        {
+            // Blocking -> this is the only SubThread of its Thread, so it can sleep until it is woken up
+            if (mBlocking)
+            {
+                std::unique_lock<std::mutex> lock{spParking->mMutex};
+                spParking->mConditionVariable.wait(
+                    lock, [this]{ return spParking->mActive || spParking->mInputIsStopped; });
+            }
+            else
+                std::this_thread::sleep_for(std::chrono::microseconds{100});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    std::function<void()> SubThread<TDatums, TWorker>::getInputStopListener() const
+    {
+        try
+        {
+            const std::weak_ptr<Parking> parking{spParking};
+            return [parking]{
+                const auto spParking = parking.lock();
+                if (spParking != nullptr)
+                {
+                    {
+                        const std::lock_guard<std::mutex> lock{spParking->mMutex};
+                        spParking->mInputIsStopped = {true};
+                    }
+                    spParking->mConditionVariable.notify_all();
+                }
+            };
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
     template<typename TDatums, typename TWorker>
     void SubThread<TDatums, TWorker>::initializationOnThread()
     {
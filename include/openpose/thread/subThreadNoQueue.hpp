@@ -17,6 +17,8 @@ namespace op
 
         bool work();
 
+        bool isReady() const;
+
         DELETE_COPY(SubThreadNoQueue);
     };
 }
@@ -54,6 +56,20 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TWorker>
+    bool SubThreadNoQueue<TDatums, TWorker>::isReady() const
+    {
+        try
+        {
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
     COMPILE_TEMPLATE_DATUM(SubThreadNoQueue);
 }
 
@@ -18,6 +18,8 @@ namespace op
 
         bool work();
 
+        bool isReady() const;
+
     private:
         std::shared_ptr<TQueue> spTQueueIn;
 
@@ -39,6 +41,7 @@ namespace op
         spTQueueIn{tQueueIn}
     {
         // spTQueueIn->addPopper();
+        spTQueueIn->addStopListener(this->getInputStopListener());
     }
 
     template<typename TDatums, typename TWorker, typename TQueue>
@@ -51,11 +54,26 @@ namespace op
     {
         try
         {
+            // Parked replica (see ThreadManager::addElasticStage) -> leave the input to the active ones
+            if (this->isParked(spTQueueIn->isRunning()))
+            {
+                this->waitWhileParked();
+                return true;
+            }
             // Pop TDatums
-            if (spTQueueIn->empty())
-                std::this_thread::sleep_for(std::chrono::microseconds{100});
             TDatums tDatums;
-            bool queueIsRunning = spTQueueIn->tryPop(tDatums);
+            bool queueIsRunning;
+            // TWorkers with buffered output -> do not wait for new input
+            if (this->hasPendingOutput())
+                queueIsRunning = spTQueueIn->tryPop(tDatums);
+            else if (this->isBlocking())
+                queueIsRunning = spTQueueIn->waitAndPop(tDatums, nullptr);
+            else
+            {
+                if (spTQueueIn->empty())
+                    std::this_thread::sleep_for(std::chrono::microseconds{100});
+                queueIsRunning = spTQueueIn->tryPop(tDatums);
+            }
             // Check queue not empty
             if (!queueIsRunning)
                 queueIsRunning = spTQueueIn->isRunning();
@@ -74,6 +92,24 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TWorker, typename TQueue>
+    bool SubThreadQueueIn<TDatums, TWorker, TQueue>::isReady() const
+    {
+        try
+        {
+            // Parked replica
+            if (this->isParked(spTQueueIn->isRunning()))
+                return false;
+            // Input available, input closed (so the TWorkers can be stopped), or buffered output
+            return !spTQueueIn->empty() || !spTQueueIn->isRunning() || this->hasPendingOutput();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
     COMPILE_TEMPLATE_DATUM(SubThreadQueueIn);
 }
 
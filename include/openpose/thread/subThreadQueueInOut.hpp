@@ -19,6 +19,14 @@ namespace op
 
         bool work();
 
+        bool isReady() const;
+
+        /**
+         * Analogous to SubThread::setActive, but parked replicas do not count for the default maximum size of the
+         * output queue either (see QueueBase::setPusherActive).
+         */
+        void setActive(const bool active);
+
     private:
         std::shared_ptr<TQueue> spTQueueIn;
         std::shared_ptr<TQueue> spTQueueOut;
@@ -44,6 +52,15 @@ namespace op
     {
         // spTQueueIn->addPopper();
         spTQueueOut->addPusher();
+        spTQueueIn->addStopListener(this->getInputStopListener());
+        // Closing the output must wake up a blocking wait on the input, so the closing reaches the previous stages.
+        // Weak pointer, as the queues might outlive each other
+        const std::weak_ptr<TQueue> queueIn{spTQueueIn};
+        spTQueueOut->addStopListener([queueIn]{
+            const auto spTQueue = queueIn.lock();
+            if (spTQueue != nullptr)
+                spTQueue->wakeUp();
+        });
     }
 
     template<typename TDatums, typename TWorker, typename TQueue>
@@ -62,18 +79,37 @@ namespace op
                 spTQueueIn->stop();
                 return false;
             }
+            // Parked replica (see ThreadManager::addElasticStage) -> leave the input to the active ones
+            else if (this->isParked(spTQueueIn->isRunning()))
+            {
+                this->waitWhileParked();
+                return true;
+            }
             // If output queue running -> normal operation
             else
             {
                 // Don't work until next queue is not full
                 // This reduces latency to half
-                if (!spTQueueOut->isFull())
+                const auto outputHasRoom = (this->isBlocking()
+                    ? spTQueueOut->waitUntilNotFull() : spTQueueOut->hasRoom());
+                if (outputHasRoom)
                 {
                     // Pop TDatums
-                    if (spTQueueIn->empty())
-                        std::this_thread::sleep_for(std::chrono::microseconds{100});
                     TDatums tDatums;
-                    bool workersAreRunning = spTQueueIn->tryPop(tDatums);
+                    bool workersAreRunning;
+                    // TWorkers with buffered output -> do not wait for new input
+                    if (this->hasPendingOutput())
+                        workersAreRunning = spTQueueIn->tryPop(tDatums);
+                    // Blocking -> also woken up if the output is closed meanwhile (see constructor)
+                    else if (this->isBlocking())
+                        workersAreRunning = spTQueueIn->waitAndPop(
+                            tDatums, [this]{ return spTQueueOut->isPopStopped(); });
+                    else
+                    {
+                        if (spTQueueIn->empty())
+                            std::this_thread::sleep_for(std::chrono::microseconds{100});
+                        workersAreRunning = spTQueueIn->tryPop(tDatums);
+                    }
                     // Check queue not stopped
                     if (!workersAreRunning)
                         workersAreRunning = spTQueueIn->isRunning();
@@ -95,7 +131,8 @@ namespace op
                 }
                 else
                 {
-                    std::this_thread::sleep_for(std::chrono::microseconds{100});
+                    if (!this->isBlocking())
+                        std::this_thread::sleep_for(std::chrono::microseconds{100});
                     return true;
                 }
             }
@@ -109,6 +146,43 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TWorker, typename TQueue>
+    bool SubThreadQueueInOut<TDatums, TWorker, TQueue>::isReady() const
+    {
+        try
+        {
+            // Output closed -> ready to close the input
+            if (!spTQueueOut->isRunning())
+                return true;
+            // Parked replica
+            if (this->isParked(spTQueueIn->isRunning()))
+                return false;
+            // Room in the output, and input available, input closed or buffered output
+            return spTQueueOut->hasRoom()
+                && (!spTQueueIn->empty() || !spTQueueIn->isRunning() || this->hasPendingOutput());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void SubThreadQueueInOut<TDatums, TWorker, TQueue>::setActive(const bool active)
+    {
+        try
+        {
+            if (active != this->isActive())
+                spTQueueOut->setPusherActive(active);
+            SubThread<TDatums, TWorker>::setActive(active);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     COMPILE_TEMPLATE_DATUM(SubThreadQueueInOut);
 }
 
@@ -18,6 +18,8 @@ namespace op
 
         bool work();
 
+        bool isReady() const;
+
     private:
         std::shared_ptr<TQueue> spTQueueOut;
 
@@ -58,7 +60,9 @@ namespace op
             {
                 // Don't work until next queue is not full
                 // This reduces latency to half
-                if (!spTQueueOut->isFull())
+                const auto outputHasRoom = (this->isBlocking()
+                    ? spTQueueOut->waitUntilNotFull() : spTQueueOut->hasRoom());
+                if (outputHasRoom)
                 {
                     // Process TDatums
                     TDatums tDatums;
@@ -76,7 +80,8 @@ namespace op
                 }
                 else
                 {
-                    std::this_thread::sleep_for(std::chrono::microseconds{100});
+                    if (!this->isBlocking())
+                        std::this_thread::sleep_for(std::chrono::microseconds{100});
                     return true;
                 }
             }
@@ -89,6 +94,21 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TWorker, typename TQueue>
+    bool SubThreadQueueOut<TDatums, TWorker, TQueue>::isReady() const
+    {
+        try
+        {
+            // Room in the output queue or output closed
+            return spTQueueOut->hasRoom() || !spTQueueOut->isRunning();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
     COMPILE_TEMPLATE_DATUM(SubThreadQueueOut);
 }
 
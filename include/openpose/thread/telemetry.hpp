@@ -0,0 +1,160 @@
+#ifndef OPENPOSE_THREAD_TELEMETRY_HPP
+#define OPENPOSE_THREAD_TELEMETRY_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <typeinfo> // std::type_info
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Snapshot of the telemetry of a queue (see QueueTelemetry).
+     */
+    struct OP_API QueueStatistics
+    {
+        /**
+         * Number of bins of the wait histograms. Bin 0 counts the waits shorter than 1 microsecond, bin i (i > 0) the
+         * ones in [2^(i-1), 2^i) microseconds, and the last bin also counts all the longer ones (i.e., >= ~4 seconds).
+         */
+        static const unsigned int NUMBER_BINS = 24u;
+
+        unsigned long long numberPushed;
+        unsigned long long numberPopped;
+        unsigned long long numberDropped;
+        unsigned long long size;
+        /**
+         * Number of queued elements, averaged over time (i.e., weighted by how long the queue kept each size) since
+         * the queue was created.
+         */
+        double averageOccupancy;
+        double elapsedSeconds;
+        /**
+         * Total time spent blocked waiting for room to push (full queue) or for an element to pop (empty queue).
+         */
+        double pushWaitMs;
+        double popWaitMs;
+        std::array<unsigned long long, NUMBER_BINS> pushWaitHistogram;
+        std::array<unsigned long long, NUMBER_BINS> popWaitHistogram;
+
+        QueueStatistics();
+
+        /**
+         * Single-line summary, e.g., for opLog.
+         */
+        std::string toString() const;
+    };
+
+    /**
+     * Snapshot of the service time of a TWorker (see WorkerTelemetry), i.e., how long each call to its work() takes.
+     */
+    struct OP_API WorkerStatistics
+    {
+        unsigned long long threadId;
+        std::string name;
+        unsigned long long numberCalls;
+        double averageMs;
+        double maxMs;
+
+        WorkerStatistics();
+
+        std::string toString() const;
+    };
+
+    /**
+     * Snapshot returned by ThreadManager::getStatistics(). The queues are sorted in pipeline order, and the workers
+     * by thread id.
+     */
+    struct OP_API ThreadManagerStatistics
+    {
+        std::vector<QueueStatistics> queues;
+        std::vector<WorkerStatistics> workers;
+
+        std::string toString() const;
+    };
+
+    /**
+     * Counters recorded by each queue (see QueueBase and RingBufferQueue): number of pushed and popped elements,
+     * time-averaged occupancy and histograms of the time blocked on a full (push) or empty (pop) queue.
+     * They only use relaxed atomics (no locks), so they are always enabled. Any function can be called from any
+     * thread. Concurrent updates might slightly misattribute the occupancy of overlapping intervals, but never lose
+     * time nor elements.
+     */
+    class OP_API QueueTelemetry
+    {
+    public:
+        QueueTelemetry();
+
+        virtual ~QueueTelemetry();
+
+        /**
+         * @param size Number of elements in the queue right after the push or pop.
+         */
+        void recordPush(const unsigned long long size);
+
+        void recordPop(const unsigned long long size);
+
+        /**
+         * It updates the occupancy without counting a push or pop (e.g., dropped or cleared elements).
+         */
+        void recordSize(const unsigned long long size);
+
+        void recordPushWait(const std::chrono::nanoseconds& wait);
+
+        void recordPopWait(const std::chrono::nanoseconds& wait);
+
+        /**
+         * numberDropped is kept by the queue itself (see QueueBase::getNumberDropped), so it is left as 0.
+         */
+        QueueStatistics getStatistics() const;
+
+    private:
+        const std::chrono::steady_clock::time_point mStart;
+        std::atomic<unsigned long long> mNumberPushed;
+        std::atomic<unsigned long long> mNumberPopped;
+        // Occupancy (integral of the size over time, in elements * nanoseconds)
+        std::atomic<unsigned long long> mLastChangeNs;
+        std::atomic<unsigned long long> mLastSize;
+        std::atomic<unsigned long long> mOccupancyIntegral;
+        // Waits
+        std::atomic<unsigned long long> mPushWaitNs;
+        std::atomic<unsigned long long> mPopWaitNs;
+        std::array<std::atomic<unsigned long long>, QueueStatistics::NUMBER_BINS> mPushWaitHistogram;
+        std::array<std::atomic<unsigned long long>, QueueStatistics::NUMBER_BINS> mPopWaitHistogram;
+
+        unsigned long long getElapsedNs() const;
+
+        DELETE_COPY(QueueTelemetry);
+    };
+
+    /**
+     * Service time of a TWorker, recorded by its SubThread around each checkAndWork() call that consumed or produced
+     * an element. Single writer (the thread running the SubThread), any number of readers.
+     */
+    class OP_API WorkerTelemetry
+    {
+    public:
+        /**
+         * @param typeInfo Dynamic type of the TWorker, used as its name (demangled and without template arguments
+         * when possible).
+         */
+        explicit WorkerTelemetry(const std::type_info& typeInfo);
+
+        virtual ~WorkerTelemetry();
+
+        void record(const std::chrono::nanoseconds& serviceTime);
+
+        WorkerStatistics getStatistics() const;
+
+    private:
+        const std::string mName;
+        std::atomic<unsigned long long> mNumberCalls;
+        std::atomic<unsigned long long> mTotalNs;
+        std::atomic<unsigned long long> mMaxNs;
+
+        DELETE_COPY(WorkerTelemetry);
+    };
+}
+
+#endif // OPENPOSE_THREAD_TELEMETRY_HPP
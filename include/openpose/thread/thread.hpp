@@ -3,6 +3,7 @@
 
 #include <atomic>
 #include <openpose/core/common.hpp>
+#include <openpose/thread/cpuAffinity.hpp>
 #include <openpose/thread/subThread.hpp>
 #include <openpose/thread/worker.hpp>
 
@@ -27,12 +28,43 @@ namespace op
 
         void add(const std::shared_ptr<SubThread<TDatums, TWorker>>& subThread);
 
+        /**
+         * It enables/disables the blocking (condition variable based) mode of its SubThread. It is only applied if
+         * this Thread contains a single SubThread, otherwise they keep polling so none of them can stall the others.
+         */
+        void setBlocking(const bool blocking);
+
+        /**
+         * CPUs its std::thread is pinned to (see setThreadCpus) before initializing its SubThreads, so the buffers
+         * they allocate stay on the local NUMA node. exec() pins the calling thread and restores its affinity when
+         * done. It does not apply to workInPool(), since the pool threads run any Thread. Empty (default) to not pin
+         * it.
+         */
+        void setCpus(const std::vector<int>& cpus);
+
         void exec(const std::shared_ptr<std::atomic<bool>>& isRunningSharedPtr);
 
         void startInThread();
 
         void stopAndJoin();
 
+        /**
+         * Used by the WorkStealing ThreadManagerBackend, which runs this Thread as a task of a thread pool rather
+         * than on its own std::thread. startInPool() marks it as running, isReady() tells whether any of its
+         * SubThreads can make progress, and workInPool() runs a single iteration of the threadFunction() loop (after
+         * initializing the SubThreads on the first call). workInPool() must not be called concurrently.
+         */
+        void startInPool();
+
+        bool isReady() const;
+
+        bool workInPool();
+
+        /**
+         * Service time of the TWorkers of all its SubThreads (see SubThread::getWorkerStatistics).
+         */
+        std::vector<WorkerStatistics> getWorkerStatistics() const;
+
         inline bool isRunning() const
         {
             return *spIsRunning;
@@ -42,6 +74,8 @@ namespace op
         std::shared_ptr<std::atomic<bool>> spIsRunning;
         std::vector<std::shared_ptr<SubThread<TDatums, TWorker>>> mSubThreads;
         std::thread mThread;
+        bool mInitializedInPool;
+        std::vector<int> mCpus;
 
         void initializationOnThread();
 
@@ -64,16 +98,19 @@ namespace op
 {
     template<typename TDatums, typename TWorker>
     Thread<TDatums, TWorker>::Thread(const std::shared_ptr<std::atomic<bool>>& isRunningSharedPtr) :
-        spIsRunning{(isRunningSharedPtr != nullptr ? isRunningSharedPtr : std::make_shared<std::atomic<bool>>(false))}
+        spIsRunning{(isRunningSharedPtr != nullptr ? isRunningSharedPtr : std::make_shared<std::atomic<bool>>(false))},
+        mInitializedInPool{false}
     {
     }
 
     template<typename TDatums, typename TWorker>
     Thread<TDatums, TWorker>::Thread(Thread<TDatums, TWorker>&& t) :
-        spIsRunning{std::make_shared<std::atomic<bool>>(t.spIsRunning->load())}
+        spIsRunning{std::make_shared<std::atomic<bool>>(t.spIsRunning->load())},
+        mInitializedInPool{t.mInitializedInPool}
     {
         std::swap(mSubThreads, t.mSubThreads);
         std::swap(mThread, t.mThread);
+        std::swap(mCpus, t.mCpus);
     }
 
     template<typename TDatums, typename TWorker>
@@ -81,7 +118,9 @@ namespace op
     {
         std::swap(mSubThreads, t.mSubThreads);
         std::swap(mThread, t.mThread);
+        std::swap(mCpus, t.mCpus);
         spIsRunning = {std::make_shared<std::atomic<bool>>(t.spIsRunning->load())};
+        mInitializedInPool = {t.mInitializedInPool};
         return *this;
     }
 
@@ -113,6 +152,34 @@ namespace op
         add(std::vector<std::shared_ptr<SubThread<TDatums, TWorker>>>{subThread});
     }
 
+    template<typename TDatums, typename TWorker>
+    void Thread<TDatums, TWorker>::setBlocking(const bool blocking)
+    {
+        try
+        {
+            const auto singleSubThread = (mSubThreads.size() == 1);
+            for (auto& subThread : mSubThreads)
+                subThread->setBlocking(blocking && singleSubThread);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void Thread<TDatums, TWorker>::setCpus(const std::vector<int>& cpus)
+    {
+        try
+        {
+            mCpus = cpus;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename TDatums, typename TWorker>
     void Thread<TDatums, TWorker>::exec(const std::shared_ptr<std::atomic<bool>>& isRunningSharedPtr)
     {
@@ -121,7 +188,10 @@ namespace op
             stopAndJoin();
             spIsRunning = isRunningSharedPtr;
             *spIsRunning = true;
+            // Calling thread -> restore its affinity afterwards
+            const auto previousCpus = (mCpus.empty() ? std::vector<int>{} : getThreadCpus());
             threadFunction();
+            setThreadCpus(previousCpus);
         }
         catch (const std::exception& e)
         {
@@ -159,6 +229,95 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TWorker>
+    void Thread<TDatums, TWorker>::startInPool()
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            stopAndJoin();
+            mInitializedInPool = false;
+            *spIsRunning = true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    bool Thread<TDatums, TWorker>::isReady() const
+    {
+        try
+        {
+            // Not initialized yet -> the initialization is the pending work
+            if (!mInitializedInPool)
+                return true;
+            for (const auto& subThread : mSubThreads)
+                if (subThread->isReady())
+                    return true;
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    std::vector<WorkerStatistics> Thread<TDatums, TWorker>::getWorkerStatistics() const
+    {
+        try
+        {
+            std::vector<WorkerStatistics> workerStatistics;
+            for (const auto& subThread : mSubThreads)
+            {
+                const auto subThreadStatistics = subThread->getWorkerStatistics();
+                workerStatistics.insert(
+                    workerStatistics.end(), subThreadStatistics.begin(), subThreadStatistics.end());
+            }
+            return workerStatistics;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    bool Thread<TDatums, TWorker>::workInPool()
+    {
+        try
+        {
+            if (!mInitializedInPool)
+            {
+                initializationOnThread();
+                mInitializedInPool = true;
+            }
+            else if (isRunning())
+            {
+                // Same as 1 iteration of threadFunction()
+                bool allSubThreadsClosed = true;
+                for (auto& subThread : mSubThreads)
+                    allSubThreadsClosed &= !subThread->work();
+
+                if (allSubThreadsClosed)
+                {
+                    opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                    stop();
+                }
+            }
+            return isRunning();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     template<typename TDatums, typename TWorker>
     void Thread<TDatums, TWorker>::initializationOnThread()
     {
@@ -180,6 +339,8 @@ namespace op
         try
         {
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            // Pinned before initializing, so the memory it allocates is local
+            setThreadCpus(mCpus);
             initializationOnThread();
 
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
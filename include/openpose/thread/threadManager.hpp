@@ -2,13 +2,19 @@
 #define OPENPOSE_THREAD_THREAD_MANAGER_HPP
 
 #include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
 #include <set> // std::multiset
+#include <thread>
 #include <tuple>
 #include <openpose/core/common.hpp>
 #include <openpose/thread/enumClasses.hpp>
 #include <openpose/thread/queue.hpp>
+#include <openpose/thread/telemetry.hpp>
 #include <openpose/thread/thread.hpp>
 #include <openpose/thread/worker.hpp>
+#include <openpose/thread/workStealingScheduler.hpp>
 
 namespace op
 {
@@ -32,6 +38,100 @@ namespace op
          */
         void setDefaultMaxSizeQueues(const long long defaultMaxSizeQueues = -1);
 
+        /**
+         * It selects how the SubThreads wait for their queues.
+         * If true (default), threads sleep on the queue condition variables and are woken up as soon as an element
+         * arrives, room frees up or the queue is stopped, removing the polling latency and idle CPU usage.
+         * If false, they poll the queues every 100 microseconds (previous behavior).
+         * Threads that host several SubThreads (e.g., if multi-threading is disabled) always poll.
+         * It must be called before exec() or start().
+         * @param blocking bool indicating whether to use the blocking mode.
+         */
+        void setBlocking(const bool blocking = true);
+
+        /**
+         * It selects how the thread ids are run (see ThreadManagerBackend). It must be called before exec() or
+         * start().
+         * @param backend ThreadManagerBackend to use (default: ThreadManagerBackend::Threads).
+         * @param numberPoolThreads Number of pool threads for ThreadManagerBackend::WorkStealing. If <= 0, one per
+         * logical core.
+         */
+        void setBackend(const ThreadManagerBackend backend, const int numberPoolThreads = -1);
+
+        /**
+         * It makes threadId run on its own std::thread even with ThreadManagerBackend::WorkStealing. Required for
+         * TWorkers that must always run on the same thread (e.g., thread-local GPU contexts or GUI event loops).
+         * Like add(), it is cleared by reset().
+         */
+        void addDedicatedThread(const unsigned long long threadId);
+
+        /**
+         * It selects what pushing into a full queue does for all the queues (see QueueFullPolicy). With
+         * QueueFullPolicy::OverwriteOldest (latest-frame-wins), the stale elements are dropped at every stage
+         * boundary when the next stage is slower, and no stage (nor waitAndEmplace/waitAndPush) ever blocks on a full
+         * queue. It must be called before exec() or start().
+         * @param queueFullPolicy QueueFullPolicy to use (default: QueueFullPolicy::Block).
+         */
+        void setQueueFullPolicy(const QueueFullPolicy queueFullPolicy);
+
+        inline QueueFullPolicy getQueueFullPolicy() const
+        {
+            return mQueueFullPolicy;
+        }
+
+        /**
+         * Number of elements dropped by each queue (see setQueueFullPolicy), in pipeline order (i.e., the element i
+         * is the number of elements that the stage(s) popping from the i-th queue never received). Empty before
+         * exec() or start().
+         */
+        std::vector<unsigned long long> getNumberDropped() const;
+
+        /**
+         * Snapshot of the telemetry of all the queues (push/pop counts, time-averaged occupancy and histograms of the
+         * time blocked on a full or empty queue, see QueueTelemetry) and the service time of each TWorker. The
+         * counters are always recorded (they only use atomics), so it can be called at any time while running, from
+         * any thread, or after stopping (until reset()). Empty before exec() or start().
+         */
+        ThreadManagerStatistics getStatistics() const;
+
+        /**
+         * If > 0, getStatistics() is logged (Priority::High) every statisticsLogPeriod seconds while running, and once
+         * more when stopping. It must be called before exec() or start().
+         * @param statisticsLogPeriod Period in seconds (default: -1, i.e., disabled).
+         */
+        void setStatisticsLogPeriod(const double statisticsLogPeriod = -1.);
+
+        /**
+         * It makes the stage that pops from queueInId elastic. All the thread ids added with that queueInId (and the
+         * same queueOutId) are replicas of that stage, but only some of them (the active ones) pop from the queue,
+         * while the others stay parked (see SubThread::setActive). Every elastic period (see setElasticPeriod), one
+         * more replica is activated if the active ones were busy most of the time while their input queue stayed
+         * saturated, and one is parked if the others could absorb its load. The replicas finish out of order, so the
+         * next stage must sort them (e.g., WQueueOrderer).
+         * It only makes sense for stateless, CPU-bound TWorkers (e.g., 3-D triangulation or CPU rendering), since
+         * every replica keeps its TWorker instances. Like add(), it is cleared by reset().
+         * @param queueInId Input queue id of the stage (as given to add()).
+         * @param minimumActive Number of replicas that are never parked (at least 1). The stage starts with them.
+         */
+        void addElasticStage(const unsigned long long queueInId, const unsigned int minimumActive = 1u);
+
+        /**
+         * Time (in seconds) between the adjustments of the elastic stages (see addElasticStage). It must be called
+         * before exec() or start().
+         * @param elasticPeriod Period in seconds (default: 0.5).
+         */
+        void setElasticPeriod(const double elasticPeriod = 0.5);
+
+        /**
+         * It pins the given thread to a set of CPUs (e.g., the ones of a NUMA node, see getNumaNodeCpus), so it does
+         * not migrate across sockets and the large buffers its TWorkers allocate stay on the local node (see
+         * Thread::setCpus). Ids of threads that do not exist (or run on the WorkStealing pool) are ignored. Like add(),
+         * it is cleared by reset().
+         * @param threadId Thread id (as given to add()).
+         * @param cpus Logical CPU ids. Empty to not pin it.
+         */
+        void setThreadCpus(const unsigned long long threadId, const std::vector<int>& cpus);
+
         void add(const unsigned long long threadId, const std::vector<TWorker>& tWorkers,
                  const unsigned long long queueInId, const unsigned long long queueOutId);
 
@@ -72,9 +172,39 @@ namespace op
         const ThreadManagerMode mThreadManagerMode;
         std::shared_ptr<std::atomic<bool>> spIsRunning;
         long long mDefaultMaxSizeQueues;
+        bool mBlocking;
+        ThreadManagerBackend mBackend;
+        int mNumberPoolThreads;
+        QueueFullPolicy mQueueFullPolicy;
+        std::set<unsigned long long> mDedicatedThreadIds;
         std::multiset<std::tuple<unsigned long long, std::vector<TWorker>, unsigned long long, unsigned long long>> mThreadWorkerQueues;
+        // Before mThreads, so it is destroyed after them
+        std::shared_ptr<WorkStealingScheduler<TDatums, TWorker>> spScheduler;
         std::vector<std::shared_ptr<Thread<TDatums, TWorker>>> mThreads;
         std::vector<std::shared_ptr<TQueue>> mTQueues;
+        // Monitor thread (periodic statistics log and elastic stages)
+        double mStatisticsLogPeriod;
+        std::thread mMonitorThread;
+        std::mutex mMonitorMutex;
+        std::condition_variable mMonitorConditionVariable;
+        bool mMonitorThreadStop;
+        // Elastic stages
+        struct ElasticStage
+        {
+            std::shared_ptr<TQueue> spTQueueIn;
+            std::vector<std::shared_ptr<SubThread<TDatums, TWorker>>> replicas;
+            unsigned int minimumActive;
+            unsigned int numberActive;
+            // Totals at the previous adjustment
+            double seconds;
+            double busyMs;
+            double occupancySeconds;
+            double pushWaitMs;
+        };
+        std::map<unsigned long long, std::vector<int>> mThreadCpus;
+        std::map<unsigned long long, unsigned int> mElasticStageIds;
+        double mElasticPeriod;
+        std::vector<ElasticStage> mElasticStages;
 
         void add(const std::vector<std::tuple<unsigned long long, std::vector<TWorker>, unsigned long long, unsigned long long>>& threadWorkerQueues);
 
@@ -82,10 +212,22 @@ namespace op
 
         void multisetToThreads();
 
+        bool isPooled(const unsigned long long threadId) const;
+
+        void startThreadsAndScheduler(const bool execInThisThread);
+
         void checkAndCreateEmptyThreads();
 
         void checkAndCreateQueues();
 
+        void startMonitor();
+
+        void stopMonitor();
+
+        void monitorFunction();
+
+        void adjustElasticStages();
+
         DELETE_COPY(ThreadManager);
     };
 }
@@ -108,13 +250,28 @@ namespace op
     ThreadManager<TDatums, TWorker, TQueue>::ThreadManager(const ThreadManagerMode threadManagerMode) :
         mThreadManagerMode{threadManagerMode},
         spIsRunning{std::make_shared<std::atomic<bool>>(false)},
-        mDefaultMaxSizeQueues{-1ll}
+        mDefaultMaxSizeQueues{-1ll},
+        mBlocking{true},
+        mBackend{ThreadManagerBackend::Threads},
+        mNumberPoolThreads{-1},
+        mQueueFullPolicy{QueueFullPolicy::Block},
+        mStatisticsLogPeriod{-1.},
+        mMonitorThreadStop{false},
+        mElasticPeriod{0.5}
     {
     }
 
     template<typename TDatums, typename TWorker, typename TQueue>
     ThreadManager<TDatums, TWorker, TQueue>::~ThreadManager()
     {
+        try
+        {
+            stopMonitor();
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     template<typename TDatums, typename TWorker, typename TQueue>
@@ -130,6 +287,156 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::setBlocking(const bool blocking)
+    {
+        try
+        {
+            mBlocking = {blocking};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::setBackend(
+        const ThreadManagerBackend backend, const int numberPoolThreads)
+    {
+        try
+        {
+            mBackend = {backend};
+            mNumberPoolThreads = {numberPoolThreads};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::addDedicatedThread(const unsigned long long threadId)
+    {
+        try
+        {
+            mDedicatedThreadIds.emplace(threadId);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::setQueueFullPolicy(const QueueFullPolicy queueFullPolicy)
+    {
+        try
+        {
+            mQueueFullPolicy = {queueFullPolicy};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    std::vector<unsigned long long> ThreadManager<TDatums, TWorker, TQueue>::getNumberDropped() const
+    {
+        try
+        {
+            std::vector<unsigned long long> numberDropped;
+            for (const auto& tQueue : mTQueues)
+                numberDropped.emplace_back(tQueue->getNumberDropped());
+            return numberDropped;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    ThreadManagerStatistics ThreadManager<TDatums, TWorker, TQueue>::getStatistics() const
+    {
+        try
+        {
+            ThreadManagerStatistics threadManagerStatistics;
+            for (const auto& tQueue : mTQueues)
+                threadManagerStatistics.queues.emplace_back(tQueue->getStatistics());
+            for (auto threadId = 0ull ; threadId < mThreads.size() ; threadId++)
+            {
+                for (auto& workerStatistics : mThreads[threadId]->getWorkerStatistics())
+                {
+                    workerStatistics.threadId = threadId;
+                    threadManagerStatistics.workers.emplace_back(workerStatistics);
+                }
+            }
+            return threadManagerStatistics;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return ThreadManagerStatistics{};
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::setStatisticsLogPeriod(const double statisticsLogPeriod)
+    {
+        try
+        {
+            mStatisticsLogPeriod = {statisticsLogPeriod};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::addElasticStage(
+        const unsigned long long queueInId, const unsigned int minimumActive)
+    {
+        try
+        {
+            mElasticStageIds[queueInId] = fastMax(1u, minimumActive);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::setElasticPeriod(const double elasticPeriod)
+    {
+        try
+        {
+            mElasticPeriod = {elasticPeriod};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::setThreadCpus(
+        const unsigned long long threadId, const std::vector<int>& cpus)
+    {
+        try
+        {
+            mThreadCpus[threadId] = cpus;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename TDatums, typename TWorker, typename TQueue>
     void ThreadManager<TDatums, TWorker, TQueue>::add(const unsigned long long threadId,
                                                       const std::vector<TWorker>& tWorkers,
@@ -167,7 +474,13 @@ namespace op
     {
         try
         {
+            stopMonitor();
             mThreadWorkerQueues.clear();
+            mDedicatedThreadIds.clear();
+            mThreadCpus.clear();
+            mElasticStageIds.clear();
+            mElasticStages.clear();
+            spScheduler.reset();
             mThreads.clear();
             mTQueues.clear();
         }
@@ -185,7 +498,15 @@ namespace op
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             // Set threads
             multisetToThreads();
-            if (!mThreads.empty())
+            startMonitor();
+            if (spScheduler != nullptr)
+            {
+                opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Start threads: the calling thread runs the last thread (if dedicated) or becomes a pool thread
+                startThreadsAndScheduler(true);
+                stop();
+            }
+            else if (!mThreads.empty())
             {
                 opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Start threads
@@ -211,9 +532,13 @@ namespace op
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             // Set threads
             multisetToThreads();
+            startMonitor();
             // Start threads
-            for (auto& thread : mThreads)
-                thread->startInThread();
+            if (spScheduler != nullptr)
+                startThreadsAndScheduler(false);
+            else
+                for (auto& thread : mThreads)
+                    thread->startInThread();
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
         }
         catch (const std::exception& e)
@@ -232,9 +557,20 @@ namespace op
                 tQueue->stop();
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             *spIsRunning = false;
+            if (spScheduler != nullptr)
+                spScheduler->stopAndJoin();
             for (auto& thread : mThreads)
                 thread->stopAndJoin();
+            stopMonitor();
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            // Latest-frame-wins -> report the frames dropped at each stage boundary
+            if (mQueueFullPolicy == QueueFullPolicy::OverwriteOldest && !mTQueues.empty())
+            {
+                std::string message = "Dropped elements per queue (latest-frame-wins):";
+                for (const auto numberDropped : getNumberDropped())
+                    message += " " + std::to_string(numberDropped);
+                opLog(message + ".", Priority::High);
+            }
             checkWorkerErrors();
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
         }
@@ -409,14 +745,28 @@ namespace op
 
                 // Data
                 const auto maxQueueIdSynchronous = mTQueues.size()+1;
+                // Threads that pop from/push into each queue (first and last ids are not queues unless asynchronous)
+                const auto asynchronousIn = (mThreadManagerMode == ThreadManagerMode::Asynchronous
+                                             || mThreadManagerMode == ThreadManagerMode::AsynchronousIn);
+                const auto asynchronousOut = (mThreadManagerMode == ThreadManagerMode::Asynchronous
+                                              || mThreadManagerMode == ThreadManagerMode::AsynchronousOut);
+                const auto queueIdOffset = (asynchronousIn ? 0ull : 1ull);
+                std::vector<std::set<unsigned long long>> queuePoppers(mTQueues.size());
+                std::vector<std::set<unsigned long long>> queuePushers(mTQueues.size());
+                std::map<unsigned long long, std::vector<std::shared_ptr<SubThread<TDatums, TWorker>>>> replicas;
 
                 // Set up threads
                 for (const auto& threadWorkerQueue : mThreadWorkerQueues)
                 {
-                    auto& thread = mThreads[std::get<0>(threadWorkerQueue)];
+                    const auto threadId = std::get<0>(threadWorkerQueue);
+                    auto& thread = mThreads[threadId];
                     const auto& tWorkers = std::get<1>(threadWorkerQueue);
                     const auto queueIn = std::get<2>(threadWorkerQueue);
                     const auto queueOut = std::get<3>(threadWorkerQueue);
+                    if (queueIn >= queueIdOffset && queueIn - queueIdOffset < mTQueues.size())
+                        queuePoppers[queueIn - queueIdOffset].emplace(threadId);
+                    if (queueOut >= queueIdOffset && queueOut - queueIdOffset < mTQueues.size())
+                        queuePushers[queueOut - queueIdOffset].emplace(threadId);
                     std::shared_ptr<SubThread<TDatums, TWorker>> subThread;
                     // If AsynchronousIn -> queue indexes are OK
                     if (mThreadManagerMode == ThreadManagerMode::Asynchronous
@@ -451,6 +801,81 @@ namespace op
                     else // if (queueIn == 0 && queueOut == maxQueueIdSynchronous)
                         subThread = {std::make_shared<SubThreadNoQueue<TDatums, TWorker>>(tWorkers)};
                     thread->add(subThread);
+                    if (mElasticStageIds.count(queueIn) > 0)
+                        replicas[queueIn].emplace_back(subThread);
+                }
+
+                // Elastic stages: only their minimum number of replicas starts active
+                mElasticStages.clear();
+                for (const auto& elasticStageId : mElasticStageIds)
+                {
+                    const auto queueIn = elasticStageId.first;
+                    if (queueIn < queueIdOffset || queueIn - queueIdOffset >= mTQueues.size())
+                        error("Elastic stage with queue in id " + std::to_string(queueIn) + " does not pop from a"
+                              " queue.", __LINE__, __FUNCTION__, __FILE__);
+                    ElasticStage elasticStage;
+                    elasticStage.spTQueueIn = mTQueues[queueIn - queueIdOffset];
+                    elasticStage.replicas = replicas[queueIn];
+                    elasticStage.minimumActive = fastMin(
+                        elasticStageId.second, (unsigned int)elasticStage.replicas.size());
+                    elasticStage.numberActive = elasticStage.minimumActive;
+                    elasticStage.seconds = 0.;
+                    elasticStage.busyMs = 0.;
+                    elasticStage.occupancySeconds = 0.;
+                    elasticStage.pushWaitMs = 0.;
+                    for (auto i = 0u ; i < elasticStage.replicas.size() ; i++)
+                        elasticStage.replicas[i]->setActive(i < elasticStage.numberActive);
+                    // Nothing to adjust if all of them must be active
+                    if (elasticStage.minimumActive < elasticStage.replicas.size())
+                        mElasticStages.emplace_back(elasticStage);
+                }
+
+                // Let each queue know whether it has a single producer and consumer thread (e.g., so RingBufferQueue
+                // can use a SPSC buffer). The user can push into the first and pop from the last queue from any thread
+                for (auto i = 0u ; i < mTQueues.size() ; i++)
+                    mTQueues[i]->setEndpoints(
+                        queuePushers[i].size() == 1 && !(asynchronousIn && i == 0),
+                        queuePoppers[i].size() == 1 && !(asynchronousOut && i+1 == mTQueues.size()));
+
+                // Blocking or polling SubThreads (once all of them have been assigned to their threads)
+                for (auto& thread : mThreads)
+                    thread->setBlocking(mBlocking);
+
+                // CPU placement
+                for (auto threadId = 0ull ; threadId < mThreads.size() ; threadId++)
+                {
+                    const auto threadCpus = mThreadCpus.find(threadId);
+                    mThreads[threadId]->setCpus(
+                        threadCpus != mThreadCpus.end() ? threadCpus->second : std::vector<int>{});
+                }
+
+                // Work-stealing backend: non-dedicated threads become tasks of the pool, which is woken up by any
+                // queue change. They must not block inside work(), so they are non-blocking
+                spScheduler.reset();
+                if (mBackend == ThreadManagerBackend::WorkStealing)
+                {
+                    for (auto i = 0ull ; i < mThreads.size() ; i++)
+                    {
+                        if (isPooled(i))
+                        {
+                            if (spScheduler == nullptr)
+                                spScheduler = std::make_shared<WorkStealingScheduler<TDatums, TWorker>>(
+                                    spIsRunning, mNumberPoolThreads);
+                            mThreads[i]->setBlocking(false);
+                            spScheduler->add(mThreads[i]);
+                        }
+                    }
+                    if (spScheduler != nullptr)
+                    {
+                        // Weak pointer, as the queues might outlive the scheduler
+                        const std::weak_ptr<WorkStealingScheduler<TDatums, TWorker>> scheduler{spScheduler};
+                        for (auto& tQueue : mTQueues)
+                            tQueue->setNotifier([scheduler]{
+                                const auto spScheduler = scheduler.lock();
+                                if (spScheduler != nullptr)
+                                    spScheduler->notify();
+                            });
+                    }
                 }
             }
             else
@@ -462,6 +887,53 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TWorker, typename TQueue>
+    bool ThreadManager<TDatums, TWorker, TQueue>::isPooled(const unsigned long long threadId) const
+    {
+        try
+        {
+            return mBackend == ThreadManagerBackend::WorkStealing
+                && mDedicatedThreadIds.find(threadId) == mDedicatedThreadIds.end();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::startThreadsAndScheduler(const bool execInThisThread)
+    {
+        try
+        {
+            // Running before starting the pool, otherwise it would see spIsRunning = false and finish right away
+            *spIsRunning = true;
+            const auto lastThreadId = mThreads.size() - 1;
+            const auto lastThreadIsDedicated = !isPooled(lastThreadId);
+            for (auto i = 0ull ; i < mThreads.size() ; i++)
+            {
+                if (isPooled(i))
+                    mThreads[i]->startInPool();
+                else if (!execInThisThread || i != lastThreadId)
+                    mThreads[i]->startInThread();
+            }
+            if (!execInThisThread)
+                spScheduler->start();
+            else if (lastThreadIsDedicated)
+            {
+                spScheduler->start();
+                mThreads[lastThreadId]->exec(spIsRunning);
+            }
+            else
+                spScheduler->exec();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename TDatums, typename TWorker, typename TQueue>
     void ThreadManager<TDatums, TWorker, TQueue>::checkAndCreateEmptyThreads()
     {
@@ -539,7 +1011,137 @@ namespace op
                 else
                     error("Unknown ThreadManagerMode", __LINE__, __FUNCTION__, __FILE__);
                 for (auto& tQueue : mTQueues)
+                {
                     tQueue = std::make_shared<TQueue>(mDefaultMaxSizeQueues);
+                    tQueue->setFullPolicy(mQueueFullPolicy);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::startMonitor()
+    {
+        try
+        {
+            stopMonitor();
+            if (mStatisticsLogPeriod > 0. || (!mElasticStages.empty() && mElasticPeriod > 0.))
+            {
+                mMonitorThreadStop = false;
+                mMonitorThread = std::thread{&ThreadManager<TDatums, TWorker, TQueue>::monitorFunction, this};
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::stopMonitor()
+    {
+        try
+        {
+            if (mMonitorThread.joinable())
+            {
+                {
+                    const std::lock_guard<std::mutex> lock{mMonitorMutex};
+                    mMonitorThreadStop = true;
+                }
+                mMonitorConditionVariable.notify_all();
+                mMonitorThread.join();
+                // Final values
+                if (mStatisticsLogPeriod > 0.)
+                    opLog(getStatistics().toString(), Priority::High);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::monitorFunction()
+    {
+        try
+        {
+            // Wake up at the shortest period, and log only once the statistics one has elapsed
+            const auto logStatistics = (mStatisticsLogPeriod > 0.);
+            const auto elastic = (!mElasticStages.empty() && mElasticPeriod > 0.);
+            const auto period = std::chrono::duration<double>{
+                (elastic && logStatistics ? fastMin(mElasticPeriod, mStatisticsLogPeriod)
+                    : (elastic ? mElasticPeriod : mStatisticsLogPeriod))};
+            const auto statisticsLogPeriod = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>{fastMax(0., mStatisticsLogPeriod)});
+            auto nextLog = std::chrono::steady_clock::now() + statisticsLogPeriod;
+            std::unique_lock<std::mutex> lock{mMonitorMutex};
+            const auto isStopped = [this]{ return mMonitorThreadStop; };
+            while (!mMonitorConditionVariable.wait_for(lock, period, isStopped))
+            {
+                if (elastic)
+                    adjustElasticStages();
+                if (logStatistics && std::chrono::steady_clock::now() >= nextLog)
+                {
+                    opLog(getStatistics().toString(), Priority::High);
+                    nextLog += statisticsLogPeriod;
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::adjustElasticStages()
+    {
+        try
+        {
+            for (auto& elasticStage : mElasticStages)
+            {
+                // Totals since the start
+                const auto queueStatistics = elasticStage.spTQueueIn->getStatistics();
+                auto busyMs = 0.;
+                for (const auto& replica : elasticStage.replicas)
+                    for (const auto& workerStatistics : replica->getWorkerStatistics())
+                        busyMs += workerStatistics.averageMs * workerStatistics.numberCalls;
+                const auto occupancySeconds = queueStatistics.averageOccupancy * queueStatistics.elapsedSeconds;
+                // Averages over the last period
+                const auto periodMs = 1e3 * (queueStatistics.elapsedSeconds - elasticStage.seconds);
+                if (periodMs <= 0.)
+                    continue;
+                const auto periodBusyMs = busyMs - elasticStage.busyMs;
+                const auto utilization = periodBusyMs / (periodMs * elasticStage.numberActive);
+                const auto occupancy = 1e3 * (occupancySeconds - elasticStage.occupancySeconds) / periodMs;
+                const auto pushWaitRatio = (queueStatistics.pushWaitMs - elasticStage.pushWaitMs) / periodMs;
+                elasticStage.seconds = queueStatistics.elapsedSeconds;
+                elasticStage.busyMs = busyMs;
+                elasticStage.occupancySeconds = occupancySeconds;
+                elasticStage.pushWaitMs = queueStatistics.pushWaitMs;
+                // Saturated (replicas almost always busy while the input queue stays full or blocks the previous
+                // stage) -> 1 more replica
+                const auto previousNumberActive = elasticStage.numberActive;
+                if (elasticStage.numberActive < elasticStage.replicas.size()
+                    && utilization > 0.8 && (occupancy >= 0.5 || pushWaitRatio > 0.1))
+                    elasticStage.numberActive++;
+                // Idle (the remaining replicas would still be busy less than 60% of the time) -> 1 less replica
+                else if (elasticStage.numberActive > elasticStage.minimumActive
+                         && periodBusyMs < 0.6 * periodMs * (elasticStage.numberActive - 1))
+                    elasticStage.numberActive--;
+                if (elasticStage.numberActive != previousNumberActive)
+                {
+                    for (auto i = 0u ; i < elasticStage.replicas.size() ; i++)
+                        elasticStage.replicas[i]->setActive(i < elasticStage.numberActive);
+                    opLog("Elastic stage: " + std::to_string(previousNumberActive) + " -> "
+                          + std::to_string(elasticStage.numberActive) + " of "
+                          + std::to_string(elasticStage.replicas.size()) + " replicas active.", Priority::Normal);
+                }
             }
         }
         catch (const std::exception& e)
@@ -1,18 +1,31 @@
 #ifndef OPENPOSE_THREAD_W_QUEUE_ORDERER_HPP
 #define OPENPOSE_THREAD_W_QUEUE_ORDERER_HPP
 
-#include <queue> // std::priority_queue
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <openpose/core/common.hpp>
 #include <openpose/thread/worker.hpp>
 #include <openpose/utilities/pointerContainer.hpp>
 
 namespace op
 {
+    /**
+     * It re-sorts the TDatums coming from parallel workers (e.g., 1 pose extractor per GPU) by (id, subId).
+     * Out-of-order TDatums are kept in a ring of maxBufferSize slots indexed by their sequence number
+     * (id * (subIdMax + 1) + subId), so inserting one is O(1). As soon as the next expected one arrives, it and the
+     * consecutive ones already buffered are released, one per work() call, without sleeping (see
+     * Worker::hasPendingOutput).
+     * If a TDatums is too far ahead to fit in the ring (e.g., the expected one was dropped), the buffered ones are
+     * released in order and the missing ones are skipped. TDatums older than the next expected one are released right
+     * away, or dropped if dropLateElements (e.g., for QueueFullPolicy::OverwriteOldest, where the output must never
+     * go back in time).
+     */
     template<typename TDatums>
     class WQueueOrderer : public Worker<TDatums>
     {
     public:
-        explicit WQueueOrderer(const unsigned int maxBufferSize = 64u);
+        explicit WQueueOrderer(const unsigned int maxBufferSize = 64u, const bool dropLateElements = false);
 
         virtual ~WQueueOrderer();
 
@@ -22,12 +35,65 @@ namespace op
 
         void tryStop();
 
+        bool hasPendingOutput() const;
+
+        /**
+         * Statistics about the time the TDatums wait in this WQueueOrderer (from arriving until being released),
+         * i.e., the latency cost of the parallel workers finishing out of order. They can be called from any thread.
+         */
+        unsigned long long getNumberElements() const;
+
+        /**
+         * Number of elements that had to wait for a previous one (i.e., that arrived out of order).
+         */
+        unsigned long long getNumberDelayedElements() const;
+
+        /**
+         * Average waiting time (in milliseconds) over all the elements (including the ones that did not wait).
+         */
+        double getAverageWaitMs() const;
+
+        double getMaxWaitMs() const;
+
+        /**
+         * Number of elements dropped for arriving after a newer one was released (only if dropLateElements).
+         */
+        unsigned long long getNumberDroppedElements() const;
+
     private:
+        typedef std::chrono::high_resolution_clock Clock;
+
+        struct Slot
+        {
+            TDatums tDatums;
+            Clock::time_point arrival;
+            // Whether it had to wait for a previous one
+            bool delayed;
+        };
+
         const unsigned int mMaxBufferSize;
+        const bool mDropLateElements;
         bool mStopWhenEmpty;
-        unsigned long long mNextExpectedId;
-        unsigned long long mNextExpectedSubId;
-        std::priority_queue<TDatums, std::vector<TDatums>, PointerContainerGreater<TDatums>> mPriorityQueueBuffer;
+        unsigned long long mNextExpectedSequence;
+        unsigned long long mNumberBuffered;
+        std::vector<Slot> mSlots;
+        std::deque<Slot> mReady;
+        // Statistics
+        std::atomic<unsigned long long> mNumberElements;
+        std::atomic<unsigned long long> mNumberDelayed;
+        std::atomic<unsigned long long> mWaitNsTotal;
+        std::atomic<unsigned long long> mWaitNsMax;
+        std::atomic<unsigned long long> mNumberDropped;
+
+        unsigned long long getSequence(const TDatums& tDatums) const;
+
+        // It moves the consecutive buffered TDatums starting at mNextExpectedSequence into mReady
+        void releaseConsecutive();
+
+        // It moves all the buffered TDatums (in order) into mReady, skipping the missing ones
+        void releaseAll();
+
+        void updateStatistics(const Clock::time_point& arrival, const bool delayed);
 
         DELETE_COPY(WQueueOrderer);
     };
@@ -41,17 +107,36 @@ namespace op
 namespace op
 {
     template<typename TDatums>
-    WQueueOrderer<TDatums>::WQueueOrderer(const unsigned int maxBufferSize) :
-        mMaxBufferSize{maxBufferSize},
+    WQueueOrderer<TDatums>::WQueueOrderer(const unsigned int maxBufferSize, const bool dropLateElements) :
+        mMaxBufferSize{maxBufferSize > 0u ? maxBufferSize : 1u},
+        mDropLateElements{dropLateElements},
         mStopWhenEmpty{false},
-        mNextExpectedId{0},
-        mNextExpectedSubId{0}
+        mNextExpectedSequence{0},
+        mNumberBuffered{0},
+        mSlots(mMaxBufferSize),
+        mNumberElements{0ull},
+        mNumberDelayed{0ull},
+        mWaitNsTotal{0ull},
+        mWaitNsMax{0ull},
+        mNumberDropped{0ull}
     {
     }
 
     template<typename TDatums>
     WQueueOrderer<TDatums>::~WQueueOrderer()
     {
+        try
+        {
+            if (getNumberElements() > 0)
+                opLog("Queue orderer: " + std::to_string(getNumberDelayedElements()) + " of "
+                      + std::to_string(getNumberElements()) + " elements arrived out of order, average wait "
+                      + std::to_string(getAverageWaitMs()) + " ms, max wait " + std::to_string(getMaxWaitMs())
+                      + " ms, " + std::to_string(getNumberDroppedElements()) + " dropped.", Priority::Normal);
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     template<typename TDatums>
@@ -67,76 +152,48 @@ namespace op
             // Profiling speed
             const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
             bool profileSpeed = (tDatums != nullptr);
-            // Input TDatum -> enqueue or return it back
+            // Input TDatum -> release it or buffer it
             if (checkNoNullNorEmpty(tDatums))
             {
-                // T* to T
-                auto& tDatumsNoPtr = *tDatums;
-                // tDatums is the next expected, update counter
-                if (tDatumsNoPtr[0]->id == mNextExpectedId && tDatumsNoPtr[0]->subId == mNextExpectedSubId)
+                const auto arrival = Clock::now();
+                const auto sequence = getSequence(tDatums);
+                // Older than the next expected one (e.g., skipped before) -> drop it or release it right away
+                if (sequence < mNextExpectedSequence)
                 {
-                    // If single-view
-                    if (tDatumsNoPtr[0]->subIdMax == 0)
-                        mNextExpectedId++;
-                    // If muilti-view system
+                    if (mDropLateElements)
+                        mNumberDropped++;
                     else
-                    {
-                        mNextExpectedSubId++;
-                        if (mNextExpectedSubId > tDatumsNoPtr[0]->subIdMax)
-                        {
-                            mNextExpectedSubId = 0;
-                            mNextExpectedId++;
-                        }
-                    }
+                        mReady.emplace_back(Slot{tDatums, arrival, false});
                 }
-                // Else push it to our buffered queue
                 else
                 {
-                    // Enqueue current tDatums
-                    mPriorityQueueBuffer.emplace(tDatums);
-                    tDatums = nullptr;
-                    // Else if buffer full -> remove one tDatums
-                    if (mPriorityQueueBuffer.size() > mMaxBufferSize)
+                    // Too far ahead for the ring -> the missing ones are assumed lost, release the buffered ones
+                    if (sequence >= mNextExpectedSequence + mMaxBufferSize)
                     {
-                        tDatums = mPriorityQueueBuffer.top();
-                        mPriorityQueueBuffer.pop();
+                        releaseAll();
+                        mNextExpectedSequence = sequence;
                     }
+                    // Buffer it and release it and its consecutive ones if it was the next expected one
+                    auto& slot = mSlots[sequence % mMaxBufferSize];
+                    if (slot.tDatums != nullptr)
+                        error("Duplicated (id, subId) received.", __LINE__, __FUNCTION__, __FILE__);
+                    slot = Slot{tDatums, arrival, sequence != mNextExpectedSequence};
+                    mNumberBuffered++;
+                    releaseConsecutive();
                 }
+                tDatums = nullptr;
             }
-            // If input TDatum enqueued -> check if previously enqueued next desired frame and pop it
-            if (!checkNoNullNorEmpty(tDatums))
+            // Stopping -> release everything left, in order
+            if (mStopWhenEmpty && mNumberBuffered > 0)
+                releaseAll();
+            // Return the oldest released TDatums (if any)
+            if (!mReady.empty())
             {
-                // Retrieve frame if next is desired frame or if we want to stop this worker
-                if (!mPriorityQueueBuffer.empty()
-                    && (mStopWhenEmpty ||
-                        ((*mPriorityQueueBuffer.top())[0]->id == mNextExpectedId
-                          && (*mPriorityQueueBuffer.top())[0]->subId == mNextExpectedSubId)))
-                {
-                    tDatums = { mPriorityQueueBuffer.top() };
-                    mPriorityQueueBuffer.pop();
-                }
-            }
-            // If TDatum ready to be returned -> updated next expected id
-            if (checkNoNullNorEmpty(tDatums))
-            {
-                const auto& tDatumsNoPtr = *tDatums;
-                // If single-view
-                if (tDatumsNoPtr[0]->subIdMax == 0)
-                    mNextExpectedId = tDatumsNoPtr[0]->id + 1;
-                // If muilti-view system
-                else
-                {
-                    mNextExpectedSubId = tDatumsNoPtr[0]->subId + 1;
-                    if (mNextExpectedSubId > tDatumsNoPtr[0]->subIdMax)
-                    {
-                        mNextExpectedSubId = 0;
-                        mNextExpectedId = tDatumsNoPtr[0]->id + 1;
-                    }
-                }
+                auto& slot = mReady.front();
+                tDatums = slot.tDatums;
+                updateStatistics(slot.arrival, slot.delayed);
+                mReady.pop_front();
             }
-            // Sleep if no new tDatums to either pop or push
-            if (!checkNoNullNorEmpty(tDatums) && mPriorityQueueBuffer.size() < mMaxBufferSize / 2u)
-                std::this_thread::sleep_for(std::chrono::milliseconds{1});
             // If TDatum popped and/or pushed
             if (profileSpeed || tDatums != nullptr)
             {
@@ -161,10 +218,172 @@ namespace op
         try
         {
             // Close if all frames were retrieved from the queue
-            if (mPriorityQueueBuffer.empty())
+            if (mReady.empty() && mNumberBuffered == 0)
                 this->stop();
             mStopWhenEmpty = true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 
+    template<typename TDatums>
+    bool WQueueOrderer<TDatums>::hasPendingOutput() const
+    {
+        try
+        {
+            return !mReady.empty() || (mStopWhenEmpty && mNumberBuffered > 0);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    unsigned long long WQueueOrderer<TDatums>::getNumberElements() const
+    {
+        try
+        {
+            return mNumberElements;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template<typename TDatums>
+    unsigned long long WQueueOrderer<TDatums>::getNumberDelayedElements() const
+    {
+        try
+        {
+            return mNumberDelayed;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template<typename TDatums>
+    double WQueueOrderer<TDatums>::getAverageWaitMs() const
+    {
+        try
+        {
+            const auto numberElements = getNumberElements();
+            return (numberElements > 0 ? mWaitNsTotal * 1e-6 / numberElements : 0.);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.;
+        }
+    }
+
+    template<typename TDatums>
+    double WQueueOrderer<TDatums>::getMaxWaitMs() const
+    {
+        try
+        {
+            return mWaitNsMax * 1e-6;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.;
+        }
+    }
+
+    template<typename TDatums>
+    unsigned long long WQueueOrderer<TDatums>::getNumberDroppedElements() const
+    {
+        try
+        {
+            return mNumberDropped;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template<typename TDatums>
+    unsigned long long WQueueOrderer<TDatums>::getSequence(const TDatums& tDatums) const
+    {
+        try
+        {
+            const auto& tDatum = (*tDatums)[0];
+            return tDatum->id * (tDatum->subIdMax + 1) + tDatum->subId;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template<typename TDatums>
+    void WQueueOrderer<TDatums>::releaseConsecutive()
+    {
+        try
+        {
+            while (mNumberBuffered > 0)
+            {
+                auto& slot = mSlots[mNextExpectedSequence % mMaxBufferSize];
+                if (slot.tDatums == nullptr)
+                    break;
+                mReady.emplace_back(std::move(slot));
+                slot.tDatums = nullptr;
+                mNumberBuffered--;
+                mNextExpectedSequence++;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WQueueOrderer<TDatums>::releaseAll()
+    {
+        try
+        {
+            // Only reached when TDatums are missing, so this O(maxBufferSize) scan is rare
+            while (mNumberBuffered > 0)
+            {
+                if (mSlots[mNextExpectedSequence % mMaxBufferSize].tDatums == nullptr)
+                    mNextExpectedSequence++;
+                else
+                    releaseConsecutive();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WQueueOrderer<TDatums>::updateStatistics(const Clock::time_point& arrival, const bool delayed)
+    {
+        try
+        {
+            const auto waitNs = (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now() - arrival).count();
+            mNumberElements++;
+            if (delayed)
+                mNumberDelayed++;
+            mWaitNsTotal += waitNs;
+            // Single writer (this worker thread), so no compare-and-swap is required
+            if (waitNs > mWaitNsMax)
+                mWaitNsMax = waitNs;
         }
         catch (const std::exception& e)
         {
@@ -0,0 +1,360 @@
+#ifndef OPENPOSE_THREAD_WORK_STEALING_SCHEDULER_HPP
+#define OPENPOSE_THREAD_WORK_STEALING_SCHEDULER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <openpose/core/common.hpp>
+#include <openpose/thread/thread.hpp>
+#include <openpose/utilities/fastMath.hpp>
+
+namespace op
+{
+    /**
+     * Execution backend of ThreadManager for ThreadManagerBackend::WorkStealing.
+     * Each added Thread (i.e., each stage of the pipeline) becomes a task of a fixed-size pool of threads. Each task
+     * has a home pool thread (round robin), which checks its own tasks first and only steals the ones of the other
+     * pool threads when none of its own is ready. A task runs a single iteration of the Thread loop
+     * (Thread::workInPool) and is only run if Thread::isReady(), so pool threads never sleep inside a stage waiting for
+     * data. An atomic flag per task guarantees that it never runs on 2 pool threads at once, so each stage keeps
+     * processing its elements in order.
+     * Idle pool threads sleep until notify() is called, which ThreadManager triggers whenever an element is pushed
+     * into or popped from any queue.
+     */
+    template<typename TDatums, typename TWorker = std::shared_ptr<Worker<TDatums>>>
+    class WorkStealingScheduler
+    {
+    public:
+        /**
+         * Constructor.
+         * @param isRunningSharedPtr Flag of the owning ThreadManager. The pool threads stop when it becomes false.
+         * @param numberThreads Number of pool threads. If <= 0, one per logical core. It is also limited to the
+         * number of added Threads.
+         */
+        explicit WorkStealingScheduler(
+            const std::shared_ptr<std::atomic<bool>>& isRunningSharedPtr, const int numberThreads = -1);
+
+        virtual ~WorkStealingScheduler();
+
+        /**
+         * It adds a stage. The Thread must already contain its SubThreads. It must be called before start() or exec().
+         */
+        void add(const std::shared_ptr<Thread<TDatums, TWorker>>& thread);
+
+        /**
+         * It starts the pool threads in the background.
+         */
+        void start();
+
+        /**
+         * Similar to start(), but the calling thread also becomes one of the pool threads, so it blocks until the
+         * pool finishes (i.e., the isRunningSharedPtr flag becomes false or all the stages are closed).
+         */
+        void exec();
+
+        void stopAndJoin();
+
+        /**
+         * It wakes up the idle pool threads so they check whether any stage became ready. It is thread-safe and cheap
+         * if no pool thread is idle.
+         */
+        void notify();
+
+        unsigned long long getNumberTasks() const;
+
+        unsigned long long getNumberSteals() const;
+
+    private:
+        struct Stage
+        {
+            std::shared_ptr<Thread<TDatums, TWorker>> spThread;
+            std::atomic<bool> busy;
+        };
+
+        std::shared_ptr<std::atomic<bool>> spIsRunning;
+        const int mNumberThreadsDesired;
+        std::vector<std::unique_ptr<Stage>> mStages;
+        std::vector<std::thread> mThreads;
+        // Idle pool threads
+        std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        std::atomic<unsigned long long> mEpoch;
+        std::atomic<int> mSleepers;
+        // Statistics
+        std::atomic<unsigned long long> mNumberTasks;
+        std::atomic<unsigned long long> mNumberSteals;
+
+        int getNumberThreads() const;
+
+        void startThreads(const int firstPoolIndex);
+
+        void poolFunction(const int poolIndex, const int numberPoolThreads);
+
+        DELETE_COPY(WorkStealingScheduler);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <chrono>
+namespace op
+{
+    template<typename TDatums, typename TWorker>
+    WorkStealingScheduler<TDatums, TWorker>::WorkStealingScheduler(
+        const std::shared_ptr<std::atomic<bool>>& isRunningSharedPtr, const int numberThreads) :
+        spIsRunning{isRunningSharedPtr},
+        mNumberThreadsDesired{numberThreads},
+        mEpoch{0ull},
+        mSleepers{0},
+        mNumberTasks{0ull},
+        mNumberSteals{0ull}
+    {
+    }
+
+    template<typename TDatums, typename TWorker>
+    WorkStealingScheduler<TDatums, TWorker>::~WorkStealingScheduler()
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            stopAndJoin();
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void WorkStealingScheduler<TDatums, TWorker>::add(const std::shared_ptr<Thread<TDatums, TWorker>>& thread)
+    {
+        try
+        {
+            if (!mThreads.empty())
+                error("Stages cannot be added while running.", __LINE__, __FUNCTION__, __FILE__);
+            mStages.emplace_back(new Stage{thread, {false}});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void WorkStealingScheduler<TDatums, TWorker>::start()
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            startThreads(0);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void WorkStealingScheduler<TDatums, TWorker>::exec()
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            // Calling thread = pool thread 0
+            startThreads(1);
+            poolFunction(0, getNumberThreads());
+            stopAndJoin();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void WorkStealingScheduler<TDatums, TWorker>::stopAndJoin()
+    {
+        try
+        {
+            if (!mThreads.empty())
+            {
+                // Pool threads stop once spIsRunning is false or all stages are closed
+                notify();
+                for (auto& thread : mThreads)
+                    if (thread.joinable())
+                        thread.join();
+                mThreads.clear();
+                opLog("Work-stealing scheduler: " + std::to_string(getNumberTasks()) + " tasks run, "
+                      + std::to_string(getNumberSteals()) + " of them stolen.", Priority::Normal);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void WorkStealingScheduler<TDatums, TWorker>::notify()
+    {
+        try
+        {
+            mEpoch++;
+            // Pairs with the fence of the idle pool threads: either they see the new epoch or this sees them
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (mSleepers > 0)
+            {
+                { const std::lock_guard<std::mutex> lock{mMutex}; }
+                mConditionVariable.notify_all();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    unsigned long long WorkStealingScheduler<TDatums, TWorker>::getNumberTasks() const
+    {
+        try
+        {
+            return mNumberTasks;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    unsigned long long WorkStealingScheduler<TDatums, TWorker>::getNumberSteals() const
+    {
+        try
+        {
+            return mNumberSteals;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    int WorkStealingScheduler<TDatums, TWorker>::getNumberThreads() const
+    {
+        try
+        {
+            const auto numberThreads = (mNumberThreadsDesired > 0
+                ? mNumberThreadsDesired : fastMax(1, (int)std::thread::hardware_concurrency()));
+            return fastMax(1, fastMin(numberThreads, (int)mStages.size()));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 1;
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void WorkStealingScheduler<TDatums, TWorker>::startThreads(const int firstPoolIndex)
+    {
+        try
+        {
+            stopAndJoin();
+            if (mStages.empty())
+                error("No stages added.", __LINE__, __FUNCTION__, __FILE__);
+            mNumberTasks = 0ull;
+            mNumberSteals = 0ull;
+            const auto numberThreads = getNumberThreads();
+            for (auto poolIndex = firstPoolIndex ; poolIndex < numberThreads ; poolIndex++)
+                mThreads.emplace_back(&WorkStealingScheduler::poolFunction, this, poolIndex, numberThreads);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void WorkStealingScheduler<TDatums, TWorker>::poolFunction(const int poolIndex, const int numberPoolThreads)
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            // Visiting order: own stages (stage % numberPoolThreads == poolIndex) first, then the ones of the next
+            // pool threads (stealing)
+            std::vector<size_t> stageOrder;
+            std::vector<bool> isOwnStage;
+            for (auto offset = 0 ; offset < numberPoolThreads ; offset++)
+            {
+                const auto owner = (poolIndex + offset) % numberPoolThreads;
+                for (auto stage = (size_t)owner ; stage < mStages.size() ; stage += numberPoolThreads)
+                {
+                    stageOrder.emplace_back(stage);
+                    isOwnStage.emplace_back(offset == 0);
+                }
+            }
+
+            while (*spIsRunning)
+            {
+                const auto epoch = mEpoch.load();
+                auto anyStageRunning = false;
+                auto worked = false;
+                for (auto i = 0u ; i < stageOrder.size() && !worked ; i++)
+                {
+                    auto& stage = *mStages[stageOrder[i]];
+                    if (!stage.spThread->isRunning())
+                        continue;
+                    anyStageRunning = true;
+                    // Being run by another pool thread
+                    if (stage.busy.exchange(true, std::memory_order_acquire))
+                        continue;
+                    if (stage.spThread->isRunning() && stage.spThread->isReady())
+                    {
+                        stage.spThread->workInPool();
+                        worked = true;
+                        mNumberTasks++;
+                        if (!isOwnStage[i])
+                            mNumberSteals++;
+                    }
+                    stage.busy.store(false, std::memory_order_release);
+                }
+                // Progress -> other stages (e.g., the next one) might be ready now
+                if (worked)
+                    notify();
+                // All stages closed
+                else if (!anyStageRunning)
+                    break;
+                // Nothing ready -> sleep until notify() (the timeout is only a safety net)
+                else
+                {
+                    std::unique_lock<std::mutex> lock{mMutex};
+                    mSleepers++;
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    mConditionVariable.wait_for(
+                        lock, std::chrono::milliseconds{10}, [&]{ return mEpoch != epoch || !*spIsRunning; });
+                    mSleepers--;
+                }
+            }
+            // Wake up the other pool threads so they also notice the end
+            notify();
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WorkStealingScheduler);
+}
+
+#endif // OPENPOSE_THREAD_WORK_STEALING_SCHEDULER_HPP
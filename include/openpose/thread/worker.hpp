@@ -1,6 +1,7 @@
 #ifndef OPENPOSE_THREAD_WORKER_HPP
 #define OPENPOSE_THREAD_WORKER_HPP
 
+#include <chrono>
 #include <openpose/core/common.hpp>
 
 namespace op
@@ -34,13 +35,38 @@ namespace op
             stop();
         }
 
+        // Virtual in case some worker buffers elements and can return them without new input (e.g., WQueueOrderer),
+        // so the SubThread calls it again right away rather than waiting for the next input element
+        inline virtual bool hasPendingOutput() const
+        {
+            return false;
+        }
+
+        /**
+         * Whether checkAndWork() skips work() for the TDatums whose deadline (Datum::deadline) already passed. They
+         * are marked as expired (Datum::expired) and forwarded as they are, so the following workers keep the
+         * ordering and IDs. Meant for the expensive (e.g., pose, face and hand estimation and rendering) and output
+         * workers. It has no effect if the TDatums elements have no deadline. It must be set before starting.
+         */
+        inline void setSkipExpired(const bool skipExpired)
+        {
+            mSkipExpired = skipExpired;
+        }
+
     protected:
         virtual void initializationOnThread() = 0;
 
         virtual void work(TDatums& tDatums) = 0;
 
+        // Virtual in case some worker must keep track of the expired TDatums it skips (e.g., WPoseExtractor, whose
+        // results might be reused by the frames skipped by the MotionGate)
+        inline virtual void workExpired(TDatums&)
+        {
+        }
+
     private:
         bool mIsRunning;
+        bool mSkipExpired;
 
         DELETE_COPY(Worker);
     };
@@ -53,9 +79,41 @@ namespace op
 // Implementation
 namespace op
 {
+    // Datum::deadline check. Only compiled if the TDatums elements have a deadline (e.g., Datum and derived classes).
+    // If any element expired, all of them are marked as expired
+    template<typename TDatums>
+    auto checkAndMarkExpired(TDatums& tDatums, int) -> decltype((*tDatums)[0]->expired = true, bool())
+    {
+        if (tDatums == nullptr)
+            return false;
+        auto expired = false;
+        for (const auto& tDatum : *tDatums)
+        {
+            if (tDatum != nullptr && (tDatum->expired
+                || (tDatum->deadline != decltype(tDatum->deadline){}
+                    && tDatum->deadline <= std::chrono::steady_clock::now())))
+            {
+                expired = true;
+                break;
+            }
+        }
+        if (expired)
+            for (auto& tDatum : *tDatums)
+                if (tDatum != nullptr)
+                    tDatum->expired = true;
+        return expired;
+    }
+
+    template<typename TDatums>
+    bool checkAndMarkExpired(TDatums&, long)
+    {
+        return false;
+    }
+
     template<typename TDatums>
     Worker<TDatums>::Worker() :
-        mIsRunning{true}
+        mIsRunning{true},
+        mSkipExpired{false}
     {
     }
 
@@ -84,7 +142,13 @@ namespace op
         try
         {
             if (mIsRunning)
-                work(tDatums);
+            {
+                // Deadline passed -> forward it without processing it
+                if (mSkipExpired && checkAndMarkExpired(tDatums, 0))
+                    workExpired(tDatums);
+                else
+                    work(tDatums);
+            }
             return mIsRunning;
         }
         catch (const std::exception& e)
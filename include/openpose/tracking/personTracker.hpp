@@ -19,6 +19,22 @@ namespace op
         void trackLockThread(Array<float>& poseKeypoints, Array<long long>& poseIds, const Matrix& cvMatInput,
                              const long long frameId);
 
+        /**
+         * Key frame schedule for the `tracking` mode: only key frames run the OpenPose network, while the keypoints
+         * of the intermediate frames are propagated with LK (with a confidence decay on each propagated frame).
+         * The number of frames between key frames starts at maxFramesBetweenKeyFrames, it is halved whenever the LK
+         * inlier ratio drops, and it grows back by 1 on each key frame while LK keeps tracking well. Thread-safe.
+         * @param frameId Frame to be processed.
+         * @param maxFramesBetweenKeyFrames Maximum number of propagated frames between consecutive key frames.
+         * @return Whether the OpenPose network should be run on frameId.
+         */
+        bool isKeyFrame(const long long frameId, const int maxFramesBetweenKeyFrames);
+
+        /**
+         * Current number of frames between consecutive key frames (-1 if isKeyFrame was never called).
+         */
+        int getFramesBetweenKeyFrames() const;
+
         bool getMergeResults() const;
 
     private:
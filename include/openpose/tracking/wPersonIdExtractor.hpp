@@ -63,8 +63,10 @@ namespace op
                 const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
                 // Render people pose
                 for (auto& tDatumPtr : *tDatums)
-                    tDatumPtr->poseIds = spPersonIdExtractor->extractIds(
-                        tDatumPtr->poseKeypoints, tDatumPtr->cvInputData);
+                    // Warm-up frames do not modify the person IDs
+                    if (!tDatumPtr->warmup)
+                        tDatumPtr->poseIds = spPersonIdExtractor->extractIds(
+                            tDatumPtr->poseKeypoints, tDatumPtr->cvInputData);
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
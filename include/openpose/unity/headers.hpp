@@ -3,5 +3,6 @@
 
 // unity module
 #include <openpose/unity/unityBinding.hpp>
+#include <openpose/unity/unitySharedMemory.hpp>
 
 #endif // OPENPOSE_UNITY_HEADERS_HPP
@@ -0,0 +1,107 @@
+#ifndef OPENPOSE_UNITY_UNITY_SHARED_MEMORY_HPP
+#define OPENPOSE_UNITY_UNITY_SHARED_MEMORY_HPP
+
+#include <array>
+#include <memory> // std::shared_ptr
+#include <string>
+#include <openpose/core/macros.hpp>
+
+namespace op
+{
+    struct Datum;
+
+    /**
+     * Layout of the shared memory region filled by UnitySharedMemoryWriter. The structs only contain plain types and
+     * have no implicit padding, so external readers (e.g., a plain C++ reader, or the C# structs of the Unity plugin
+     * with sequential layout) can replicate them:
+     * - UnitySharedMemoryHeader at offset 0.
+     * - 2 frame buffers, at bufferOffsets[0] and bufferOffsets[1], of bufferBytes each. Each one is made of:
+     *     - UnitySharedMemoryFrame.
+     *     - 4 keypoint blocks (body, face, left hand, right hand), at keypointOffsets[group] bytes from the beginning
+     *       of the buffer, each one with maxPeople x numberParts[group] x 3 (x, y, score) floats.
+     *     - The BGR image (unsigned char), at imageOffset bytes from the beginning of the buffer, with
+     *       maxImageBytes bytes.
+     *
+     * The writer always fills the buffer that is not being published (sequence + 1) % 2 and then publishes it by
+     * increasing sequence. Each buffer is protected with a sequence lock, so readers never block the writer:
+     * 1. s = header.sequence (0 means no frame yet). The last frame is in buffer s % 2.
+     * 2. Check that frame.sequenceEnd == s, copy the desired data, and check that frame.sequenceBegin == s. Otherwise,
+     *    the writer overwrote the buffer while it was read (the reader was more than 1 frame late), so go back to 1.
+     * Readers must read the sequence counters with acquire semantics (e.g., Volatile.Read in C#).
+     */
+    const unsigned int UNITY_SHARED_MEMORY_MAGIC = 0x4f50534du; // "OPSM"
+    const unsigned int UNITY_SHARED_MEMORY_VERSION = 1u;
+    const int UNITY_SHARED_MEMORY_GROUPS = 4; // Body, face, left hand, right hand
+
+    struct UnitySharedMemoryHeader
+    {
+        unsigned int magic;
+        unsigned int version;
+        unsigned long long sequence;
+        unsigned long long totalBytes;
+        unsigned long long bufferBytes;
+        unsigned long long bufferOffsets[2];
+        int maxPeople;
+        int numberParts[UNITY_SHARED_MEMORY_GROUPS];
+        int maxImageBytes;
+        unsigned long long keypointOffsets[UNITY_SHARED_MEMORY_GROUPS];
+        unsigned long long imageOffset;
+    };
+
+    struct UnitySharedMemoryFrame
+    {
+        unsigned long long sequenceBegin;
+        unsigned long long sequenceEnd;
+        unsigned long long id;
+        unsigned long long frameNumber;
+        // Number of people of each group (at most maxPeople, so extra people are not written)
+        int numberPeople[UNITY_SHARED_MEMORY_GROUPS];
+        // 0 if the frame has no image (image disabled, or larger than maxImageBytes)
+        int imageWidth;
+        int imageHeight;
+        int imageChannels;
+        int padding;
+    };
+
+    /**
+     * UnitySharedMemoryWriter: It writes the keypoints (and optionally the image) of each frame into a double-buffered
+     * memory-mapped region (see UnitySharedMemoryHeader), so a reader in another process (e.g., Unity) can poll the
+     * last frame without callbacks. The region is allocated once in the constructor, and write() does not allocate
+     * memory.
+     * On Windows, name is the name of a mapping backed by the paging file (e.g., "Local\\OpenPose"). Otherwise, it is
+     * the path of the file to map (e.g., "/dev/shm/openpose" for a shared memory file on Linux).
+     */
+    class OP_API UnitySharedMemoryWriter
+    {
+    public:
+        /**
+         * @param numberParts Number of parts of each group (body, face, left hand, right hand).
+         * @param maxImageBytes Maximum image size (width x height x channels). 0 disables the image output.
+         */
+        UnitySharedMemoryWriter(
+            const std::string& name, const int maxPeople,
+            const std::array<int, UNITY_SHARED_MEMORY_GROUPS>& numberParts, const int maxImageBytes = 0);
+
+        virtual ~UnitySharedMemoryWriter();
+
+        /**
+         * It writes and publishes the keypoints of the datum and, if writeImage, its rendered image (cvOutputData, or
+         * cvInputData if rendering is disabled).
+         */
+        void write(const Datum& datum, const bool writeImage = false);
+
+        unsigned long long getSequence() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplUnitySharedMemoryWriter;
+        std::shared_ptr<ImplUnitySharedMemoryWriter> spImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(UnitySharedMemoryWriter);
+    };
+}
+
+#endif // OPENPOSE_UNITY_UNITY_SHARED_MEMORY_HPP
@@ -5,9 +5,15 @@
 
 namespace op
 {
+    // The read-only functions below also accept an ArrayView<const T> (e.g., a person slice or a view of external
+    // memory) instead of the Array<T>, which avoids creating intermediate Arrays inside per-person loops.
+
     template <typename T>
     T getDistance(const Array<T>& keypoints, const int person, const int elementA, const int elementB);
 
+    template <typename T>
+    T getDistance(const ArrayView<const T>& keypoints, const int person, const int elementA, const int elementB);
+
     template <typename T>
     void averageKeypoints(Array<T>& keypointsA, const Array<T>& keypointsB, const int personA);
 
@@ -51,18 +57,35 @@ namespace op
         const Array<T>& keypoints, const int person, const T threshold, const int firstIndex = 0,
         const int lastIndex = -1);
 
+    template <typename T>
+    Rectangle<T> getKeypointsRectangle(
+        const ArrayView<const T>& keypoints, const int person, const T threshold, const int firstIndex = 0,
+        const int lastIndex = -1);
+
     template <typename T>
     T getAverageScore(const Array<T>& keypoints, const int person);
 
+    template <typename T>
+    T getAverageScore(const ArrayView<const T>& keypoints, const int person);
+
     template <typename T>
     T getKeypointsArea(const Array<T>& keypoints, const int person, const T threshold);
 
+    template <typename T>
+    T getKeypointsArea(const ArrayView<const T>& keypoints, const int person, const T threshold);
+
     template <typename T>
     int getBiggestPerson(const Array<T>& keypoints, const T threshold);
 
+    template <typename T>
+    int getBiggestPerson(const ArrayView<const T>& keypoints, const T threshold);
+
     template <typename T>
     int getNonZeroKeypoints(const Array<T>& keypoints, const int person, const T threshold);
 
+    template <typename T>
+    int getNonZeroKeypoints(const ArrayView<const T>& keypoints, const int person, const T threshold);
+
     template <typename T>
     T getDistanceAverage(const Array<T>& keypoints, const int personA, const int personB, const T threshold);
 
@@ -71,6 +94,11 @@ namespace op
         const Array<T>& keypointsA, const int personA, const Array<T>& keypointsB, const int personB,
         const T threshold);
 
+    template <typename T>
+    T getDistanceAverage(
+        const ArrayView<const T>& keypointsA, const int personA, const ArrayView<const T>& keypointsB,
+        const int personB, const T threshold);
+
     /**
      * Creates and Array<T> with a specific person.
      * @param keypoints Array<T> with the original data array to slice.
@@ -86,6 +114,13 @@ namespace op
     template <typename T>
     Array<T> getKeypointsPerson(const Array<T>& keypoints, const int person, const bool noCopy = false);
 
+    /**
+     * Similar to getKeypointsPerson(keypoints, person, true), but it returns a non-owning view, so it does not
+     * allocate anything. The same undefined behavior applies if the keypoints memory goes out of scope.
+     */
+    template <typename T>
+    ArrayView<const T> getKeypointsPerson(const ArrayView<const T>& keypoints, const int person);
+
     template <typename T>
     float getKeypointsRoi(const Array<T>& keypoints, const int personA, const int personB, const T threshold);
 
@@ -94,6 +129,11 @@ namespace op
         const Array<T>& keypointsA, const int personA, const Array<T>& keypointsB, const int personB,
         const T threshold);
 
+    template <typename T>
+    float getKeypointsRoi(
+        const ArrayView<const T>& keypointsA, const int personA, const ArrayView<const T>& keypointsB,
+        const int personB, const T threshold);
+
     template <typename T>
     float getKeypointsRoi(
         const Rectangle<T>& rectangleA, const Rectangle<T>& rectangleB);
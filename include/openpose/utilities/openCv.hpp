@@ -7,7 +7,14 @@ namespace op
 {
     OP_API void unrollArrayToUCharCvMat(Matrix& matResult, const Array<float>& array);
 
-    OP_API void uCharCvMatToFloatPtr(float* floatPtrImage, const Matrix& matImage, const int normalize);
+    /**
+     * @param paddedVolume Number of elements that can be written from floatPtrImage (e.g.,
+     * Array<float>::getPaddedVolume() for memory allocated by the Array). If it covers the image volume rounded up to
+     * whole SIMD blocks, the normalization writes the last (partial) block into that padding rather than running a
+     * scalar tail. 0 (default) if unknown.
+     */
+    OP_API void uCharCvMatToFloatPtr(float* floatPtrImage, const Matrix& matImage, const int normalize,
+                                     const size_t paddedVolume = 0);
 
     OP_API double resizeGetScaleFactor(const Point<int>& initialSize, const Point<int>& targetSize);
 
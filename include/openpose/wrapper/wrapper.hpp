@@ -1,7 +1,13 @@
 #ifndef OPENPOSE_WRAPPER_WRAPPER_HPP
 #define OPENPOSE_WRAPPER_WRAPPER_HPP
 
+#include <algorithm> // std::any_of, std::find_if
+#include <atomic>
+#include <mutex>
+#include <numeric> // std::accumulate
+#include <thread>
 #include <openpose/core/common.hpp>
+#include <openpose/core/motionGate.hpp>
 #include <openpose/thread/headers.hpp>
 #include <openpose/wrapper/enumClasses.hpp>
 #include <openpose/wrapper/wrapperStructExtra.hpp>
@@ -133,6 +139,31 @@ namespace op
          */
         bool isRunning() const;
 
+        /**
+         * Function to start multi-threading (if not started yet) and warm up the pipeline, so the first actual frames
+         * do not pay for it. Only valid if ThreadManagerMode::Asynchronous.
+         * Otherwise, the first frames wait for the networks to be loaded (asynchronously, by the threads that start()
+         * opens), reshaped and run for the first time, taking seconds. warmup() processes as many black frames of
+         * each resolution as GPU threads, so the pose network is reshaped and run for the net input sizes of the given
+         * frame resolutions (and scales). The face and hand networks are loaded, but not run, as no people are
+         * detected. It blocks until all the warm-up frames are processed.
+         * The frames are not routed to specific GPU threads: they are popped by whichever ones are idle. With more
+         * than 1 GPU thread, one that finishes loading its network before the others might take several frames of a
+         * resolution, so another one might still be loading its network or be cold for that resolution when warmup()
+         * returns (and isHot() is true). With 1 GPU thread, it is always fully warmed up.
+         * Note that the warm-up frames go through the whole pipeline (e.g., they are also written if any output is
+         * enabled) and consume frame numbers. They have Datum::warmup set, so the motion gate never skips them.
+         * @param resolutions Input image resolutions (width x height) that the service is expected to receive.
+         */
+        void warmup(const std::vector<Point<int>>& resolutions);
+
+        /**
+         * Whether the WrapperT is running and warmup() finished, e.g., for the health check of a service.
+         * It can be called from any thread.
+         * @return Boolean specifying whether the WrapperT is warmed up.
+         */
+        bool isHot() const;
+
         /**
          * It sets the maximum number of elements in the queue.
          * For maximum speed, set to a very large number, but the trade-off would be:
@@ -144,6 +175,55 @@ namespace op
          */
         void setDefaultMaxSizeQueues(const long long defaultMaxSizeQueues = -1);
 
+        /**
+         * It selects whether the internal threads block on the queue condition variables (default) or poll them
+         * every 100 microseconds. See ThreadManager::setBlocking for more details.
+         * @param blocking bool indicating whether to use the blocking mode.
+         */
+        void setBlocking(const bool blocking = true);
+
+        /**
+         * It selects how the internal threads are run. See ThreadManagerBackend and ThreadManager::setBackend for
+         * more details. The GPU and GUI stages always keep their own thread.
+         * @param backend ThreadManagerBackend to use (default: ThreadManagerBackend::Threads).
+         * @param numberPoolThreads Number of pool threads for ThreadManagerBackend::WorkStealing (<= 0 for one per
+         * logical core).
+         */
+        void setBackend(const ThreadManagerBackend backend, const int numberPoolThreads = -1);
+
+        /**
+         * It selects what the internal queues do when they are full. QueueFullPolicy::OverwriteOldest
+         * (latest-frame-wins) keeps the latency constant for live sources by dropping stale frames at every stage
+         * boundary. See ThreadManager::setQueueFullPolicy for more details.
+         * @param queueFullPolicy QueueFullPolicy to use (default: QueueFullPolicy::Block).
+         */
+        void setQueueFullPolicy(const QueueFullPolicy queueFullPolicy);
+
+        QueueFullPolicy getQueueFullPolicy() const;
+
+        /**
+         * Number of frames dropped at each stage boundary (see ThreadManager::getNumberDropped).
+         */
+        std::vector<unsigned long long> getNumberDropped() const;
+
+        /**
+         * Queue occupancy/wait-time telemetry and per-worker service time of the internal pipeline (see
+         * ThreadManager::getStatistics). It can be called from any thread while running.
+         */
+        ThreadManagerStatistics getStatistics() const;
+
+        /**
+         * Frames checked and skipped by the motion gate (WrapperStructExtra::motionThreshold). All zero if it is
+         * disabled. It can be called from any thread while running.
+         */
+        MotionGateStatistics getMotionGateStatistics() const;
+
+        /**
+         * If > 0, getStatistics() is logged every statisticsLogPeriod seconds while running. See
+         * ThreadManager::setStatisticsLogPeriod for more details.
+         */
+        void setStatisticsLogPeriod(const double statisticsLogPeriod = -1.);
+
         /**
          * Emplace (move) an element on the first (input) queue.
          * Only valid if ThreadManagerMode::Asynchronous or ThreadManagerMode::AsynchronousIn.
@@ -214,6 +294,7 @@ namespace op
 
         /**
          * Runs both waitAndEmplace and waitAndPop.
+         * Datum::deadline can be set on the elements of tDatums to bound their latency (see Datum::expired).
          * @param tDatums TDatumsSP element where the retrieved element will be placed.
          * @return Boolean specifying whether the tDatums could be retrieved.
          */
@@ -222,14 +303,35 @@ namespace op
         /**
          * Similar to emplaceAndPop(TDatumsSP& tDatums), but it takes a Matrix as input.
          * @param matrix Matrix with the image to be processed.
+         * @param deadline Optional Datum::deadline. By default, no deadline.
          * @return TDatumsSP element where the processed information will be placed.
          */
-        TDatumsSP emplaceAndPop(const Matrix& matrix);
+        TDatumsSP emplaceAndPop(
+            const Matrix& matrix,
+            const std::chrono::steady_clock::time_point& deadline = std::chrono::steady_clock::time_point{});
+
+        /**
+         * Direct (queue-less) synchronous processing for low-latency request/response services.
+         * Unlike emplaceAndPop, tDatum does not go through the ThreadManager queues and threads: scale and size
+         * extraction, input conversion, pose, face and hand estimation and keypoint scaling run inline on the calling
+         * thread (see createDirectWorkers). Rendering, output workers and the ones that keep state across frames
+         * (tracking, person ID, ROI inference, motion gate, latency-driven net resolution) are not applied.
+         * It only requires configure() (start() is not needed). Each calling thread gets its own workers (and
+         * networks, loaded on its first call), assigned to the configured GPUs in a round-robin way, so concurrent
+         * callers are safe and do not wait for each other. The workers of a thread that ended are reused by the next
+         * new one, and the ones stopped by an error are re-created on the next call.
+         * @param tDatum TDatum with the input image (cvInputData), where the results are placed.
+         * @return Boolean specifying whether tDatum was processed.
+         */
+        bool processDirect(TDatum& tDatum);
 
     private:
         const ThreadManagerMode mThreadManagerMode;
-        ThreadManager<TDatumsSP> mThreadManager;
+        // Lock-free queues (SPSC or MPMC depending on each edge of the configured pipeline)
+        ThreadManager<TDatumsSP, TWorker, RingBufferQueue<TDatumsSP>> mThreadManager;
         bool mMultiThreadEnabled;
+        std::atomic<bool> mHot;
+        std::shared_ptr<MotionGate> spMotionGate;
         // Configuration
         WrapperStructPose mWrapperStructPose;
         WrapperStructFace mWrapperStructFace;
@@ -241,6 +343,16 @@ namespace op
         // User configurable workers
         std::array<bool, int(WorkerType::Size)> mUserWsOnNewThread;
         std::array<std::vector<TWorker>, int(WorkerType::Size)> mUserWs;
+        // processDirect workers, each set owned by 1 calling thread at a time. The owner token expires when that
+        // thread ends, so the next new thread reuses them (there are at most as many sets as concurrent callers)
+        struct DirectWorkers
+        {
+            std::shared_ptr<std::vector<TWorker>> workers;
+            int gpuId;
+            std::weak_ptr<void> threadToken;
+        };
+        std::mutex mDirectWsMutex;
+        std::vector<DirectWorkers> mDirectWs;
 
         DELETE_COPY(WrapperT);
     };
@@ -261,7 +373,8 @@ namespace op
     WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::WrapperT(const ThreadManagerMode threadManagerMode) :
         mThreadManagerMode{threadManagerMode},
         mThreadManager{threadManagerMode},
-        mMultiThreadEnabled{true}
+        mMultiThreadEnabled{true},
+        mHot{false}
     {
     }
 
@@ -321,7 +434,10 @@ namespace op
     {
         try
         {
+            std::lock_guard<std::mutex> lock{mDirectWsMutex};
             mWrapperStructPose = wrapperStructPose;
+            // processDirect workers must be re-created
+            mDirectWs.clear();
         }
         catch (const std::exception& e)
         {
@@ -334,7 +450,10 @@ namespace op
     {
         try
         {
+            std::lock_guard<std::mutex> lock{mDirectWsMutex};
             mWrapperStructFace = wrapperStructFace;
+            // processDirect workers must be re-created
+            mDirectWs.clear();
         }
         catch (const std::exception& e)
         {
@@ -347,7 +466,10 @@ namespace op
     {
         try
         {
+            std::lock_guard<std::mutex> lock{mDirectWsMutex};
             mWrapperStructHand = wrapperStructHand;
+            // processDirect workers must be re-created
+            mDirectWs.clear();
         }
         catch (const std::exception& e)
         {
@@ -412,10 +534,11 @@ namespace op
     {
         try
         {
+            mHot = false;
             configureThreadManager<TDatum, TDatums, TDatumsSP, TWorker>(
                 mThreadManager, mMultiThreadEnabled, mThreadManagerMode, mWrapperStructPose, mWrapperStructFace,
                 mWrapperStructHand, mWrapperStructExtra, mWrapperStructInput, mWrapperStructOutput, mWrapperStructGui,
-                mUserWs, mUserWsOnNewThread);
+                mUserWs, mUserWsOnNewThread, spMotionGate);
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             mThreadManager.exec();
         }
@@ -430,10 +553,11 @@ namespace op
     {
         try
         {
+            mHot = false;
             configureThreadManager<TDatum, TDatums, TDatumsSP, TWorker>(
                 mThreadManager, mMultiThreadEnabled, mThreadManagerMode, mWrapperStructPose, mWrapperStructFace,
                 mWrapperStructHand, mWrapperStructExtra, mWrapperStructInput, mWrapperStructOutput, mWrapperStructGui,
-                mUserWs, mUserWsOnNewThread);
+                mUserWs, mUserWsOnNewThread, spMotionGate);
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             mThreadManager.start();
         }
@@ -448,6 +572,11 @@ namespace op
     {
         try
         {
+            mHot = false;
+            // Frames waiting for the results of other frames (which might never be processed) must not block the
+            // threads to join
+            if (spMotionGate != nullptr)
+                spMotionGate->stop();
             mThreadManager.stop();
         }
         catch (const std::exception& e)
@@ -470,6 +599,112 @@ namespace op
         }
     }
 
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::warmup(const std::vector<Point<int>>& resolutions)
+    {
+        try
+        {
+            if (mThreadManagerMode != ThreadManagerMode::Asynchronous)
+                error("warmup() is only valid with ThreadManagerMode::Asynchronous.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (resolutions.empty())
+                error("warmup() requires at least 1 resolution.", __LINE__, __FUNCTION__, __FILE__);
+            if (!isRunning())
+                start();
+            const auto timerBegin = std::chrono::high_resolution_clock::now();
+            const auto getTotalNumberDropped = [&]()
+            {
+                const auto numberDropped = getNumberDropped();
+                return std::accumulate(numberDropped.begin(), numberDropped.end(), 0ull);
+            };
+            // As many frames of each resolution as GPU threads, all emplaced together. They are taken by whichever GPU
+            // threads are idle, so this is a best effort for more than 1 GPU (see the warmup() documentation)
+            const auto frames = createWarmupFrames(resolutions);
+            const auto numberGpuThreads = getNumberGpuThreads(mWrapperStructPose);
+            std::vector<TDatumsSP> tDatumsSPs;
+            for (const auto& frame : frames)
+            {
+                for (auto gpuThread = 0 ; gpuThread < numberGpuThreads ; gpuThread++)
+                {
+                    auto datumsPtr = std::make_shared<TDatums>();
+                    datumsPtr->emplace_back(std::make_shared<TDatum>());
+                    datumsPtr->at(0)->cvInputData = frame;
+                    datumsPtr->at(0)->warmup = true;
+                    tDatumsSPs.emplace_back(datumsPtr);
+                }
+                // Emplaced on another thread, so full queues (shorter than numberGpuThreads) cannot block this one
+                const auto numberFrames = (unsigned long long)tDatumsSPs.size();
+                const auto numberDroppedBegin = getTotalNumberDropped();
+                std::exception_ptr emplaceException;
+                std::thread emplaceThread{[&]()
+                {
+                    try
+                    {
+                        for (auto& tDatumsSP : tDatumsSPs)
+                            if (!waitAndEmplace(tDatumsSP))
+                                break;
+                    }
+                    catch (...)
+                    {
+                        emplaceException = std::current_exception();
+                    }
+                }};
+                // Until all of them are popped or dropped (e.g., QueueFullPolicy::OverwriteOldest)
+                auto numberPopped = 0ull;
+                try
+                {
+                    TDatumsSP tDatumsSP;
+                    while (numberPopped + getTotalNumberDropped() - numberDroppedBegin < numberFrames
+                           && isRunning())
+                    {
+                        if (tryPop(tDatumsSP))
+                            numberPopped++;
+                        else
+                            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+                    }
+                }
+                catch (...)
+                {
+                    // Unblock emplaceThread if it is waiting for the (no longer popped) queues
+                    stop();
+                    emplaceThread.join();
+                    throw;
+                }
+                emplaceThread.join();
+                tDatumsSPs.clear();
+                if (emplaceException != nullptr)
+                    std::rethrow_exception(emplaceException);
+                if (numberPopped + getTotalNumberDropped() - numberDroppedBegin < numberFrames)
+                    error("OpenPose stopped while warming up (frame of " + std::to_string(frame.cols()) + "x"
+                          + std::to_string(frame.rows()) + ").", __LINE__, __FUNCTION__, __FILE__);
+            }
+            mHot = true;
+            const auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(
+                std::chrono::high_resolution_clock::now() - timerBegin).count();
+            opLog("OpenPose warmed up (" + std::to_string(frames.size()) + " resolution(s) on "
+                  + std::to_string(numberGpuThreads) + " GPU thread(s)) in " + std::to_string(seconds) + " seconds.",
+                  Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::isHot() const
+    {
+        try
+        {
+            return mHot && isRunning();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
     void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::setDefaultMaxSizeQueues(const long long defaultMaxSizeQueues)
     {
@@ -483,6 +718,115 @@ namespace op
         }
     }
 
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::setBlocking(const bool blocking)
+    {
+        try
+        {
+            mThreadManager.setBlocking(blocking);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::setBackend(
+        const ThreadManagerBackend backend, const int numberPoolThreads)
+    {
+        try
+        {
+            mThreadManager.setBackend(backend, numberPoolThreads);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::setQueueFullPolicy(const QueueFullPolicy queueFullPolicy)
+    {
+        try
+        {
+            mThreadManager.setQueueFullPolicy(queueFullPolicy);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
+    QueueFullPolicy WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::getQueueFullPolicy() const
+    {
+        try
+        {
+            return mThreadManager.getQueueFullPolicy();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return QueueFullPolicy::Block;
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
+    std::vector<unsigned long long> WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::getNumberDropped() const
+    {
+        try
+        {
+            return mThreadManager.getNumberDropped();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
+    ThreadManagerStatistics WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::getStatistics() const
+    {
+        try
+        {
+            return mThreadManager.getStatistics();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return ThreadManagerStatistics{};
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
+    MotionGateStatistics WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::getMotionGateStatistics() const
+    {
+        try
+        {
+            return (spMotionGate != nullptr ? spMotionGate->getStatistics() : MotionGateStatistics{});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return MotionGateStatistics{};
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::setStatisticsLogPeriod(const double statisticsLogPeriod)
+    {
+        try
+        {
+            mThreadManager.setStatisticsLogPeriod(statisticsLogPeriod);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
     bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::tryEmplace(TDatumsSP& tDatums)
     {
@@ -687,7 +1031,8 @@ namespace op
     }
 
     template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    TDatumsSP WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::emplaceAndPop(const Matrix& matrix)
+    TDatumsSP WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::emplaceAndPop(
+        const Matrix& matrix, const std::chrono::steady_clock::time_point& deadline)
     {
         try
         {
@@ -698,6 +1043,7 @@ namespace op
             tDatumPtr = std::make_shared<TDatum>();
             // Fill datum
             tDatumPtr->cvInputData = matrix;
+            tDatumPtr->deadline = deadline;
             // Emplace and pop
             emplaceAndPop(datumsPtr);
             // Return result
@@ -710,6 +1056,73 @@ namespace op
         }
     }
 
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::processDirect(TDatum& tDatum)
+    {
+        try
+        {
+            // Alive while this thread runs
+            static thread_local const auto threadToken = std::make_shared<char>();
+            // Workers of this thread
+            std::shared_ptr<std::vector<TWorker>> directWs;
+            auto initialize = false;
+            {
+                std::lock_guard<std::mutex> lock{mDirectWsMutex};
+                auto threadDirectWs = std::find_if(
+                    mDirectWs.begin(), mDirectWs.end(), [](const DirectWorkers& directWorkers)
+                    {
+                        return directWorkers.threadToken.lock() == threadToken;
+                    });
+                // New thread -> Workers of a thread that already ended, or new ones if all of them are in use
+                if (threadDirectWs == mDirectWs.end())
+                {
+                    threadDirectWs = std::find_if(
+                        mDirectWs.begin(), mDirectWs.end(), [](const DirectWorkers& directWorkers)
+                        {
+                            return directWorkers.threadToken.expired();
+                        });
+                    if (threadDirectWs == mDirectWs.end())
+                    {
+                        // Round-robin over the configured GPUs
+                        const auto gpuId = (getGpuMode() == GpuMode::NoGpu ? 0 : mWrapperStructPose.gpuNumberStart
+                            + int(mDirectWs.size() % (size_t)getNumberGpuThreads(mWrapperStructPose)));
+                        mDirectWs.emplace_back(DirectWorkers{nullptr, gpuId, std::weak_ptr<void>{}});
+                        threadDirectWs = mDirectWs.end() - 1;
+                    }
+                    threadDirectWs->threadToken = threadToken;
+                    initialize = true;
+                }
+                // Not created yet, or stopped by an error on a previous call (so they would always return false) ->
+                // (Re)create them
+                if (threadDirectWs->workers == nullptr
+                    || std::any_of(threadDirectWs->workers->begin(), threadDirectWs->workers->end(),
+                                   [](const TWorker& directW) { return !directW->isRunning(); }))
+                {
+                    threadDirectWs->workers = std::make_shared<std::vector<TWorker>>(
+                        createDirectWorkers<TDatumsSP, TWorker>(
+                            mWrapperStructPose, mWrapperStructFace, mWrapperStructHand, threadDirectWs->gpuId));
+                    initialize = true;
+                }
+                directWs = threadDirectWs->workers;
+            }
+            if (initialize)
+                for (auto& directW : *directWs)
+                    directW->initializationOnThreadNoException();
+            // Run them inline on tDatum (not owned by tDatums)
+            auto tDatums = std::make_shared<TDatums>();
+            tDatums->emplace_back(std::shared_ptr<TDatum>{&tDatum, [](TDatum*){}});
+            for (auto& directW : *directWs)
+                if (!directW->checkAndWork(tDatums) || tDatums == nullptr)
+                    return false;
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     extern template class WrapperT<BASE_DATUM>;
 }
 
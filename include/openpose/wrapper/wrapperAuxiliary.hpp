@@ -1,6 +1,8 @@
 #ifndef OPENPOSE_WRAPPER_WRAPPER_AUXILIARY_HPP
 #define OPENPOSE_WRAPPER_WRAPPER_AUXILIARY_HPP
 
+#include <functional> // std::function
+#include <openpose/core/motionGate.hpp>
 #include <openpose/thread/headers.hpp>
 #include <openpose/wrapper/enumClasses.hpp>
 #include <openpose/wrapper/wrapperStructExtra.hpp>
@@ -44,24 +46,61 @@ namespace op
      */
     OP_API void threadIdPP(unsigned long long& threadId, const bool multiThreadEnabled);
 
+    /**
+     * CPUs of the NUMA node of each GPU thread (private internal function), used by WrapperStructExtra::pinThreads.
+     * The node of each GPU is WrapperStructPose::gpuNumaNodes if given, else the one read from the system topology
+     * (see getGpuNumaNode), else the GPUs are evenly distributed over the nodes.
+     * @param numberGpuThreads Number of GPU threads (at least 1 element is returned, e.g., for CPU-only).
+     */
+    OP_API std::vector<std::vector<int>> getGpuThreadCpus(
+        const WrapperStructPose& wrapperStructPose, const int numberGpuThreads);
+
+    /**
+     * Number of GPU threads (i.e., pose network copies) of the configuration (private internal function): 1 for
+     * CPU-only, all the GPUs from gpuNumberStart if gpuNumber < 0, or gpuNumber otherwise.
+     */
+    OP_API int getNumberGpuThreads(const WrapperStructPose& wrapperStructPose);
+
+    /**
+     * Frames of WrapperT::warmup (private internal function): a black BGR image of each resolution.
+     */
+    OP_API std::vector<Matrix> createWarmupFrames(const std::vector<Point<int>>& resolutions);
+
     /**
      * Set ThreadManager from TWorkers (private internal function).
      * After any configure() has been called, the TWorkers are initialized. This function resets the ThreadManager
      * and adds them.
      * Common code for start() and exec().
+     * @param motionGate It is set to the MotionGate of the pipeline (nullptr if disabled).
      */
     template<typename TDatum,
              typename TDatums = std::vector<std::shared_ptr<TDatum>>,
              typename TDatumsSP = std::shared_ptr<TDatums>,
-             typename TWorker = std::shared_ptr<Worker<TDatumsSP>>>
+             typename TWorker = std::shared_ptr<Worker<TDatumsSP>>,
+             typename TQueue = Queue<TDatumsSP>>
     void configureThreadManager(
-        ThreadManager<TDatumsSP>& threadManager, const bool multiThreadEnabled,
+        ThreadManager<TDatumsSP, TWorker, TQueue>& threadManager, const bool multiThreadEnabled,
         const ThreadManagerMode threadManagerMode, const WrapperStructPose& wrapperStructPose,
         const WrapperStructFace& wrapperStructFace, const WrapperStructHand& wrapperStructHand,
         const WrapperStructExtra& wrapperStructExtra, const WrapperStructInput& wrapperStructInput,
         const WrapperStructOutput& wrapperStructOutput, const WrapperStructGui& wrapperStructGui,
         const std::array<std::vector<TWorker>, int(WorkerType::Size)>& userWs,
-        const std::array<bool, int(WorkerType::Size)>& userWsOnNewThread);
+        const std::array<bool, int(WorkerType::Size)>& userWsOnNewThread,
+        std::shared_ptr<MotionGate>& motionGate);
+
+    /**
+     * Workers of WrapperT::processDirect (private internal function).
+     * It creates the chain of workers that processes a frame inline (with no queues nor threads) on the GPU gpuId:
+     * scale and size extraction, input conversion, pose, face and hand estimation and keypoint scaling. Rendering,
+     * output and the workers that keep state across frames (tracking, person ID, ROI inference, motion gate and
+     * latency-driven net resolution) are not included, so independent chains can process frames concurrently.
+     * Their initializationOnThread() must be called on the thread that runs them.
+     */
+    template<typename TDatumsSP,
+             typename TWorker = std::shared_ptr<Worker<TDatumsSP>>>
+    std::vector<TWorker> createDirectWorkers(
+        const WrapperStructPose& wrapperStructPose, const WrapperStructFace& wrapperStructFace,
+        const WrapperStructHand& wrapperStructHand, const int gpuId);
 
     /**
      * It fills camera parameters and splits the cvMat depending on how many camera parameter matrices are found.
@@ -94,19 +133,21 @@ namespace op
 #include <openpose/utilities/standard.hpp>
 namespace op
 {
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
     void configureThreadManager(
-        ThreadManager<TDatumsSP>& threadManager, const bool multiThreadEnabledTemp,
+        ThreadManager<TDatumsSP, TWorker, TQueue>& threadManager, const bool multiThreadEnabledTemp,
         const ThreadManagerMode threadManagerMode, const WrapperStructPose& wrapperStructPoseTemp,
         const WrapperStructFace& wrapperStructFace, const WrapperStructHand& wrapperStructHand,
         const WrapperStructExtra& wrapperStructExtra, const WrapperStructInput& wrapperStructInput,
         const WrapperStructOutput& wrapperStructOutput, const WrapperStructGui& wrapperStructGui,
         const std::array<std::vector<TWorker>, int(WorkerType::Size)>& userWs,
-        const std::array<bool, int(WorkerType::Size)>& userWsOnNewThread)
+        const std::array<bool, int(WorkerType::Size)>& userWsOnNewThread,
+        std::shared_ptr<MotionGate>& motionGate)
     {
         try
         {
             opLog("Running configureThreadManager...", Priority::Normal);
+            motionGate.reset();
 
             // Create producer
             auto producerSharedPtr = createProducer(
@@ -261,7 +302,7 @@ namespace op
             {
                 const auto datumProducer = std::make_shared<DatumProducer<TDatum>>(
                     producerSharedPtr, wrapperStructInput.frameFirst, wrapperStructInput.frameStep,
-                    wrapperStructInput.frameLast, spVideoSeek
+                    wrapperStructInput.frameLast, spVideoSeek, wrapperStructInput.frameDeadline
                 );
                 datumProducerW = std::make_shared<WDatumProducer<TDatum>>(datumProducer);
             }
@@ -286,12 +327,31 @@ namespace op
             std::vector<std::vector<TWorker>> poseTriangulationsWs;
             std::vector<std::vector<TWorker>> jointAngleEstimationsWs;
             std::vector<TWorker> postProcessingWs;
+            // Elastic CPU post-processing: additional replicas of postProcessingWs
+            std::vector<std::vector<TWorker>> postProcessingReplicasWs;
+            const auto elasticThreads = (multiThreadEnabled ? fastMax(0, wrapperStructExtra.elasticThreads) : 0);
+            TWorker netResolutionControllerStartW;
+            TWorker netResolutionControllerEndW;
+            TWorker motionGateW;
+            TWorker motionGateFillW;
             if (numberGpuThreads > 0)
             {
+                // Latency-driven net input resolution
+                std::shared_ptr<NetResolutionController> netResolutionController;
+                if (wrapperStructPose.latencyBudget > 0.)
+                {
+                    netResolutionController = std::make_shared<NetResolutionController>(
+                        wrapperStructPose.netInputSize.y, wrapperStructPose.latencyBudget,
+                        wrapperStructPose.netInputHeights);
+                    netResolutionControllerStartW = std::make_shared<WNetResolutionController<TDatumsSP>>(
+                        netResolutionController, true);
+                    netResolutionControllerEndW = std::make_shared<WNetResolutionController<TDatumsSP>>(
+                        netResolutionController, false);
+                }
                 // Get input scales and sizes
                 const auto scaleAndSizeExtractor = std::make_shared<ScaleAndSizeExtractor>(
                     wrapperStructPose.netInputSize, (float)wrapperStructPose.netInputSizeDynamicBehavior, finalOutputSize,
-                    wrapperStructPose.scalesNumber, wrapperStructPose.scaleGap);
+                    wrapperStructPose.scalesNumber, wrapperStructPose.scaleGap, netResolutionController);
                 scaleAndSizeExtractorW = std::make_shared<WScaleAndSizeExtractor<TDatumsSP>>(scaleAndSizeExtractor);
 
                 // Input cvMat to OpenPose input & output format
@@ -319,7 +379,8 @@ namespace op
                 }
 
                 // Pose estimators & renderers
-                std::vector<TWorker> cpuRenderers;
+                // CPU renderers are thread-safe, so the W of each elastic replica wraps the same ones
+                std::vector<std::function<TWorker()>> cpuRenderers;
                 poseExtractorsWs.clear();
                 poseExtractorsWs.resize(numberGpuThreads);
                 if (wrapperStructPose.poseMode != PoseMode::Disabled)
@@ -364,7 +425,8 @@ namespace op
                                 wrapperStructPose.poseModel, wrapperStructPose.renderThreshold,
                                 wrapperStructPose.blendOriginalFrame, alphaKeypoint, alphaHeatMap,
                                 wrapperStructPose.defaultPartToRender);
-                            cpuRenderers.emplace_back(std::make_shared<WPoseRenderer<TDatumsSP>>(poseCpuRenderer));
+                            cpuRenderers.emplace_back([poseCpuRenderer]{
+                                return std::make_shared<WPoseRenderer<TDatumsSP>>(poseCpuRenderer); });
                         }
                     }
                     opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
@@ -387,13 +449,35 @@ namespace op
                     if (wrapperStructExtra.tracking > -1)
                         personTrackers->emplace_back(
                             std::make_shared<PersonTracker>(wrapperStructExtra.tracking == 0));
+                    // Motion gate (skip frames without scene change)
+                    // Latest-frame-wins might drop the reference frame the skipped ones wait for
+                    if (wrapperStructExtra.motionThreshold >= 0.
+                        && threadManager.getQueueFullPolicy() == QueueFullPolicy::OverwriteOldest)
+                        opLog("The motion gate is disabled with QueueFullPolicy::OverwriteOldest (flag"
+                              " `--latest_frame_wins` on the demo), since frames might be dropped.",
+                              Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                    else if (wrapperStructExtra.motionThreshold >= 0.)
+                    {
+                        // Several GPUs -> The skipped frames whose reference is still being processed by another GPU
+                        // are deferred (filled after sorting the frames) rather than waiting for it on their GPU
+                        // thread. Not if GPU rendering, since it would draw them before being filled (so they run
+                        // the body network instead)
+                        const auto deferFrames = (multiThreadEnabled && poseExtractorNets.size() > 1u
+                                                  && poseGpuRenderers.empty());
+                        motionGate = std::make_shared<MotionGate>(
+                            wrapperStructExtra.motionThreshold, wrapperStructExtra.motionMaxSkip, 64, deferFrames);
+                        motionGateW = std::make_shared<WMotionGate<TDatumsSP>>(motionGate, true);
+                        if (deferFrames)
+                            motionGateFillW = std::make_shared<WMotionGate<TDatumsSP>>(motionGate, false);
+                    }
                     for (auto i = 0u; i < poseExtractorsWs.size(); i++)
                     {
                         // OpenPose keypoint detector + keepTopNPeople
                         //    + ID extractor (experimental) + tracking (experimental)
                         const auto poseExtractor = std::make_shared<PoseExtractor>(
                             poseExtractorNets.at(i), keepTopNPeople, personIdExtractor, personTrackers,
-                            wrapperStructPose.numberPeopleMax, wrapperStructExtra.tracking);
+                            wrapperStructPose.numberPeopleMax, wrapperStructExtra.tracking,
+                            wrapperStructExtra.roiRefresh, motionGate);
                         // If we want the initial image resize on GPU
                         if (cvMatToOpInputW == nullptr)
                         {
@@ -568,7 +652,8 @@ namespace op
                             wrapperStructFace.renderThreshold, wrapperStructFace.alphaKeypoint,
                             wrapperStructFace.alphaHeatMap);
                         // Add worker
-                        cpuRenderers.emplace_back(std::make_shared<WFaceRenderer<TDatumsSP>>(faceRenderer));
+                        cpuRenderers.emplace_back([faceRenderer]{
+                            return std::make_shared<WFaceRenderer<TDatumsSP>>(faceRenderer); });
                     }
                     // GPU rendering
                     else if (renderModeFace == RenderMode::Gpu)
@@ -612,7 +697,8 @@ namespace op
                             wrapperStructHand.renderThreshold, wrapperStructHand.alphaKeypoint,
                             wrapperStructHand.alphaHeatMap);
                         // Add worker
-                        cpuRenderers.emplace_back(std::make_shared<WHandRenderer<TDatumsSP>>(handRenderer));
+                        cpuRenderers.emplace_back([handRenderer]{
+                            return std::make_shared<WHandRenderer<TDatumsSP>>(handRenderer); });
                     }
                     // GPU rendering
                     else if (renderModeHand == RenderMode::Gpu)
@@ -667,7 +753,8 @@ namespace op
                 {
                     opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                     // For all (body/face/hands): PoseTriangulations ~30 msec, 8 GPUS ~30 msec for keypoint estimation
-                    poseTriangulationsWs.resize(fastMax(1, int(poseExtractorsWs.size() / 4)));
+                    // Elastic -> up to elasticThreads of them, only the default number active at the beginning
+                    poseTriangulationsWs.resize(fastMax(fastMax(1, int(poseExtractorsWs.size() / 4)), elasticThreads));
                     for (auto i = 0u ; i < poseTriangulationsWs.size() ; i++)
                     {
                         const auto poseTriangulation = std::make_shared<PoseTriangulation>(
@@ -688,12 +775,19 @@ namespace op
                 //     );
                 // }
                 // Frames processor (OpenPose format -> cv::Mat format)
+                // Elastic -> 1 chain per replica (own OpOutputToCvMat), so the CPU rendering can run in parallel
                 if (addCvMatToOpOutputInCpu)
                 {
                     opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-                    postProcessingWs = mergeVectors(postProcessingWs, cpuRenderers);
-                    const auto opOutputToCvMat = std::make_shared<OpOutputToCvMat>();
-                    postProcessingWs.emplace_back(std::make_shared<WOpOutputToCvMat<TDatumsSP>>(opOutputToCvMat));
+                    postProcessingReplicasWs.resize(fastMax(0, elasticThreads - 1));
+                    for (auto replica = 0u ; replica <= postProcessingReplicasWs.size() ; replica++)
+                    {
+                        auto& workers = (replica == 0 ? postProcessingWs : postProcessingReplicasWs.at(replica-1));
+                        for (const auto& cpuRenderer : cpuRenderers)
+                            workers.emplace_back(cpuRenderer());
+                        const auto opOutputToCvMat = std::make_shared<OpOutputToCvMat>();
+                        workers.emplace_back(std::make_shared<WOpOutputToCvMat<TDatumsSP>>(opOutputToCvMat));
+                    }
                 }
                 opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Re-scale pose if desired
@@ -709,6 +803,9 @@ namespace op
                     // Then we must rescale the keypoints
                     auto keypointScaler = std::make_shared<KeypointScaler>(wrapperStructPose.keypointScaleMode);
                     postProcessingWs.emplace_back(std::make_shared<WKeypointScaler<TDatumsSP>>(keypointScaler));
+                    for (auto& postProcessingReplicaWs : postProcessingReplicasWs)
+                        postProcessingReplicaWs.emplace_back(
+                            std::make_shared<WKeypointScaler<TDatumsSP>>(keypointScaler));
                 }
             }
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
@@ -961,6 +1058,17 @@ namespace op
             TWorker wFpsMax;
             if (wrapperStructPose.fpsMax > 0.)
                 wFpsMax = std::make_shared<WFpsMax<TDatumsSP>>(wrapperStructPose.fpsMax);
+            // Deadlines (Datum::deadline): Expired frames skip the expensive (pose, face, hand, rendering) and output
+            // workers, but they still go through the others (e.g., WQueueOrderer), so IDs and ordering are kept
+            for (const auto& workers : {poseExtractorsWs, poseTriangulationsWs, jointAngleEstimationsWs,
+                                        postProcessingReplicasWs})
+                for (const auto& workersGpu : workers)
+                    for (const auto& worker : workersGpu)
+                        worker->setSkipExpired(true);
+            for (const auto& workers : {postProcessingWs, outputWs, std::vector<TWorker>{guiW, videoSaver3DW}})
+                for (const auto& worker : workers)
+                    if (worker != nullptr)
+                        worker->setSkipExpired(true);
             // Set wrapper as configured
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
 
@@ -994,6 +1102,8 @@ namespace op
             unsigned long long threadId = 0ull;
             auto queueIn = 0ull;
             auto queueOut = 1ull;
+            // Thread id of each GPU (for WrapperStructExtra::pinThreads)
+            std::vector<unsigned long long> gpuThreadIds;
             // After producer
             // ID generator (before any multi-threading or any function that requires the ID)
             const auto wIdGenerator = std::make_shared<WIdGenerator<TDatumsSP>>();
@@ -1009,6 +1119,12 @@ namespace op
                 workersAux = mergeVectors(workersAux, {userPreProcessingWs});
             }
             workersAux = mergeVectors(workersAux, {wIdGenerator});
+            // Motion gate (before any multi-threading)
+            if (motionGateW != nullptr)
+                workersAux = mergeVectors(workersAux, {motionGateW});
+            // Latency measurement start (for the latency-driven net resolution)
+            if (netResolutionControllerStartW != nullptr)
+                workersAux = mergeVectors(workersAux, {netResolutionControllerStartW});
             // Scale & cv::Mat to OP format
             if (scaleAndSizeExtractorW != nullptr)
                 workersAux = mergeVectors(workersAux, {scaleAndSizeExtractorW});
@@ -1018,6 +1134,10 @@ namespace op
             if (cvMatToOpOutputW != nullptr)
                 workersAux = mergeVectors(workersAux, {cvMatToOpOutputW});
 
+            // Latest-frame-wins -> frames might be dropped before reaching the WQueueOrderers, so they only keep a
+            // few frames (2 per parallel worker) and drop the ones that arrive too late
+            const auto dropLateFrames = (threadManager.getQueueFullPolicy() == QueueFullPolicy::OverwriteOldest);
+
             // Producer
             // If custom user Worker and uses its own thread
             if (!userInputWs.empty() && userInputWsOnNewThread)
@@ -1053,6 +1173,9 @@ namespace op
                     {
                         opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                         threadManager.add(threadId, wPose, queueIn, queueOut);
+                        // GPU (thread-local Caffe/CUDA state) -> never moved between threads
+                        threadManager.addDedicatedThread(threadId);
+                        gpuThreadIds.emplace_back(threadId);
                         threadIdPP(threadId, multiThreadEnabled);
                     }
                     queueIn++;
@@ -1060,9 +1183,13 @@ namespace op
                     // Sort frames - Required own thread
                     if (poseExtractorsWs.size() > 1u)
                     {
-                        const auto wQueueOrderer = std::make_shared<WQueueOrderer<TDatumsSP>>();
+                        std::vector<TWorker> wQueueOrdererWs{std::make_shared<WQueueOrderer<TDatumsSP>>(
+                            dropLateFrames ? 2u * (unsigned int)poseExtractorsWs.size() : 64u, dropLateFrames)};
+                        // Frames deferred by the MotionGate (frames already sorted)
+                        if (motionGateFillW != nullptr)
+                            wQueueOrdererWs.emplace_back(motionGateFillW);
                         opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-                        threadManager.add(threadId, wQueueOrderer, queueIn++, queueOut++);
+                        threadManager.add(threadId, wQueueOrdererWs, queueIn++, queueOut++);
                         threadIdPP(threadId, multiThreadEnabled);
                     }
                 }
@@ -1074,6 +1201,8 @@ namespace op
                             " with the `--num_gpu_start` flag).", Priority::High);
                     opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                     threadManager.add(threadId, poseExtractorsWs.at(0), queueIn++, queueOut++);
+                    threadManager.addDedicatedThread(threadId);
+                    gpuThreadIds.emplace_back(threadId);
                 }
             }
             // Assemble all frames from same time instant (3-D module)
@@ -1094,12 +1223,16 @@ namespace op
                         threadManager.add(threadId, wPoseTriangulations, queueIn, queueOut);
                         threadIdPP(threadId, multiThreadEnabled);
                     }
+                    if (elasticThreads > 0)
+                        threadManager.addElasticStage(
+                            queueIn, (unsigned int)fastMax(1, int(poseExtractorsWs.size() / 4)));
                     queueIn++;
                     queueOut++;
                     // Sort frames
                     if (poseTriangulationsWs.size() > 1u)
                     {
-                        const auto wQueueOrderer = std::make_shared<WQueueOrderer<TDatumsSP>>();
+                        const auto wQueueOrderer = std::make_shared<WQueueOrderer<TDatumsSP>>(
+                            dropLateFrames ? 2u * (unsigned int)poseTriangulationsWs.size() : 64u, dropLateFrames);
                         opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                         threadManager.add(threadId, wQueueOrderer, queueIn++, queueOut++);
                         threadIdPP(threadId, multiThreadEnabled);
@@ -1114,6 +1247,13 @@ namespace op
                     threadManager.add(threadId, poseTriangulationsWs.at(0), queueIn++, queueOut++);
                 }
             }
+            // Elastic post-processing -> the WQueueAssembler cannot be replicated
+            else if (!postProcessingReplicasWs.empty())
+            {
+                opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                threadManager.add(threadId, wQueueAssembler, queueIn++, queueOut++);
+                threadIdPP(threadId, multiThreadEnabled);
+            }
             else
                 postProcessingWs = mergeVectors({wQueueAssembler}, postProcessingWs);
             // Adam/IK step
@@ -1127,12 +1267,17 @@ namespace op
                         threadManager.add(threadId, wJointAngleEstimator, queueIn, queueOut);
                         threadIdPP(threadId, multiThreadEnabled);
                     }
+                    // Elastic -> up to ikThreads, only 1 active at the beginning (each one loads its own model, so
+                    // elasticThreads does not add more)
+                    if (elasticThreads > 0)
+                        threadManager.addElasticStage(queueIn);
                     queueIn++;
                     queueOut++;
                     // Sort frames
                     if (jointAngleEstimationsWs.size() > 1)
                     {
-                        const auto wQueueOrderer = std::make_shared<WQueueOrderer<TDatumsSP>>();
+                        const auto wQueueOrderer = std::make_shared<WQueueOrderer<TDatumsSP>>(
+                            dropLateFrames ? 2u * (unsigned int)jointAngleEstimationsWs.size() : 64u, dropLateFrames);
                         opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                         threadManager.add(threadId, wQueueOrderer, queueIn++, queueOut++);
                         threadIdPP(threadId, multiThreadEnabled);
@@ -1147,8 +1292,40 @@ namespace op
                     threadManager.add(threadId, jointAngleEstimationsWs.at(0), queueIn++, queueOut++);
                 }
             }
+            // Latency measurement end (for the latency-driven net resolution): at the end of the last worker set among
+            // the post-processing and output ones, so it does not need a thread of its own
+            const auto userPostProcessingOwnThread = (userPostProcessingWsOnNewThread && !userPostProcessingWs.empty());
+            const auto outputWsEmpty = outputWs.empty()
+                && (!postProcessingReplicasWs.empty() || postProcessingWs.empty())
+                && (userPostProcessingWs.empty() || userPostProcessingWsOnNewThread);
             // Post processing workers
-            if (!postProcessingWs.empty())
+            // Elastic -> replicas in parallel + sort frames. The output workers (video, JSON, UDP, ...) are ordered or
+            // stateful, so they are not replicated
+            if (!postProcessingReplicasWs.empty())
+            {
+                opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                threadManager.add(threadId, postProcessingWs, queueIn, queueOut);
+                threadIdPP(threadId, multiThreadEnabled);
+                for (const auto& postProcessingReplicaWs : postProcessingReplicasWs)
+                {
+                    threadManager.add(threadId, postProcessingReplicaWs, queueIn, queueOut);
+                    threadIdPP(threadId, multiThreadEnabled);
+                }
+                threadManager.addElasticStage(queueIn);
+                queueIn++;
+                queueOut++;
+                const auto numberReplicas = (unsigned int)postProcessingReplicasWs.size() + 1u;
+                std::vector<TWorker> wQueueOrdererWs{std::make_shared<WQueueOrderer<TDatumsSP>>(
+                    dropLateFrames ? 2u * numberReplicas : 64u, dropLateFrames)};
+                if (netResolutionControllerEndW != nullptr && outputWsEmpty && !userPostProcessingOwnThread)
+                {
+                    wQueueOrdererWs.emplace_back(netResolutionControllerEndW);
+                    netResolutionControllerEndW = nullptr;
+                }
+                threadManager.add(threadId, wQueueOrdererWs, queueIn++, queueOut++);
+                threadIdPP(threadId, multiThreadEnabled);
+            }
+            else if (!postProcessingWs.empty())
             {
                 // Combining postProcessingWs and outputWs
                 outputWs = mergeVectors(postProcessingWs, outputWs);
@@ -1163,6 +1340,11 @@ namespace op
                 // If custom user Worker in its own thread
                 if (userPostProcessingWsOnNewThread)
                 {
+                    if (netResolutionControllerEndW != nullptr && outputWsEmpty)
+                    {
+                        userPostProcessingWs.emplace_back(netResolutionControllerEndW);
+                        netResolutionControllerEndW = nullptr;
+                    }
                     opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                     threadManager.add(threadId, userPostProcessingWs, queueIn++, queueOut++);
                     threadIdPP(threadId, multiThreadEnabled);
@@ -1172,6 +1354,23 @@ namespace op
                 else
                     outputWs = mergeVectors(outputWs, userPostProcessingWs);
             }
+            // Latency measurement end (if not added yet)
+            if (netResolutionControllerEndW != nullptr)
+            {
+                // At the end of the output workers
+                if (!outputWs.empty())
+                    outputWs.emplace_back(netResolutionControllerEndW);
+                // No post-processing nor output workers -> before the user output ones
+                else if (!userOutputWs.empty())
+                    userOutputWs = mergeVectors({netResolutionControllerEndW}, userOutputWs);
+                // Nothing else -> in the last thread
+                else
+                {
+                    opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                    const auto lastThreadId = (multiThreadEnabled ? threadId-1 : threadId);
+                    threadManager.add(lastThreadId, netResolutionControllerEndW, queueIn++, queueOut++);
+                }
+            }
             // Output workers
             if (!outputWs.empty())
             {
@@ -1202,6 +1401,8 @@ namespace op
                 // Thread Y+1, queues Q+1 -> Q+2
                 opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 threadManager.add(threadId, guiW, queueIn++, queueOut++);
+                // GUI event loop -> never moved between threads
+                threadManager.addDedicatedThread(threadId);
                 // Saving 3D output
                 if (videoSaver3DW != nullptr)
                     threadManager.add(threadId, videoSaver3DW, queueIn++, queueOut++);
@@ -1215,10 +1416,102 @@ namespace op
                 threadManager.add(threadId, wFpsMax, queueIn++, queueOut++);
                 threadIdPP(threadId, multiThreadEnabled);
             }
+            // NUMA placement: GPU threads on the node of their GPU, the others on the one of the first GPU
+            if (wrapperStructExtra.pinThreads)
+            {
+                const auto gpuThreadCpus = getGpuThreadCpus(wrapperStructPose, (int)gpuThreadIds.size());
+                for (auto id = 0ull ; id <= threadId ; id++)
+                    threadManager.setThreadCpus(id, gpuThreadCpus.at(0));
+                for (auto i = 0u ; i < gpuThreadIds.size() ; i++)
+                    threadManager.setThreadCpus(gpuThreadIds[i], gpuThreadCpus.at(i));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatumsSP, typename TWorker>
+    std::vector<TWorker> createDirectWorkers(
+        const WrapperStructPose& wrapperStructPose, const WrapperStructFace& wrapperStructFace,
+        const WrapperStructHand& wrapperStructHand, const int gpuId)
+    {
+        try
+        {
+            std::vector<TWorker> workers;
+            const auto modelFolder = formatAsDirectory(wrapperStructPose.modelFolder.getStdString());
+            // Scale & cv::Mat to OP format
+            const auto scaleAndSizeExtractor = std::make_shared<ScaleAndSizeExtractor>(
+                wrapperStructPose.netInputSize, (float)wrapperStructPose.netInputSizeDynamicBehavior,
+                wrapperStructPose.outputSize, wrapperStructPose.scalesNumber, wrapperStructPose.scaleGap);
+            workers.emplace_back(std::make_shared<WScaleAndSizeExtractor<TDatumsSP>>(scaleAndSizeExtractor));
+            const auto cvMatToOpInput = std::make_shared<CvMatToOpInput>(wrapperStructPose.poseModel, false);
+            workers.emplace_back(std::make_shared<WCvMatToOpInput<TDatumsSP>>(cvMatToOpInput));
+            // Pose extractor
+            if (wrapperStructPose.poseMode != PoseMode::Disabled)
+            {
+                const auto poseExtractorNet = std::make_shared<PoseExtractorCaffe>(
+                    wrapperStructPose.poseModel, modelFolder, gpuId, wrapperStructPose.heatMapTypes,
+                    wrapperStructPose.heatMapScaleMode, wrapperStructPose.addPartCandidates,
+                    wrapperStructPose.maximizePositives, wrapperStructPose.protoTxtPath.getStdString(),
+                    wrapperStructPose.caffeModelPath.getStdString(), wrapperStructPose.upsamplingRatio,
+                    wrapperStructPose.poseMode == PoseMode::Enabled, wrapperStructPose.enableGoogleLogging);
+                const auto keepTopNPeople = (wrapperStructPose.numberPeopleMax > 0 ?
+                    std::make_shared<KeepTopNPeople>(wrapperStructPose.numberPeopleMax) : nullptr);
+                const auto poseExtractor = std::make_shared<PoseExtractor>(
+                    poseExtractorNet, keepTopNPeople, nullptr, nullptr, wrapperStructPose.numberPeopleMax);
+                workers.emplace_back(std::make_shared<WPoseExtractor<TDatumsSP>>(poseExtractor));
+            }
+            // Face extractor
+            if (wrapperStructFace.enable)
+            {
+                if (wrapperStructFace.detector == Detector::Body)
+                    workers.emplace_back(std::make_shared<WFaceDetector<TDatumsSP>>(
+                        std::make_shared<FaceDetector>(wrapperStructPose.poseModel)));
+                else if (wrapperStructFace.detector == Detector::OpenCV)
+                    workers.emplace_back(std::make_shared<WFaceDetectorOpenCV<TDatumsSP>>(
+                        std::make_shared<FaceDetectorOpenCV>(modelFolder)));
+                else if (wrapperStructFace.detector != Detector::Provided)
+                    error("Unknown face Detector. Select a valid face Detector (`--face_detector`).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                const auto faceExtractorNet = std::make_shared<FaceExtractorCaffe>(
+                    wrapperStructFace.netInputSize, wrapperStructFace.netInputSize, modelFolder, gpuId,
+                    wrapperStructPose.heatMapTypes, wrapperStructPose.heatMapScaleMode,
+                    wrapperStructPose.enableGoogleLogging);
+                workers.emplace_back(std::make_shared<WFaceExtractorNet<TDatumsSP>>(faceExtractorNet));
+            }
+            // Hand extractor
+            if (wrapperStructHand.enable)
+            {
+                // Tracking depends on the previous frame -> Body detector
+                if (wrapperStructHand.detector == Detector::Body
+                    || wrapperStructHand.detector == Detector::BodyWithTracking)
+                    workers.emplace_back(std::make_shared<WHandDetector<TDatumsSP>>(
+                        std::make_shared<HandDetector>(wrapperStructPose.poseModel)));
+                else if (wrapperStructHand.detector != Detector::Provided)
+                    error("Unknown hand Detector. Select a valid hand Detector (`--hand_detector`).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                const auto handExtractorNet = std::make_shared<HandExtractorCaffe>(
+                    wrapperStructHand.netInputSize, wrapperStructHand.netInputSize, modelFolder, gpuId,
+                    wrapperStructHand.scalesNumber, wrapperStructHand.scaleRange, wrapperStructPose.heatMapTypes,
+                    wrapperStructPose.heatMapScaleMode, wrapperStructPose.enableGoogleLogging);
+                workers.emplace_back(std::make_shared<WHandExtractorNet<TDatumsSP>>(handExtractorNet));
+            }
+            // Re-scale keypoints if desired (there is no producer, so the input size is unknown in advance)
+            if (wrapperStructPose.keypointScaleMode != ScaleMode::InputResolution
+                && !(wrapperStructPose.keypointScaleMode == ScaleMode::OutputResolution
+                     && (wrapperStructPose.outputSize.x <= 0 || wrapperStructPose.outputSize.y <= 0)))
+            {
+                const auto keypointScaler = std::make_shared<KeypointScaler>(wrapperStructPose.keypointScaleMode);
+                workers.emplace_back(std::make_shared<WKeypointScaler<TDatumsSP>>(keypointScaler));
+            }
+            return workers;
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
         }
     }
 
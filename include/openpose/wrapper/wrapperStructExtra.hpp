@@ -33,9 +33,11 @@ namespace op
         bool identification;
 
         /**
-         * Whether to enable people tracking across frames. The value indicates the number of frames where tracking
-         * is run between each OpenPose keypoint detection. Select -1 (default) to disable it or 0 to run
-         * simultaneously OpenPose keypoint detector and tracking for potentially higher accuracy than only OpenPose.
+         * Whether to enable people tracking across frames. The value indicates the maximum number of frames where
+         * tracking is run between each OpenPose keypoint detection (key frame). It is automatically reduced while the
+         * tracker (LK) loses keypoints, and the confidence of the tracked keypoints decays on each tracked frame.
+         * Select -1 (default) to disable it or 0 to run simultaneously OpenPose keypoint detector and tracking for
+         * potentially higher accuracy than only OpenPose.
          */
         int tracking;
 
@@ -46,6 +48,44 @@ namespace op
          */
         int ikThreads;
 
+        /**
+         * Whether to run the body network only on the area occupied by the people detected in the previous frame
+         * (union of their padded bounding boxes), mapping the keypoints back to frame coordinates. Select -1
+         * (default) to disable it, 0 to only run a full-frame detection when the previous frame has no people or
+         * people are lost, or N > 0 to also force a full-frame detection every N frames. Only applied with a single
+         * scale (`scalesNumber == 1`).
+         */
+        int roiRefresh;
+
+        /**
+         * Whether to skip the body network on frames with negligible scene change (e.g., static cameras), reusing
+         * the body keypoints of the last processed frame. The value is the maximum mean absolute difference per
+         * pixel (gray levels in [0, 255]) between the thumbnails of the current and last processed frames. Select -1
+         * (default) to disable it.
+         */
+        double motionThreshold;
+
+        /**
+         * Maximum number of consecutive frames skipped by `motionThreshold`, so results are periodically refreshed.
+         */
+        int motionMaxSkip;
+
+        /**
+         * Maximum number of worker threads of each replicable CPU stage (3-D triangulation, joint angle estimation and
+         * CPU rendering plus cv::Mat conversion). The number of active ones is raised at runtime while the input queue
+         * of the stage stays saturated, and lowered when it is idle (see ThreadManager::addElasticStage). Select 0
+         * (default) to disable it, i.e., fixed number of threads. It requires multi-threading.
+         */
+        int elasticThreads;
+
+        /**
+         * Whether to pin each thread to the CPUs of a NUMA node (read from /sys on Linux), so the threads do not
+         * migrate across sockets and the large buffers they allocate (e.g., net input and heat maps) stay on their
+         * local node: each GPU thread on the node of its GPU (see WrapperStructPose::gpuNumaNodes), and the other
+         * ones (producer, post-processing, output, ...) on the node of the first GPU.
+         */
+        bool pinThreads;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -53,7 +93,9 @@ namespace op
          */
         WrapperStructExtra(
             const bool reconstruct3d = false, const int minViews3d = -1, const bool identification = false,
-            const int tracking = -1, const int ikThreads = 0);
+            const int tracking = -1, const int ikThreads = 0, const int roiRefresh = -1,
+            const double motionThreshold = -1., const int motionMaxSkip = 10, const int elasticThreads = 0,
+            const bool pinThreads = false);
     };
 }
 
@@ -91,6 +91,13 @@ namespace op
          */
         int numberViews;
 
+        /**
+         * Latency budget (in milliseconds) of each frame since it is read by the producer, used to set
+         * Datum::deadline. Frames that are still being processed after it skip the expensive and output workers.
+         * -1 disables it.
+         */
+        double frameDeadline;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -103,7 +110,7 @@ namespace op
             const bool realTimeProcessing = false, const bool frameFlip = false, const int frameRotate = 0,
             const bool framesRepeat = false, const Point<int>& cameraResolution = Point<int>{-1,-1},
             const String& cameraParameterPath = "models/cameraParameters/",
-            const bool undistortImage = false, const int numberViews = -1);
+            const bool undistortImage = false, const int numberViews = -1, const double frameDeadline = -1.);
     };
 }
 
@@ -213,6 +213,28 @@ namespace op
          */
         bool enableGoogleLogging;
 
+        /**
+         * Target latency per frame (in milliseconds).
+         * If positive, the net input height is dynamically chosen among `netInputHeights` (see
+         * NetResolutionController), keeping the highest one whose latency meets this budget. It requires a positive
+         * `netInputSize.y`. By default (-1), it is disabled and `netInputSize` is always used.
+         */
+        double latencyBudget;
+
+        /**
+         * Candidate net input heights (multiples of 16) for `latencyBudget`.
+         * If empty (default), it will use 5 levels from 100% to 50% of `netInputSize.y`.
+         */
+        std::vector<int> netInputHeights;
+
+        /**
+         * NUMA node of each GPU (in the same order as the GPUs used, i.e., starting at `gpuNumberStart`), used to
+         * place its thread and buffers when WrapperStructExtra::pinThreads is enabled.
+         * If empty (default), it is read from the system topology (see getGpuNumaNode), or, if unknown, the GPUs are
+         * evenly distributed over the NUMA nodes.
+         */
+        std::vector<int> gpuNumaNodes;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -231,7 +253,9 @@ namespace op
             const ScaleMode heatMapScaleMode = ScaleMode::UnsignedChar, const bool addPartCandidates = false,
             const float renderThreshold = 0.05f, const int numberPeopleMax = -1, const bool maximizePositives = false,
             const double fpsMax = -1., const String& protoTxtPath = "", const String& caffeModelPath = "",
-            const float upsamplingRatio = 0.f, const bool enableGoogleLogging = true);
+            const float upsamplingRatio = 0.f, const bool enableGoogleLogging = true,
+            const double latencyBudget = -1., const std::vector<int>& netInputHeights = {},
+            const std::vector<int>& gpuNumaNodes = {});
     };
 }
 
@@ -10,7 +10,9 @@
 #include <pybind11/stl_bind.h>
 #include <pybind11/numpy.h>
 #include <opencv2/core/core.hpp>
+#include <algorithm> // std::copy, std::max
 #include <stdexcept>
+#include <thread>
 
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<op::Datum>>);
 
@@ -78,10 +80,51 @@ namespace op
         }
     }
 
+    /**
+     * It stacks the {people x parts x channels} keypoints of each image into a single numpy array of shape
+     * {images x max people x parts x channels}, zero-padded for the images with fewer people. The numpy array owns
+     * its memory, so it does not depend on the lifetime of the Datums.
+     */
+    py::array_t<float> stackKeypoints(const std::vector<const Array<float>*>& keypointsPerImage)
+    {
+        try
+        {
+            auto maxPeople = 0;
+            auto numberParts = 0;
+            auto numberChannels = 3;
+            for (const auto* const keypoints : keypointsPerImage)
+            {
+                if (!keypoints->empty())
+                {
+                    maxPeople = std::max(maxPeople, keypoints->getSize(0));
+                    numberParts = keypoints->getSize(1);
+                    numberChannels = keypoints->getSize(2);
+                }
+            }
+            py::array_t<float> stackedKeypoints(std::vector<ssize_t>{
+                (ssize_t)keypointsPerImage.size(), maxPeople, numberParts, numberChannels});
+            auto* stackedPtr = stackedKeypoints.mutable_data();
+            const auto imageVolume = (size_t)maxPeople * numberParts * numberChannels;
+            std::fill(stackedPtr, stackedPtr + keypointsPerImage.size() * imageVolume, 0.f);
+            for (auto i = 0u ; i < keypointsPerImage.size() ; i++)
+                if (!keypointsPerImage[i]->empty())
+                    std::copy(keypointsPerImage[i]->getConstPtr(),
+                              keypointsPerImage[i]->getConstPtr() + keypointsPerImage[i]->getVolume(),
+                              stackedPtr + i * imageVolume);
+            return stackedKeypoints;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return py::array_t<float>{};
+        }
+    }
+
     class WrapperPython{
     public:
         std::unique_ptr<Wrapper> opWrapper;
         bool synchronousIn;
+        bool synchronousOut;
 
         WrapperPython(ThreadManagerMode mode = ThreadManagerMode::Asynchronous)
         {
@@ -95,6 +138,11 @@ namespace op
                 mode == ThreadManagerMode::AsynchronousOut ||
                 mode == ThreadManagerMode::Synchronous
             );
+            // Synchronous out
+            synchronousOut = (
+                mode == ThreadManagerMode::AsynchronousIn ||
+                mode == ThreadManagerMode::Synchronous
+            );
         }
 
         void configure(py::dict params = py::dict())
@@ -150,7 +198,8 @@ namespace op
                     (float)FLAGS_alpha_pose, (float)FLAGS_alpha_heatmap, FLAGS_part_to_show, op::String(FLAGS_model_folder),
                     heatMapTypes, heatMapScaleMode, FLAGS_part_candidates, (float)FLAGS_render_threshold,
                     FLAGS_number_people_max, FLAGS_maximize_positives, FLAGS_fps_max, op::String(FLAGS_prototxt_path),
-                    op::String(FLAGS_caffemodel_path), (float)FLAGS_upsampling_ratio, enableGoogleLogging};
+                    op::String(FLAGS_caffemodel_path), (float)FLAGS_upsampling_ratio, enableGoogleLogging,
+                    FLAGS_latency_budget};
                 opWrapper->configure(wrapperStructPose);
                 // Face configuration (use WrapperStructFace{} to disable it)
                 const WrapperStructFace wrapperStructFace{
@@ -166,7 +215,9 @@ namespace op
                 opWrapper->configure(wrapperStructHand);
                 // Extra functionality configuration (use WrapperStructExtra{} to disable it)
                 const WrapperStructExtra wrapperStructExtra{
-                    FLAGS_3d, FLAGS_3d_min_views, FLAGS_identification, FLAGS_tracking, FLAGS_ik_threads};
+                    FLAGS_3d, FLAGS_3d_min_views, FLAGS_identification, FLAGS_tracking, FLAGS_ik_threads,
+                    FLAGS_roi_refresh, FLAGS_motion_threshold, FLAGS_motion_max_skip, FLAGS_elastic_threads,
+                    FLAGS_pin_threads};
                 opWrapper->configure(wrapperStructExtra);
                 // Output (comment or use default argument to disable any output)
                 const WrapperStructOutput wrapperStructOutput{
@@ -297,6 +348,121 @@ namespace op
                 return false;
             }
         }
+
+        /**
+         * It processes a batch of BGR images (uint8 numpy arrays of shape {height x width x 3}) and returns a dict
+         * with one stacked numpy array per output kind (see stackKeypoints()): "pose_keypoints", "face_keypoints",
+         * "left_hand_keypoints" and "right_hand_keypoints", plus "number_people" (int32 {images}).
+         * Ownership: C-contiguous uint8 images are not copied, they are read in place, so they must not be modified
+         * (e.g., by other Python threads) until this function returns. The returned numpy arrays own their memory.
+         * The GIL is released while the images go through the pipeline, and all of them are pushed before waiting for
+         * the results, so they are processed in parallel by all the GPUs. It requires ThreadManagerMode::Asynchronous
+         * and the default QueueFullPolicy::Block (i.e., no frame is dropped).
+         */
+        py::dict processBatch(
+            const std::vector<py::array_t<unsigned char, py::array::c_style | py::array::forcecast>>& images)
+        {
+            try
+            {
+                // Sanity checks
+                if (synchronousIn || synchronousOut)
+                    error("process_batch requires ThreadManagerMode.Asynchronous.", __LINE__, __FUNCTION__, __FILE__);
+                if (opWrapper->getQueueFullPolicy() != QueueFullPolicy::Block)
+                    error("process_batch requires QueueFullPolicy::Block (other policies might drop frames of the"
+                          " batch).", __LINE__, __FUNCTION__, __FILE__);
+                for (const auto& image : images)
+                    if (image.ndim() != 3 || image.shape(2) != 3)
+                        error("process_batch only accepts BGR images of shape (height, width, 3).",
+                              __LINE__, __FUNCTION__, __FILE__);
+                // Wrap the numpy images (no copy)
+                std::vector<std::shared_ptr<std::vector<std::shared_ptr<Datum>>>> datumsPtrs(images.size());
+                for (auto i = 0u ; i < images.size() ; i++)
+                {
+                    datumsPtrs[i] = std::make_shared<std::vector<std::shared_ptr<Datum>>>();
+                    datumsPtrs[i]->emplace_back(std::make_shared<Datum>());
+                    datumsPtrs[i]->at(0)->cvInputData = Matrix(
+                        (int)images[i].shape(0), (int)images[i].shape(1), CV_8UC3, (void*)images[i].data());
+                }
+                // Process them without the GIL (no Python object is accessed meanwhile)
+                std::vector<std::shared_ptr<Datum>> results(images.size());
+                {
+                    py::gil_scoped_release gilRelease;
+                    // Pushed from another thread, so the pipeline queues do not block if they are smaller than the
+                    // batch
+                    std::string emplaceError;
+                    std::thread emplaceThread{[&]()
+                    {
+                        try
+                        {
+                            for (auto& datumsPtr : datumsPtrs)
+                                if (!opWrapper->waitAndEmplace(datumsPtr))
+                                    break;
+                        }
+                        catch (const std::exception& e)
+                        {
+                            emplaceError = e.what();
+                        }
+                    }};
+                    // Results in the same order than the input (WQueueOrderer). The ids are assigned in place by
+                    // the pipeline, so a different id means that other frames went through the same Wrapper (e.g.,
+                    // pushed by another caller) and the results would not match the images
+                    auto numberResults = 0u;
+                    try
+                    {
+                        for ( ; numberResults < results.size() ; numberResults++)
+                        {
+                            std::shared_ptr<std::vector<std::shared_ptr<Datum>>> datumsPtr;
+                            if (!opWrapper->waitAndPop(datumsPtr) || datumsPtr == nullptr || datumsPtr->empty())
+                                break;
+                            const auto expectedId = datumsPtrs[numberResults]->at(0)->id;
+                            if (datumsPtr->at(0)->id != expectedId)
+                                error("process_batch got the result of frame " + std::to_string(datumsPtr->at(0)->id)
+                                      + " instead of frame " + std::to_string(expectedId) + ". The Wrapper must not"
+                                      " process other frames meanwhile.", __LINE__, __FUNCTION__, __FILE__);
+                            results[numberResults] = datumsPtr->at(0);
+                        }
+                    }
+                    catch (...)
+                    {
+                        // Unblock emplaceThread if it is waiting for the (no longer popped) queues
+                        opWrapper->stop();
+                        emplaceThread.join();
+                        throw;
+                    }
+                    emplaceThread.join();
+                    if (!emplaceError.empty())
+                        error(emplaceError, __LINE__, __FUNCTION__, __FILE__);
+                    if (numberResults < results.size())
+                        error("OpenPose stopped before processing the whole batch.", __LINE__, __FUNCTION__, __FILE__);
+                }
+                // Stack the results
+                std::vector<const Array<float>*> poseKeypoints(results.size());
+                std::vector<const Array<float>*> faceKeypoints(results.size());
+                std::vector<const Array<float>*> leftHandKeypoints(results.size());
+                std::vector<const Array<float>*> rightHandKeypoints(results.size());
+                py::array_t<int> numberPeople(std::vector<ssize_t>{(ssize_t)results.size()});
+                for (auto i = 0u ; i < results.size() ; i++)
+                {
+                    poseKeypoints[i] = &results[i]->poseKeypoints;
+                    faceKeypoints[i] = &results[i]->faceKeypoints;
+                    leftHandKeypoints[i] = &results[i]->handKeypoints[0];
+                    rightHandKeypoints[i] = &results[i]->handKeypoints[1];
+                    numberPeople.mutable_at(i) = results[i]->poseKeypoints.getSize(0);
+                }
+                py::dict output;
+                output["pose_keypoints"] = stackKeypoints(poseKeypoints);
+                output["face_keypoints"] = stackKeypoints(faceKeypoints);
+                output["left_hand_keypoints"] = stackKeypoints(leftHandKeypoints);
+                output["right_hand_keypoints"] = stackKeypoints(rightHandKeypoints);
+                output["number_people"] = numberPeople;
+                return output;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return py::dict{};
+            }
+        }
     };
 
     std::vector<std::string> getImagesFromDirectory(const std::string& directoryPath)
@@ -346,6 +512,7 @@ namespace op
             .def("emplaceAndPop", &WrapperPython::emplaceAndPop)
             .def("waitAndEmplace", &WrapperPython::waitAndEmplace)
             .def("waitAndPop", &WrapperPython::waitAndPop)
+            .def("process_batch", &WrapperPython::processBatch, py::arg("images"))
             ;
 
         // ThreadManagerMode
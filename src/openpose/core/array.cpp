@@ -1,4 +1,5 @@
 #include <openpose/core/array.hpp>
+#include <algorithm> // std::max
 #include <typeinfo> // typeid
 #include <numeric> // std::accumulate
 #include <opencv2/core/core.hpp> // cv::Mat
@@ -22,7 +23,7 @@ namespace op
      * std::shared_ptr points to.
      */
     template<typename T>
-    void setCvMatFromPtr(std::pair<bool, Matrix>& cvMatData, T* const dataPtr, const std::vector<int>& sizes)
+    void setCvMatFromPtr(std::pair<bool, Matrix>& cvMatData, T* const dataPtr, const ArrayShape& sizes)
     {
         try
         {
@@ -172,9 +173,18 @@ namespace op
             // Define new size
             auto sizes = array.getSize();
             sizes[0] = 1;
-            // Move --> Temporary Array<T> as long as `array` is in scope
+            // Move --> Temporary Array<T> sharing the memory of `array`
             if (noCopy)
+            {
+                // Writable alias -> The data of `array` cannot be shared with a copy-on-write clone anymore
+                if (array.spImpl->mCopyOnWrite)
+                    array.detach();
                 resetAuxiliary(sizes, array.getPseudoConstPtr() + index*array.getVolume(1));
+                // Aliasing constructor: it keeps the buffer of `array` alive, and later clones of `array` see it as
+                // shared (so they copy it immediately)
+                if (array.spImpl->spData != nullptr)
+                    spImpl->spData = std::shared_ptr<T>(array.spImpl->spData, spImpl->pData);
+            }
             // Copy --> Slower but it will always stay in scope
             else
             {
@@ -183,7 +193,7 @@ namespace op
                 // Copy desired index
                 const auto arrayArea = (int)array.getVolume(1);
                 const auto keypointsIndex = index*arrayArea;
-                std::copy(&array[keypointsIndex], &array[keypointsIndex]+arrayArea, pData);
+                std::copy(&array[keypointsIndex], &array[keypointsIndex]+arrayArea, spImpl->pData);
             }
         }
         catch (const std::exception& e)
@@ -196,9 +206,8 @@ namespace op
     Array<T>::Array(const Array<T>& array) :
         mSize{array.mSize},
         mVolume{array.mVolume},
-        spData{array.spData},
-        pData{array.pData},
-        mCvMatData{array.mCvMatData}
+        mPaddedVolume{array.mPaddedVolume},
+        spImpl{array.spImpl}
     {
     }
 
@@ -209,9 +218,8 @@ namespace op
         {
             mSize = array.mSize;
             mVolume = array.mVolume;
-            spData = array.spData;
-            pData = array.pData;
-            mCvMatData = array.mCvMatData;
+            mPaddedVolume = array.mPaddedVolume;
+            spImpl = array.spImpl;
             // Return
             return *this;
         }
@@ -225,13 +233,12 @@ namespace op
     template<typename T>
     Array<T>::Array(Array<T>&& array) :
         mSize{array.mSize},
-        mVolume{array.mVolume}
+        mVolume{array.mVolume},
+        mPaddedVolume{array.mPaddedVolume}
     {
         try
         {
-            std::swap(spData, array.spData);
-            std::swap(pData, array.pData);
-            std::swap(mCvMatData, array.mCvMatData);
+            std::swap(spImpl, array.spImpl);
         }
         catch (const std::exception& e)
         {
@@ -246,9 +253,8 @@ namespace op
         {
             mSize = array.mSize;
             mVolume = array.mVolume;
-            std::swap(spData, array.spData);
-            std::swap(pData, array.pData);
-            std::swap(mCvMatData, array.mCvMatData);
+            mPaddedVolume = array.mPaddedVolume;
+            std::swap(spImpl, array.spImpl);
             // Return
             return *this;
         }
@@ -264,11 +270,28 @@ namespace op
     {
         try
         {
+            // Own data not shared with any other Array (or only with copy-on-write clones) -> Shared until the first
+            // write of any of them. Plain copies share spImpl, so they do not count here
+            if (spImpl != nullptr && spImpl->spData != nullptr
+                && (spImpl->spData.use_count() == 1 || spImpl->mCopyOnWrite))
+            {
+                spImpl->mCopyOnWrite = true;
+                Array<T> array;
+                array.mSize = mSize;
+                array.mVolume = mVolume;
+                array.mPaddedVolume = mPaddedVolume;
+                array.spImpl->spData = spImpl->spData;
+                array.spImpl->pData = spImpl->pData;
+                array.spImpl->mCvMatData = spImpl->mCvMatData;
+                array.spImpl->mCopyOnWrite = true;
+                return array;
+            }
+            // External memory (it might be modified without notice) or shared with slices -> Deep copy
             // Constructor
-            Array<T> array{mSize};
+            Array<T> array{mSize.toVector()};
             // Clone data
             // Equivalent: std::copy(spData.get(), spData.get() + mVolume, array.spData.get());
-            std::copy(pData, pData + mVolume, array.pData);
+            std::copy(getConstPtr(), getConstPtr() + mVolume, array.spImpl->pData);
             // Return
             return array;
         }
@@ -379,13 +402,16 @@ namespace op
                 std::vector<int> newSize(cvMat.dims(),0);
                 for (auto i = 0u ; i < newSize.size() ; i++)
                     newSize[i] = cvMat.size(i);
+                // Multi-channel matrix (e.g., BGR image) -> Channels as last dimension (as setCvMatFromPtr)
+                if (cvMat.channels() > 1)
+                    newSize.emplace_back(cvMat.channels());
                 // Reset data & volume
                 reset(newSize);
                 // Integrity checks
-                if (!mCvMatData.first || mCvMatData.second.type() != cvMat.type())
+                if (!spImpl->mCvMatData.first || spImpl->mCvMatData.second.type() != cvMat.type())
                     error("Array<T>: T type and cvMat type are different.", __LINE__, __FUNCTION__, __FILE__);
                 // Fill data
-                cvMat.copyTo(mCvMatData.second);
+                cvMat.copyTo(spImpl->mCvMatData.second);
             }
             else
                 reset();
@@ -403,9 +429,12 @@ namespace op
         {
             if (mVolume > 0)
             {
+                // The whole data is overwritten, so no need to copy it
+                if (spImpl->mCopyOnWrite)
+                    detach(false);
                 // OpenCV is efficient on copying (AVX, SSE, etc.)
-                if (mCvMatData.first)
-                    mCvMatData.second.setTo((double)value);
+                if (spImpl->mCvMatData.first)
+                    spImpl->mCvMatData.second.setTo((double)value);
                 else
                     for (auto i = 0u ; i < mVolume ; i++)
                         operator[](i) = value;
@@ -417,32 +446,6 @@ namespace op
         }
     }
 
-    template<typename T>
-    int Array<T>::getSize(const int index) const
-    {
-        try
-        {
-            // Matlab style:
-                // If empty -> return 0
-                // If index >= # dimensions -> return 1
-            if ((unsigned int)index < mSize.size() && 0 <= index)
-                return mSize[index];
-            // Long version:
-            // else if (mSize.empty())
-            //     return 0;
-            // else // if mSize.size() <= (unsigned int)index
-            //     return 1;
-            // Equivalent to:
-            else
-                return (!mSize.empty());
-        }
-        catch (const std::exception& e)
-        {
-            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return 0;
-        }
-    }
-
     template<typename T>
     std::string Array<T>::printSize() const
     {
@@ -485,7 +488,12 @@ namespace op
                 }
             }
             else if (indexA == indexBFinal)
-                return mSize.at(indexA);
+            {
+                if (0 <= indexA && (unsigned int)indexA < mSize.size())
+                    return mSize[indexA];
+                error("Indexes out of dimension.", __LINE__, __FUNCTION__, __FILE__);
+                return 0;
+            }
             else // if (indexA > indexBFinal)
             {
                 error("indexA > indexB.", __LINE__, __FUNCTION__, __FILE__);
@@ -499,6 +507,20 @@ namespace op
         }
     }
 
+    template<typename T>
+    bool Array<T>::isAligned() const
+    {
+        try
+        {
+            return is_aligned(getConstPtr(), ARRAY_ALIGNMENT);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     template<typename T>
     std::vector<int> Array<T>::getStride() const
     {
@@ -539,15 +561,17 @@ namespace op
     {
         try
         {
-            if (!mCvMatData.first)
+            if (spImpl == nullptr)
+                error("Array<T>: Matrix of a moved Array.", __LINE__, __FUNCTION__, __FILE__);
+            if (!spImpl->mCvMatData.first)
                 error("Array<T>: Matrix functions only valid for T types defined by OpenCV: unsigned char,"
                       " signed char, int, float & double", __LINE__, __FUNCTION__, __FILE__);
-            return mCvMatData.second;
+            return spImpl->mCvMatData.second;
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return mCvMatData.second;
+            return spImpl->mCvMatData.second;
         }
     }
 
@@ -556,15 +580,18 @@ namespace op
     {
         try
         {
-            if (!mCvMatData.first)
+            if (spImpl == nullptr)
+                reset();
+            beforeWrite();
+            if (!spImpl->mCvMatData.first)
                 error("Array<T>: Matrix functions only valid for T types defined by OpenCV: unsigned char,"
                       " signed char, int, float & double", __LINE__, __FUNCTION__, __FILE__);
-            return mCvMatData.second;
+            return spImpl->mCvMatData.second;
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return mCvMatData.second;
+            return spImpl->mCvMatData.second;
         }
     }
 
@@ -579,7 +606,7 @@ namespace op
             for (auto i = 0u ; i < mVolume ; i++)
             {
                 // Adding element separated by a space
-                string += std::to_string(pData[i]) + " ";
+                string += std::to_string(spImpl->pData[i]) + " ";
                 // Introduce an enter for each dimension change
                 // If commented, all values will be printed in the same line
                 auto multiplier = 1;
@@ -643,17 +670,17 @@ namespace op
         try
         {
             if (0 <= index && (size_t)index < mVolume)
-                return pData[index]; // spData.get()[index]
+                return spImpl->pData[index]; // spData.get()[index]
             else
             {
                 error("Index out of bounds: 0 <= index && index < mVolume", __LINE__, __FUNCTION__, __FILE__);
-                return pData[0]; // spData.get()[0]
+                return spImpl->pData[0]; // spData.get()[0]
             }
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return pData[0]; // spData.get()[0]
+            return spImpl->pData[0]; // spData.get()[0]
         }
     }
 
@@ -662,41 +689,91 @@ namespace op
     {
         try
         {
+            // Data shared with plain copies -> They keep the previous one
+            if (spImpl == nullptr || spImpl.use_count() > 1)
+                spImpl = std::make_shared<ImplArray>();
+            auto& impl = *spImpl;
             if (!sizes.empty())
             {
                 // New size & volume
+                const auto previousPaddedVolume = (impl.spData != nullptr ? mPaddedVolume : 0ul);
                 mSize = sizes;
                 mVolume = {std::accumulate(sizes.begin(), sizes.end(), std::size_t(1), std::multiplies<size_t>())};
+                // Padded to a multiple of ARRAY_ALIGNMENT bytes, so SIMD kernels need no scalar tail. Sizes with a 0
+                // dimension (e.g., 0 people) still allocate 1 block, as aligned_malloc() rejects 0 bytes
+                const auto elementsPerAlignment = (ARRAY_ALIGNMENT >= sizeof(T) ? ARRAY_ALIGNMENT / sizeof(T) : 1ul);
+                mPaddedVolume = (dataPtr == nullptr
+                    ? (std::max(mVolume, std::size_t(1)) + elementsPerAlignment - 1) / elementsPerAlignment
+                        * elementsPerAlignment
+                    : mVolume);
+                // Same allocation and own memory not shared with other Arrays (e.g., recycled Datum) -> Reuse it. The
+                // alignment check excludes slices (noCopy) that outlived their source
+                if (dataPtr == nullptr && previousPaddedVolume == mPaddedVolume && impl.spData.use_count() == 1
+                    && is_aligned(impl.spData.get(), ARRAY_ALIGNMENT))
+                    impl.pData = impl.spData.get();
                 // Prepare shared_ptr
-                if (dataPtr == nullptr)
+                else if (dataPtr == nullptr)
                 {
-                    #ifdef WITH_AVX
-                        spData = aligned_shared_ptr<T>(mVolume);
-                    #else
-                        spData.reset(new T[mVolume], std::default_delete<T[]>());
-                    #endif
-                    pData = spData.get();
+                    impl.spData = aligned_shared_ptr<T>(mPaddedVolume, ARRAY_ALIGNMENT);
+                    impl.pData = impl.spData.get();
                     // Sanity check
-                    if (pData == nullptr)
+                    if (impl.pData == nullptr)
                         error("Shared pointer could not be allocated for Array data storage.",
                               __LINE__, __FUNCTION__, __FILE__);
+                    #ifndef NDEBUG
+                        if (!isAligned())
+                            error("Array data storage is not aligned to ARRAY_ALIGNMENT bytes.",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                    #endif
                 }
                 else
                 {
-                    spData.reset();
-                    pData = dataPtr;
+                    impl.spData.reset();
+                    impl.pData = dataPtr;
                 }
-                setCvMatFromPtr(mCvMatData, pData, mSize); // spData.get()
+                setCvMatFromPtr(impl.mCvMatData, impl.pData, mSize); // spData.get()
             }
             else
             {
-                mSize = {};
+                mSize = ArrayShape{};
                 mVolume = 0ul;
-                spData.reset();
-                pData = nullptr;
+                mPaddedVolume = 0ul;
+                impl.spData.reset();
+                impl.pData = nullptr;
                 // Matrix available but empty
-                mCvMatData = std::make_pair(true, Matrix());
+                impl.mCvMatData.first = true;
+                if (!impl.mCvMatData.second.empty())
+                    impl.mCvMatData.second = Matrix();
+            }
+            // New buffer, own buffer not shared anymore, or external memory
+            impl.mCopyOnWrite = false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename T>
+    void Array<T>::detach(const bool copyData) const
+    {
+        try
+        {
+            auto& impl = *spImpl;
+            // Still shared with a clone -> New buffer for this Array and its plain copies
+            if (impl.spData.use_count() > 1)
+            {
+                auto spNewData = aligned_shared_ptr<T>(mPaddedVolume, ARRAY_ALIGNMENT);
+                if (spNewData == nullptr)
+                    error("Shared pointer could not be allocated for Array data storage.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (copyData)
+                    std::copy(impl.pData, impl.pData + mVolume, spNewData.get());
+                impl.spData = spNewData;
+                impl.pData = impl.spData.get();
+                setCvMatFromPtr(impl.mCvMatData, impl.pData, mSize); // spData.get()
             }
+            impl.mCopyOnWrite = false;
         }
         catch (const std::exception& e)
         {
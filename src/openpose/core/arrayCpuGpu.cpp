@@ -83,7 +83,7 @@ namespace op
                     // Add 1: arraySize = {1}
                     arraySize.emplace_back(1);
                 // Add {78, 368, 368}: arraySize = {1, 78, 368, 368}
-                for (const auto& sizeI : array.getSize())
+                for (const auto sizeI : array.getShape())
                     arraySize.emplace_back(sizeI);
                 // Construct spImpl
                 spImpl.reset(new ImplArrayCpuGpu{});
@@ -63,6 +63,23 @@ namespace op
     std::vector<Array<float>> CvMatToOpInput::createArray(
         const Matrix& inputData, const std::vector<double>& scaleInputToNetInputs,
         const std::vector<Point<int>>& netInputSizes)
+    {
+        try
+        {
+            std::vector<Array<float>> inputNetData;
+            fillArray(inputNetData, inputData, scaleInputToNetInputs, netInputSizes);
+            return inputNetData;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void CvMatToOpInput::fillArray(
+        std::vector<Array<float>>& inputNetData, const Matrix& inputData,
+        const std::vector<double>& scaleInputToNetInputs, const std::vector<Point<int>>& netInputSizes)
     {
         try
         {
@@ -75,7 +92,7 @@ namespace op
                 error("scaleInputToNetInputs.size() != netInputSizes.size().", __LINE__, __FUNCTION__, __FILE__);
             // inputNetData - Reescale keeping aspect ratio and transform to float the input deep net image
             const auto numberScales = (int)scaleInputToNetInputs.size();
-            std::vector<Array<float>> inputNetData(numberScales);
+            inputNetData.resize(numberScales);
             cv::Mat cvInputData = OP_OP2CVCONSTMAT(inputData);
             for (auto i = 0u ; i < inputNetData.size() ; i++)
             {
@@ -88,7 +105,7 @@ namespace op
                     inputNetData[i].reset({1, 3, netInputSizes.at(i).y, netInputSizes.at(i).x});
                     uCharCvMatToFloatPtr(
                         inputNetData[i].getPtr(), OP_CV2OPMAT(frameWithNetSize),
-                        (mPoseModel == PoseModel::BODY_19N ? 2 : 1));
+                        (mPoseModel == PoseModel::BODY_19N ? 2 : 1), inputNetData[i].getPaddedVolume());
 
                     // // OpenCV equivalent
                     // const auto scale = 1/255.;
@@ -149,12 +166,10 @@ namespace op
                     #endif
                 }
             }
-            return inputNetData;
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return {};
         }
     }
 }
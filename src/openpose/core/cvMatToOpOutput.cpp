@@ -75,6 +75,23 @@ namespace op
 
     Array<float> CvMatToOpOutput::createArray(
          const Matrix& inputData, const double scaleInputToOutput, const Point<int>& outputResolution)
+    {
+        try
+        {
+            Array<float> outputData;
+            fillArray(outputData, inputData, scaleInputToOutput, outputResolution);
+            return outputData;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+
+    void CvMatToOpOutput::fillArray(
+        Array<float>& outputData, const Matrix& inputData, const double scaleInputToOutput,
+        const Point<int>& outputResolution)
     {
         try
         {
@@ -89,15 +106,22 @@ namespace op
             if (outputResolution.x <= 0 || outputResolution.y <= 0)
                 error("Output resolution has 0 area.", __LINE__, __FUNCTION__, __FILE__);
             // outputData - Reescale keeping aspect ratio and transform to float the output image
-            Array<float> outputData({outputResolution.y, outputResolution.x, 3}); // This size is used everywhere
+            outputData.reset({outputResolution.y, outputResolution.x, 3}); // This size is used everywhere
             // CPU version (faster if #Gpus <= 3 and relatively small images)
             if (!mGpuResize)
             {
-                cv::Mat frameWithOutputSize;
-                resizeFixedAspectRatio(frameWithOutputSize, cvInputData, scaleInputToOutput, outputResolution);
                 // Equivalent: frameWithOutputSize.convertTo(outputData.getCvMat(), CV_32FC3);
                 cv::Mat cvOutputData = OP_OP2CVMAT(outputData.getCvMat());
-                frameWithOutputSize.convertTo(cvOutputData, CV_32FC3);
+                // Same size (e.g., default output resolution) -> Converted directly, with no intermediate copy
+                if (scaleInputToOutput == 1. && cvInputData.cols == outputResolution.x
+                    && cvInputData.rows == outputResolution.y)
+                    cvInputData.convertTo(cvOutputData, CV_32FC3);
+                else
+                {
+                    cv::Mat frameWithOutputSize;
+                    resizeFixedAspectRatio(frameWithOutputSize, cvInputData, scaleInputToOutput, outputResolution);
+                    frameWithOutputSize.convertTo(cvOutputData, CV_32FC3);
+                }
             }
             // CUDA version (if #Gpus > 3)
             else
@@ -138,13 +162,10 @@ namespace op
                         __LINE__, __FUNCTION__, __FILE__);
                 #endif
             }
-            // Return result
-            return outputData;
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return Array<float>{};
         }
     }
 }
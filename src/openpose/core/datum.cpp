@@ -7,6 +7,8 @@ namespace op
         id{std::numeric_limits<unsigned long long>::max()},
         subId{0},
         subIdMax{0},
+        expired{false},
+        warmup{false},
         poseIds{-1}
     {
     }
@@ -19,6 +21,9 @@ namespace op
         subIdMax{datum.subIdMax},
         name{datum.name},
         frameNumber{datum.frameNumber},
+        deadline{datum.deadline},
+        expired{datum.expired},
+        warmup{datum.warmup},
         // Input image and rendered version
         cvInputData{datum.cvInputData},
         inputNetData{datum.inputNetData},
@@ -86,6 +91,9 @@ namespace op
             subIdMax = datum.subIdMax;
             name = datum.name;
             frameNumber = datum.frameNumber;
+            deadline = datum.deadline;
+            expired = datum.expired;
+            warmup = datum.warmup;
             // Input image and rendered version
             cvInputData = datum.cvInputData;
             inputNetData = datum.inputNetData;
@@ -154,6 +162,9 @@ namespace op
         subId{datum.subId},
         subIdMax{datum.subIdMax},
         frameNumber{datum.frameNumber},
+        deadline{datum.deadline},
+        expired{datum.expired},
+        warmup{datum.warmup},
         // Other parameters
         scaleInputToOutput{datum.scaleInputToOutput},
         scaleNetToOutput{datum.scaleNetToOutput}
@@ -229,6 +240,9 @@ namespace op
             subIdMax = datum.subIdMax;
             std::swap(name, datum.name);
             frameNumber = datum.frameNumber;
+            deadline = datum.deadline;
+            expired = datum.expired;
+            warmup = datum.warmup;
             // Input image and rendered version
             std::swap(cvInputData, datum.cvInputData);
             std::swap(inputNetData, datum.inputNetData);
@@ -304,6 +318,9 @@ namespace op
             datum.subIdMax = subIdMax;
             datum.name = name;
             datum.frameNumber = frameNumber;
+            datum.deadline = deadline;
+            datum.expired = expired;
+            datum.warmup = warmup;
             // Input image and rendered version
             datum.cvInputData = cvInputData.clone();
             datum.inputNetData.resize(inputNetData.size());
@@ -30,9 +30,10 @@ namespace op
                           __LINE__, __FUNCTION__, __FILE__);
 
                 // Get poseFinalScores
+                const ArrayView<const float> peopleView{peopleArray};
                 auto poseFinalScores = poseScores.clone();
                 for (auto person = 0 ; person < (int)poseFinalScores.getVolume() ; person ++)
-                    poseFinalScores[person] *= std::sqrt(getKeypointsArea(peopleArray, person, 0.05f));
+                    poseFinalScores[person] *= std::sqrt(getKeypointsArea(peopleView, person, 0.05f));
 
                 // Get threshold
                 auto poseScoresSorted = poseFinalScores.clone();
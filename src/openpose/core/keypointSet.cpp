@@ -0,0 +1,387 @@
+#include <openpose/core/keypointSet.hpp>
+#include <cstring> // std::memcpy, std::memset
+#include <openpose/core/datum.hpp>
+#include <openpose_private/utilities/avx.hpp>
+
+namespace op
+{
+    const size_t KEYPOINT_SET_ALIGNMENT = 64;
+
+    size_t getElementSize(const KeypointStorage keypointStorage)
+    {
+        return (keypointStorage == KeypointStorage::Float16 ? sizeof(unsigned short) : sizeof(float));
+    }
+
+    KeypointSet::KeypointSet(const KeypointStorage keypointStorage) :
+        mKeypointStorage{keypointStorage},
+        mNumberPeople{0},
+        mNumberChannels{0},
+        mNumberParts{},
+        mGroupOffsets{},
+        mColumnStride{0ul}
+    {
+    }
+
+    KeypointSet KeypointSet::clone() const
+    {
+        try
+        {
+            KeypointSet keypointSet{*this};
+            if (spData != nullptr)
+            {
+                const auto numberBytes = getNumberBytes();
+                keypointSet.spData = aligned_shared_ptr<unsigned char>(numberBytes, KEYPOINT_SET_ALIGNMENT);
+                std::memcpy(keypointSet.spData.get(), spData.get(), numberBytes);
+            }
+            return keypointSet;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return KeypointSet{mKeypointStorage};
+        }
+    }
+
+    void KeypointSet::reset(
+        const int numberPeople, const std::array<int, NUMBER_GROUPS>& numberParts, const int numberChannels)
+    {
+        try
+        {
+            // Sanity checks
+            if (numberPeople < 0 || numberChannels < 1)
+                error("Invalid number of people (" + std::to_string(numberPeople) + ") or channels ("
+                      + std::to_string(numberChannels) + ").", __LINE__, __FUNCTION__, __FILE__);
+            for (const auto numberGroupParts : numberParts)
+                if (numberGroupParts < 0)
+                    error("Invalid number of parts: " + std::to_string(numberGroupParts) + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+            // Layout: [channel][group][person][part], each channel column padded to KEYPOINT_SET_ALIGNMENT bytes
+            const auto previousNumberBytes = getNumberBytes();
+            mNumberParts = numberParts;
+            mNumberChannels = numberChannels;
+            auto columnSize = 0ul;
+            for (auto group = 0 ; group < NUMBER_GROUPS ; group++)
+            {
+                mGroupOffsets[group] = columnSize;
+                columnSize += (size_t)numberPeople * mNumberParts[group];
+            }
+            mNumberPeople = (columnSize > 0 ? numberPeople : 0);
+            const auto elementsPerAlignment = KEYPOINT_SET_ALIGNMENT / getElementSize(mKeypointStorage);
+            mColumnStride = (columnSize + elementsPerAlignment - 1) / elementsPerAlignment * elementsPerAlignment;
+            // Allocate (or reuse) a single buffer for all groups and channels, initialized to 0
+            const auto numberBytes = getNumberBytes();
+            if (numberBytes == 0)
+                spData.reset();
+            else
+            {
+                if (numberBytes != previousNumberBytes || spData.use_count() != 1)
+                    spData = aligned_shared_ptr<unsigned char>(numberBytes, KEYPOINT_SET_ALIGNMENT);
+                // The bit pattern of 0 is also 0.f in half precision
+                std::memset(spData.get(), 0, numberBytes);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void KeypointSet::setFrom(const std::array<const Array<float>*, NUMBER_GROUPS>& keypointArrays)
+    {
+        try
+        {
+            // Number of people, parts and channels
+            auto numberPeople = 0;
+            auto numberChannels = 0;
+            std::array<int, NUMBER_GROUPS> numberParts{};
+            for (auto group = 0 ; group < NUMBER_GROUPS ; group++)
+            {
+                const auto* const keypoints = keypointArrays[group];
+                if (keypoints != nullptr && !keypoints->empty())
+                {
+                    if (keypoints->getNumberDimensions() != 3)
+                        error("Keypoint Arrays must be {people x parts x channels}.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    if (numberChannels == 0)
+                    {
+                        numberPeople = keypoints->getSize(0);
+                        numberChannels = keypoints->getSize(2);
+                    }
+                    else if (numberPeople != keypoints->getSize(0) || numberChannels != keypoints->getSize(2))
+                        error("All keypoint Arrays must have the same number of people and channels.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    numberParts[group] = keypoints->getSize(1);
+                }
+            }
+            if (numberChannels == 0)
+            {
+                reset(0, numberParts);
+                return;
+            }
+            reset(numberPeople, numberParts, numberChannels);
+            // De-interleave each group into its columns
+            for (auto group = 0 ; group < NUMBER_GROUPS ; group++)
+            {
+                if (numberParts[group] > 0)
+                {
+                    const auto* const keypointsPtr = keypointArrays[group]->getConstPtr();
+                    const auto numberElements = (size_t)numberPeople * numberParts[group];
+                    for (auto channel = 0 ; channel < numberChannels ; channel++)
+                    {
+                        const auto elementIndex = getElementIndex((KeypointGroup)group, 0, 0, channel);
+                        if (mKeypointStorage == KeypointStorage::Float16)
+                        {
+                            auto* const columnPtr = (unsigned short*)spData.get() + elementIndex;
+                            for (auto i = 0ul ; i < numberElements ; i++)
+                                columnPtr[i] = floatToHalf(keypointsPtr[i*numberChannels + channel]);
+                        }
+                        else
+                        {
+                            auto* const columnPtr = (float*)spData.get() + elementIndex;
+                            for (auto i = 0ul ; i < numberElements ; i++)
+                                columnPtr[i] = keypointsPtr[i*numberChannels + channel];
+                        }
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void KeypointSet::setFrom(const Datum& datum, const bool threeD)
+    {
+        try
+        {
+            if (threeD)
+                setFrom({&datum.poseKeypoints3D, &datum.faceKeypoints3D, &datum.handKeypoints3D[0],
+                         &datum.handKeypoints3D[1]});
+            else
+                setFrom({&datum.poseKeypoints, &datum.faceKeypoints, &datum.handKeypoints[0],
+                         &datum.handKeypoints[1]});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void KeypointSet::toArray(Array<float>& keypoints, const KeypointGroup keypointGroup) const
+    {
+        try
+        {
+            const auto numberParts = mNumberParts[(int)keypointGroup];
+            if (mNumberPeople == 0 || numberParts == 0)
+            {
+                keypoints.reset();
+                return;
+            }
+            keypoints.reset({mNumberPeople, numberParts, mNumberChannels});
+            // Interleave the columns
+            auto* const keypointsPtr = keypoints.getPtr();
+            const auto numberElements = (size_t)mNumberPeople * numberParts;
+            for (auto channel = 0 ; channel < mNumberChannels ; channel++)
+            {
+                const auto elementIndex = getElementIndex(keypointGroup, 0, 0, channel);
+                if (mKeypointStorage == KeypointStorage::Float16)
+                {
+                    const auto* const columnPtr = (const unsigned short*)spData.get() + elementIndex;
+                    for (auto i = 0ul ; i < numberElements ; i++)
+                        keypointsPtr[i*mNumberChannels + channel] = halfToFloat(columnPtr[i]);
+                }
+                else
+                {
+                    const auto* const columnPtr = (const float*)spData.get() + elementIndex;
+                    for (auto i = 0ul ; i < numberElements ; i++)
+                        keypointsPtr[i*mNumberChannels + channel] = columnPtr[i];
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    Array<float> KeypointSet::toArray(const KeypointGroup keypointGroup) const
+    {
+        try
+        {
+            Array<float> keypoints;
+            toArray(keypoints, keypointGroup);
+            return keypoints;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+
+    void KeypointSet::copyTo(Datum& datum, const bool threeD) const
+    {
+        try
+        {
+            if (threeD)
+            {
+                toArray(datum.poseKeypoints3D, KeypointGroup::Pose);
+                toArray(datum.faceKeypoints3D, KeypointGroup::Face);
+                toArray(datum.handKeypoints3D[0], KeypointGroup::LeftHand);
+                toArray(datum.handKeypoints3D[1], KeypointGroup::RightHand);
+            }
+            else
+            {
+                toArray(datum.poseKeypoints, KeypointGroup::Pose);
+                toArray(datum.faceKeypoints, KeypointGroup::Face);
+                toArray(datum.handKeypoints[0], KeypointGroup::LeftHand);
+                toArray(datum.handKeypoints[1], KeypointGroup::RightHand);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    size_t KeypointSet::getNumberBytes() const
+    {
+        return mColumnStride * mNumberChannels * getElementSize(mKeypointStorage);
+    }
+
+    float* KeypointSet::getColumn(const KeypointGroup keypointGroup, const int channel)
+    {
+        try
+        {
+            checkColumn(keypointGroup, channel, KeypointStorage::Float32);
+            return (float*)spData.get() + getElementIndex(keypointGroup, 0, 0, channel);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    const float* KeypointSet::getConstColumn(const KeypointGroup keypointGroup, const int channel) const
+    {
+        try
+        {
+            checkColumn(keypointGroup, channel, KeypointStorage::Float32);
+            return (const float*)spData.get() + getElementIndex(keypointGroup, 0, 0, channel);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    unsigned short* KeypointSet::getHalfColumn(const KeypointGroup keypointGroup, const int channel)
+    {
+        try
+        {
+            checkColumn(keypointGroup, channel, KeypointStorage::Float16);
+            return (unsigned short*)spData.get() + getElementIndex(keypointGroup, 0, 0, channel);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    const unsigned short* KeypointSet::getConstHalfColumn(const KeypointGroup keypointGroup, const int channel) const
+    {
+        try
+        {
+            checkColumn(keypointGroup, channel, KeypointStorage::Float16);
+            return (const unsigned short*)spData.get() + getElementIndex(keypointGroup, 0, 0, channel);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void KeypointSet::checkColumn(
+        const KeypointGroup keypointGroup, const int channel, const KeypointStorage keypointStorage) const
+    {
+        if (mKeypointStorage != keypointStorage)
+            error("This KeypointSet column type does not match its KeypointStorage.",
+                  __LINE__, __FUNCTION__, __FILE__);
+        if ((unsigned int)keypointGroup >= (unsigned int)NUMBER_GROUPS || channel < 0 || channel >= mNumberChannels)
+            error("Keypoint group or channel out of range.", __LINE__, __FUNCTION__, __FILE__);
+    }
+
+    unsigned short floatToHalf(const float value)
+    {
+        unsigned int bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        const auto sign = (unsigned short)((bits >> 16) & 0x8000u);
+        const auto absBits = bits & 0x7fffffffu;
+        // Infinity or NaN
+        if (absBits >= 0x7f800000u)
+            return (unsigned short)(sign | 0x7c00u | (absBits > 0x7f800000u ? 0x200u : 0u));
+        // Overflow (>= 65520 rounds to infinity)
+        if (absBits >= 0x477ff000u)
+            return (unsigned short)(sign | 0x7c00u);
+        // Normal
+        if (absBits >= 0x38800000u)
+        {
+            auto half = (absBits - 0x38000000u) >> 13;
+            const auto remainder = absBits & 0x1fffu;
+            if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+                half++;
+            return (unsigned short)(sign | half);
+        }
+        // Too small (< 2^-25) -> 0
+        if (absBits < 0x33000000u)
+            return sign;
+        // Subnormal
+        const auto mantissa = (absBits & 0x7fffffu) | 0x800000u;
+        const auto shift = 126u - (absBits >> 23);
+        auto half = mantissa >> shift;
+        const auto remainder = mantissa & ((1u << shift) - 1u);
+        const auto halfway = 1u << (shift - 1u);
+        if (remainder > halfway || (remainder == halfway && (half & 1u)))
+            half++;
+        return (unsigned short)(sign | half);
+    }
+
+    float halfToFloat(const unsigned short value)
+    {
+        const auto sign = (unsigned int)(value & 0x8000u) << 16;
+        auto exponent = (value >> 10) & 0x1fu;
+        auto mantissa = value & 0x3ffu;
+        unsigned int bits;
+        // Zero or subnormal
+        if (exponent == 0u)
+        {
+            if (mantissa == 0u)
+                bits = sign;
+            else
+            {
+                // Normalize it
+                exponent = 113u;
+                while (!(mantissa & 0x400u))
+                {
+                    mantissa <<= 1;
+                    exponent--;
+                }
+                bits = sign | (exponent << 23) | ((mantissa & 0x3ffu) << 13);
+            }
+        }
+        // Infinity or NaN
+        else if (exponent == 0x1fu)
+            bits = sign | 0x7f800000u | (mantissa << 13);
+        // Normal
+        else
+            bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+}
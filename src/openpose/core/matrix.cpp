@@ -1,12 +1,41 @@
 #include <openpose/core/matrix.hpp>
+#include <atomic>
 #include <opencv2/core/core.hpp> // cv::Mat
 #include <openpose/utilities/errorAndLog.hpp>
 
 namespace op
 {
+    // Number of cv::Mat sharing the data of cvMat, or 0 if it does not own it (e.g., external or Array<T> memory)
+    int getReferenceCount(const cv::Mat& cvMat)
+    {
+        #if CV_MAJOR_VERSION < 3
+            return (cvMat.refcount == nullptr ? 0 : *cvMat.refcount);
+        #else
+            return (cvMat.u == nullptr ? 0 : cvMat.u->refcount);
+        #endif
+    }
+
     struct Matrix::ImplMatrix
     {
         cv::Mat mCvMat;
+        // Whether mCvMat might share its data with a copy-on-write clone (see Matrix::clone())
+        std::atomic<bool> mCopyOnWrite{false};
+
+        // Write barrier: if the data is still shared with a clone, it gets its own copy of it
+        void detach(const bool copyData = true)
+        {
+            if (mCopyOnWrite)
+            {
+                if (getReferenceCount(mCvMat) > 1)
+                {
+                    if (copyData)
+                        mCvMat = mCvMat.clone();
+                    else
+                        mCvMat = cv::Mat(mCvMat.dims, mCvMat.size.p, mCvMat.type());
+                }
+                mCopyOnWrite = false;
+            }
+        }
     };
 
     void Matrix::splitCvMatIntoVectorMatrix(std::vector<Matrix>& matrixesResized, const void* const cvMatPtr)
@@ -85,7 +114,18 @@ namespace op
         try
         {
             Matrix matrix;
-            matrix.spImpl->mCvMat = spImpl->mCvMat.clone();
+            // Own data not shared with any other cv::Mat (or only with copy-on-write clones) -> Shared until the first
+            // write of any of them
+            const auto referenceCount = getReferenceCount(spImpl->mCvMat);
+            if (referenceCount == 1 || (referenceCount > 1 && spImpl->mCopyOnWrite))
+            {
+                spImpl->mCopyOnWrite = true;
+                matrix.spImpl->mCvMat = spImpl->mCvMat;
+                matrix.spImpl->mCopyOnWrite = true;
+            }
+            // External memory (it might be modified without notice) or shared with other cv::Mat -> Deep copy
+            else
+                matrix.spImpl->mCvMat = spImpl->mCvMat.clone();
             return matrix;
         }
         catch (const std::exception& e)
@@ -99,6 +139,7 @@ namespace op
     {
         try
         {
+            spImpl->detach();
             return (void*)(&spImpl->mCvMat);
         }
         catch (const std::exception& e)
@@ -125,6 +166,7 @@ namespace op
     {
         try
         {
+            spImpl->detach();
             return spImpl->mCvMat.data;
         }
         catch (const std::exception& e)
@@ -374,6 +416,8 @@ namespace op
     {
         try
         {
+            // The whole data is overwritten, so no need to copy it
+            spImpl->detach(false);
             spImpl->mCvMat.setTo(value);
         }
         catch (const std::exception& e)
@@ -386,6 +430,8 @@ namespace op
     {
         try
         {
+            // The whole data is overwritten, so no need to copy it
+            outputMat.spImpl->detach(false);
             spImpl->mCvMat.copyTo(outputMat.spImpl->mCvMat);
         }
         catch (const std::exception& e)
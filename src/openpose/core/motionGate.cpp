@@ -0,0 +1,393 @@
+#include <openpose/core/motionGate.hpp>
+#include <map>
+#include <mutex>
+#include <set>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose_private/utilities/openCvMultiversionHeaders.hpp>
+
+namespace op
+{
+    MotionGateStatistics::MotionGateStatistics() :
+        numberFrames{0ull},
+        numberSkippedFrames{0ull},
+        numberUnfilledFrames{0ull},
+        lastDifference{-1.}
+    {
+    }
+
+    struct MotionGateReference
+    {
+        Array<float> poseKeypoints;
+        Array<float> poseScores;
+        bool ready;
+        bool expired;
+        bool isCurrent;
+        int pendingSkippedFrames;
+    };
+
+    struct MotionGate::ImplMotionGate
+    {
+        const double mThreshold;
+        const int mMaxSkippedFrames;
+        const int mThumbnailWidth;
+        const bool mDeferFrames;
+        mutable std::mutex mMutex;
+        bool mStopped;
+        cv::Mat mThumbnailReference;
+        unsigned long long mReferenceId;
+        int mConsecutiveSkippedFrames;
+        // Processed frames (references) and skipped frames (with the reference they depend on)
+        std::map<unsigned long long, MotionGateReference> mReferences;
+        std::map<unsigned long long, unsigned long long> mSkippedFrames;
+        // Skipped frames (also in mSkippedFrames) whose results are filled after the GPU threads
+        std::set<unsigned long long> mDeferredFrames;
+        // Statistics
+        unsigned long long mNumberFrames;
+        unsigned long long mNumberSkippedFrames;
+        unsigned long long mNumberUnfilledFrames;
+        double mLastDifference;
+
+        ImplMotionGate(const double threshold, const int maxSkippedFrames, const int thumbnailWidth,
+                       const bool deferFrames) :
+            mThreshold{threshold},
+            mMaxSkippedFrames{maxSkippedFrames},
+            mThumbnailWidth{thumbnailWidth},
+            mDeferFrames{deferFrames},
+            mStopped{false},
+            mReferenceId{0ull},
+            mConsecutiveSkippedFrames{0},
+            mNumberFrames{0ull},
+            mNumberSkippedFrames{0ull},
+            mNumberUnfilledFrames{0ull},
+            mLastDifference{-1.}
+        {
+        }
+
+        // Not thread-safe, mMutex must be locked
+        void eraseIfUnused(const unsigned long long referenceId)
+        {
+            const auto reference = mReferences.find(referenceId);
+            if (reference != mReferences.end() && reference->second.ready && !reference->second.isCurrent
+                && reference->second.pendingSkippedFrames == 0)
+                mReferences.erase(reference);
+        }
+
+        // Not thread-safe, mMutex must be locked
+        bool releaseSkippedFrame(const std::map<unsigned long long, unsigned long long>::iterator& skippedFrame)
+        {
+            const auto referenceId = skippedFrame->second;
+            mSkippedFrames.erase(skippedFrame);
+            auto& reference = mReferences[referenceId];
+            const auto filled = (reference.ready && !reference.expired);
+            if (!filled)
+            {
+                mNumberSkippedFrames--;
+                mNumberUnfilledFrames++;
+            }
+            reference.pendingSkippedFrames--;
+            eraseIfUnused(referenceId);
+            return filled;
+        }
+    };
+
+    MotionGate::MotionGate(const double threshold, const int maxSkippedFrames, const int thumbnailWidth,
+                           const bool deferFrames) :
+        spImpl{std::make_shared<ImplMotionGate>(threshold, maxSkippedFrames, thumbnailWidth, deferFrames)}
+    {
+        try
+        {
+            // Sanity checks
+            if (threshold < 0.)
+                error("The motion threshold must be non-negative.", __LINE__, __FUNCTION__, __FILE__);
+            if (thumbnailWidth < 1)
+                error("The thumbnail width must be positive.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    MotionGate::~MotionGate()
+    {
+        try
+        {
+            if (spImpl->mNumberFrames > 0)
+                opLog("Motion gate: " + std::to_string(spImpl->mNumberSkippedFrames) + " out of "
+                      + std::to_string(spImpl->mNumberFrames) + " frames skipped ("
+                      + std::to_string(100. * spImpl->mNumberSkippedFrames / spImpl->mNumberFrames) + "%).",
+                      Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool MotionGate::checkSkip(const Matrix& cvInputData, const unsigned long long id)
+    {
+        try
+        {
+            // Grayscale thumbnail
+            const cv::Mat cvMatInput = OP_OP2CVCONSTMAT(cvInputData);
+            if (cvMatInput.empty())
+                return false;
+            cv::Mat thumbnail;
+            const cv::Size thumbnailSize{
+                spImpl->mThumbnailWidth,
+                fastMax(1, positiveIntRound(spImpl->mThumbnailWidth * cvMatInput.rows / double(cvMatInput.cols)))};
+            cv::resize(cvMatInput, thumbnail, thumbnailSize, 0, 0, cv::INTER_AREA);
+            if (thumbnail.channels() == 3)
+                cv::cvtColor(thumbnail, thumbnail, CV_BGR2GRAY);
+            // Mean absolute difference with the last processed frame
+            const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+            spImpl->mNumberFrames++;
+            spImpl->mLastDifference = (spImpl->mThumbnailReference.size() == thumbnail.size()
+                ? cv::norm(thumbnail, spImpl->mThumbnailReference, cv::NORM_L1) / thumbnail.total() : -1.);
+            // Skip frame
+            if (!spImpl->mStopped && spImpl->mLastDifference >= 0. && spImpl->mLastDifference <= spImpl->mThreshold
+                && spImpl->mConsecutiveSkippedFrames < spImpl->mMaxSkippedFrames)
+            {
+                spImpl->mConsecutiveSkippedFrames++;
+                spImpl->mNumberSkippedFrames++;
+                spImpl->mSkippedFrames[id] = spImpl->mReferenceId;
+                spImpl->mReferences[spImpl->mReferenceId].pendingSkippedFrames++;
+                return true;
+            }
+            // Process frame (new reference)
+            if (!spImpl->mReferences.empty())
+            {
+                spImpl->mReferences[spImpl->mReferenceId].isCurrent = false;
+                spImpl->eraseIfUnused(spImpl->mReferenceId);
+            }
+            spImpl->mThumbnailReference = thumbnail;
+            spImpl->mReferenceId = id;
+            spImpl->mReferences[id] = MotionGateReference{Array<float>{}, Array<float>{}, false, false, true, 0};
+            spImpl->mConsecutiveSkippedFrames = 0;
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    bool MotionGate::isSkipped(const unsigned long long id) const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+            return spImpl->mSkippedFrames.count(id) > 0;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void MotionGate::setResults(const unsigned long long id, const Array<float>& poseKeypoints,
+                                const Array<float>& poseScores)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+            const auto reference = spImpl->mReferences.find(id);
+            if (reference == spImpl->mReferences.end())
+                return;
+            reference->second.poseKeypoints = poseKeypoints.clone();
+            reference->second.poseScores = poseScores.clone();
+            reference->second.ready = true;
+            spImpl->eraseIfUnused(id);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool MotionGate::getResults(
+        const unsigned long long id, Array<float>& poseKeypoints, Array<float>& poseScores)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+            const auto skippedFrame = spImpl->mSkippedFrames.find(id);
+            if (skippedFrame == spImpl->mSkippedFrames.end())
+                return false;
+            // Reference frame still being processed (e.g., by another GPU) -> Deferred rather than waiting for it,
+            // so this GPU thread keeps working (unless stopped, since it might never be processed)
+            const auto& reference = spImpl->mReferences[skippedFrame->second];
+            if (!reference.ready && spImpl->mDeferFrames && !spImpl->mStopped)
+            {
+                spImpl->mDeferredFrames.emplace(id);
+                poseKeypoints.reset();
+                poseScores.reset();
+                return true;
+            }
+            if (reference.ready && !reference.expired)
+            {
+                poseKeypoints = reference.poseKeypoints.clone();
+                poseScores = reference.poseScores.clone();
+            }
+            return spImpl->releaseSkippedFrame(skippedFrame);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    bool MotionGate::isDeferred(const unsigned long long id) const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+            return spImpl->mDeferredFrames.count(id) > 0;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    bool MotionGate::endDeferred(const unsigned long long id)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+            if (spImpl->mDeferredFrames.erase(id) == 0)
+                return false;
+            return spImpl->releaseSkippedFrame(spImpl->mSkippedFrames.find(id));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void MotionGate::setExpired(const unsigned long long id)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+            // Skipped frame -> It no longer needs the results of its reference
+            const auto skippedFrame = spImpl->mSkippedFrames.find(id);
+            if (skippedFrame != spImpl->mSkippedFrames.end())
+            {
+                const auto referenceId = skippedFrame->second;
+                spImpl->mSkippedFrames.erase(skippedFrame);
+                spImpl->mDeferredFrames.erase(id);
+                spImpl->mReferences[referenceId].pendingSkippedFrames--;
+                spImpl->eraseIfUnused(referenceId);
+                return;
+            }
+            // Processed frame -> Its results will never be available
+            const auto reference = spImpl->mReferences.find(id);
+            if (reference == spImpl->mReferences.end())
+                return;
+            // Skipped frames that did not reach the body network yet -> They will run it
+            // (Deferred ones already skipped it, endDeferred() will find their reference expired)
+            for (auto frame = spImpl->mSkippedFrames.begin() ; frame != spImpl->mSkippedFrames.end() ; )
+            {
+                if (frame->second == id && spImpl->mDeferredFrames.count(frame->first) == 0)
+                {
+                    frame = spImpl->mSkippedFrames.erase(frame);
+                    reference->second.pendingSkippedFrames--;
+                    spImpl->mNumberSkippedFrames--;
+                    spImpl->mNumberUnfilledFrames++;
+                }
+                else
+                    ++frame;
+            }
+            reference->second.ready = true;
+            reference->second.expired = true;
+            // No valid reference thumbnail -> The next frame is processed
+            if (reference->second.isCurrent)
+                spImpl->mThumbnailReference = cv::Mat{};
+            spImpl->eraseIfUnused(id);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void MotionGate::stop()
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+            spImpl->mStopped = true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    MotionGateStatistics MotionGate::getStatistics() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+            MotionGateStatistics motionGateStatistics;
+            motionGateStatistics.numberFrames = spImpl->mNumberFrames;
+            motionGateStatistics.numberSkippedFrames = spImpl->mNumberSkippedFrames;
+            motionGateStatistics.numberUnfilledFrames = spImpl->mNumberUnfilledFrames;
+            motionGateStatistics.lastDifference = spImpl->mLastDifference;
+            return motionGateStatistics;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return MotionGateStatistics{};
+        }
+    }
+
+    unsigned long long MotionGate::getNumberFrames() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+            return spImpl->mNumberFrames;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    unsigned long long MotionGate::getNumberSkippedFrames() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+            return spImpl->mNumberSkippedFrames;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    double MotionGate::getLastDifference() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+            return spImpl->mLastDifference;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1.;
+        }
+    }
+}
@@ -0,0 +1,191 @@
+#include <openpose/core/netResolutionController.hpp>
+#include <algorithm> // std::sort, std::unique
+#include <atomic>
+#include <chrono>
+#include <functional> // std::greater
+#include <iterator> // std::next
+#include <map>
+#include <mutex>
+#include <openpose/utilities/fastMath.hpp>
+
+namespace op
+{
+    // Default resolutions, relative to the highest one
+    const std::vector<double> DEFAULT_HEIGHT_RATIOS{1., 0.875, 0.75, 0.625, 0.5};
+    // Smoothing factor of the latency exponential moving average
+    const auto LATENCY_SMOOTHING = 0.2;
+    // Consecutive frames over budget before moving to a lower resolution
+    const auto FRAMES_TO_DECREASE = 3;
+    // Consecutive frames (extrapolated) under budget before moving to a higher resolution
+    const auto FRAMES_TO_INCREASE = 30;
+    // Margin applied to the budget when extrapolating the latency to the next higher resolution
+    const auto INCREASE_MARGIN = 0.9;
+
+    struct NetResolutionController::ImplNetResolutionController
+    {
+        const double mLatencyBudget;
+        std::vector<int> mNetInputHeights;
+        std::mutex mMutex;
+        std::atomic<int> mIndex;
+        std::map<unsigned long long, std::pair<std::chrono::high_resolution_clock::time_point, int>> mStartTimes;
+        double mLatency;
+        int mFramesToSkip;
+        int mFramesOverBudget;
+        int mFramesUnderBudget;
+
+        ImplNetResolutionController(const double latencyBudget) :
+            mLatencyBudget{latencyBudget},
+            mIndex{0},
+            mLatency{-1.},
+            mFramesToSkip{1},
+            mFramesOverBudget{0},
+            mFramesUnderBudget{0}
+        {
+        }
+
+        void setIndex(const int index)
+        {
+            mIndex = index;
+            mLatency = -1.;
+            mFramesToSkip = 1;
+            mFramesOverBudget = 0;
+            mFramesUnderBudget = 0;
+            opLog("Net input height changed to " + std::to_string(mNetInputHeights[index]) + ".",
+                  Priority::Normal);
+        }
+    };
+
+    NetResolutionController::NetResolutionController(const int netInputHeight, const double latencyBudget,
+                                                     const std::vector<int>& netInputHeights) :
+        spImpl{std::make_shared<ImplNetResolutionController>(latencyBudget)}
+    {
+        try
+        {
+            // Sanity checks
+            if (latencyBudget <= 0.)
+                error("The latency budget must be strictly positive.", __LINE__, __FUNCTION__, __FILE__);
+            // Set resolutions (sorted from highest to lowest)
+            if (netInputHeights.empty())
+            {
+                if (netInputHeight <= 0)
+                    error("The net input height must be positive in order to use the latency-driven net resolution"
+                          " (i.e., use `--net_resolution -1xH` or `WxH`).", __LINE__, __FUNCTION__, __FILE__);
+                for (const auto ratio : DEFAULT_HEIGHT_RATIOS)
+                    spImpl->mNetInputHeights.emplace_back(fastMax(16, positiveIntRound(netInputHeight*ratio/16.)*16));
+            }
+            else
+                spImpl->mNetInputHeights = netInputHeights;
+            for (const auto height : spImpl->mNetInputHeights)
+                if (height <= 0 || height % 16 != 0)
+                    error("Net input heights must be positive multiples of 16.", __LINE__, __FUNCTION__, __FILE__);
+            std::sort(spImpl->mNetInputHeights.begin(), spImpl->mNetInputHeights.end(), std::greater<int>());
+            spImpl->mNetInputHeights.erase(
+                std::unique(spImpl->mNetInputHeights.begin(), spImpl->mNetInputHeights.end()),
+                spImpl->mNetInputHeights.end());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    NetResolutionController::~NetResolutionController()
+    {
+    }
+
+    int NetResolutionController::getNetInputHeight() const
+    {
+        try
+        {
+            return spImpl->mNetInputHeights[spImpl->mIndex];
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1;
+        }
+    }
+
+    double NetResolutionController::getLatency() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+            return spImpl->mLatency;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1.;
+        }
+    }
+
+    void NetResolutionController::frameStarted(const unsigned long long id)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+            spImpl->mStartTimes[id] = std::make_pair(
+                std::chrono::high_resolution_clock::now(), spImpl->mIndex.load());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void NetResolutionController::frameFinished(const unsigned long long id)
+    {
+        try
+        {
+            const auto now = std::chrono::high_resolution_clock::now();
+            const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+            const auto startTime = spImpl->mStartTimes.find(id);
+            if (startTime == spImpl->mStartTimes.end())
+                return;
+            const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+                now - startTime->second.first).count() * 1e-3;
+            const auto index = startTime->second.second;
+            // Frames are finished in order, so older frames (e.g., dropped ones) will never finish
+            spImpl->mStartTimes.erase(spImpl->mStartTimes.begin(), std::next(startTime));
+            // Ignore frames started with other resolution or used to reshape the network
+            if (index != spImpl->mIndex)
+                return;
+            if (spImpl->mFramesToSkip > 0)
+            {
+                spImpl->mFramesToSkip--;
+                return;
+            }
+            // Smoothed latency
+            spImpl->mLatency = (spImpl->mLatency < 0.
+                ? latency : (1.-LATENCY_SMOOTHING)*spImpl->mLatency + LATENCY_SMOOTHING*latency);
+            // Over budget --> Lower resolution
+            if (spImpl->mLatency > spImpl->mLatencyBudget)
+            {
+                spImpl->mFramesUnderBudget = 0;
+                if (++spImpl->mFramesOverBudget >= FRAMES_TO_DECREASE
+                    && index + 1 < (int)spImpl->mNetInputHeights.size())
+                    spImpl->setIndex(index + 1);
+            }
+            // Higher resolution also under budget (latency roughly proportional to the net input area)
+            else if (index > 0)
+            {
+                spImpl->mFramesOverBudget = 0;
+                const auto ratio = spImpl->mNetInputHeights[index-1] / double(spImpl->mNetInputHeights[index]);
+                if (spImpl->mLatency * ratio * ratio <= INCREASE_MARGIN * spImpl->mLatencyBudget)
+                {
+                    if (++spImpl->mFramesUnderBudget >= FRAMES_TO_INCREASE)
+                        spImpl->setIndex(index - 1);
+                }
+                else
+                    spImpl->mFramesUnderBudget = 0;
+            }
+            else
+                spImpl->mFramesOverBudget = 0;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
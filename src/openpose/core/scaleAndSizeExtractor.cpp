@@ -6,12 +6,13 @@ namespace op
 {
     ScaleAndSizeExtractor::ScaleAndSizeExtractor(const Point<int>& netInputResolution,
         const float netInputResolutionDynamicBehavior, const Point<int>& outputResolution, const int scaleNumber,
-        const double scaleGap) :
+        const double scaleGap, const std::shared_ptr<NetResolutionController>& netResolutionController) :
         mNetInputResolution{netInputResolution},
         mNetInputResolutionDynamicBehavior{netInputResolutionDynamicBehavior},
         mOutputSize{outputResolution},
         mScaleNumber{scaleNumber},
-        mScaleGap{scaleGap}
+        mScaleGap{scaleGap},
+        spNetResolutionController{netResolutionController}
     {
         try
         {
@@ -44,6 +45,15 @@ namespace op
                 error("Wrong input element (empty cvInputData).", __LINE__, __FUNCTION__, __FILE__);
             // Set poseNetInputSize
             auto poseNetInputSize = mNetInputResolution;
+            // Latency-driven net input height (width scaled accordingly if fixed)
+            if (spNetResolutionController != nullptr && poseNetInputSize.y > 0)
+            {
+                const auto netInputHeight = spNetResolutionController->getNetInputHeight();
+                if (poseNetInputSize.x > 0)
+                    poseNetInputSize.x = 16 * fastMax(
+                        1, positiveIntRound(poseNetInputSize.x * netInputHeight / (16.f * poseNetInputSize.y)));
+                poseNetInputSize.y = netInputHeight;
+            }
             if (poseNetInputSize.x <= 0 || poseNetInputSize.y <= 0)
             {
                 // Sanity check
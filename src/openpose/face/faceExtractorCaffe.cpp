@@ -243,7 +243,8 @@ namespace op
                                            cv::BORDER_CONSTANT, cv::Scalar(0,0,0));
 
                             // cv::Mat -> float*
-                            uCharCvMatToFloatPtr(mFaceImageCrop.getPtr(), OP_CV2OPMAT(faceImage), true);
+                            uCharCvMatToFloatPtr(mFaceImageCrop.getPtr(), OP_CV2OPMAT(faceImage), true,
+                                                 mFaceImageCrop.getPaddedVolume());
 
                             // // Debugging
                             // if (person < 5)
@@ -18,7 +18,7 @@ namespace op
     }
 
     void addKeypointsToJson(
-        JsonOfstream& jsonOfstream, const std::vector<std::pair<Array<float>, std::string>>& keypointVector)
+        JsonOfstream& jsonOfstream, const std::vector<std::pair<ArrayView<const float>, std::string>>& keypointVector)
     {
         try
         {
@@ -189,7 +189,7 @@ namespace op
             const auto numberDimensions = (float)(array.getNumberDimensions());
             outputFile.write((char*)&numberDimensions, sizeof(float));
             // Save dimensions
-            for (const auto& sizeI : array.getSize())
+            for (const auto sizeI : array.getShape())
             {
                 const float sizeIFloat = (float) sizeI;
                 outputFile.write((char*)&sizeIFloat, sizeof(float));
@@ -307,6 +307,25 @@ namespace op
         const std::vector<std::pair<Array<float>, std::string>>& keypointVector,
         const std::vector<std::vector<std::array<float,3>>>& candidates, const std::string& fileName,
         const bool humanReadable)
+    {
+        try
+        {
+            std::vector<std::pair<ArrayView<const float>, std::string>> keypointViewVector;
+            keypointViewVector.reserve(keypointVector.size());
+            for (const auto& keypointPair : keypointVector)
+                keypointViewVector.emplace_back(ArrayView<const float>{keypointPair.first}, keypointPair.second);
+            savePeopleJson(keypointViewVector, candidates, fileName, humanReadable);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void savePeopleJson(
+        const std::vector<std::pair<ArrayView<const float>, std::string>>& keypointVector,
+        const std::vector<std::vector<std::array<float,3>>>& candidates, const std::string& fileName,
+        const bool humanReadable)
     {
         try
         {
@@ -28,4 +28,21 @@ namespace op
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
+
+    void PeopleJsonSaver::save(
+        const std::vector<std::pair<ArrayView<const float>, std::string>>& keypointVector,
+        const std::vector<std::vector<std::array<float,3>>>& candidates, const std::string& fileName,
+        const bool humanReadable) const
+    {
+        try
+        {
+            // Record json
+            const auto finalFileName = getNextFileName(fileName) + ".json";
+            savePeopleJson(keypointVector, candidates, finalFileName, humanReadable);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
@@ -1,5 +1,9 @@
 #include <openpose/gpu/gpu.hpp>
 #ifdef USE_CUDA
+    #include <algorithm> // std::transform
+    #include <cctype> // std::tolower
+    #include <fstream>
+    #include <cuda_runtime.h>
     #include <openpose/gpu/cuda.hpp>
 #endif
 #ifdef USE_OPENCL
@@ -47,4 +51,37 @@ namespace op
             return GpuMode::NoGpu;
         }
     }
+
+    int getGpuNumaNode(const int gpuId)
+    {
+        try
+        {
+            #if defined USE_CUDA && defined __linux__
+                // E.g., "0000:3B:00.0", which sysfs writes in lower case
+                char pciBusId[32];
+                if (cudaDeviceGetPCIBusId(pciBusId, sizeof(pciBusId), gpuId) != cudaSuccess)
+                {
+                    // Clear the error so it is not reported by the next cudaCheck()
+                    cudaGetLastError();
+                    return -1;
+                }
+                std::string pciBusIdString{pciBusId};
+                std::transform(pciBusIdString.begin(), pciBusIdString.end(), pciBusIdString.begin(),
+                               [](const unsigned char c){ return (char)std::tolower(c); });
+                std::ifstream numaNodeFile{"/sys/bus/pci/devices/" + pciBusIdString + "/numa_node"};
+                auto numaNode = -1;
+                if (!(numaNodeFile >> numaNode))
+                    return -1;
+                return numaNode;
+            #else
+                UNUSED(gpuId);
+                return -1;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1;
+        }
+    }
 }
@@ -133,16 +133,11 @@ namespace op
             else
             {
                 // Prepare final cvMat
-                // Concat (0)
-                Matrix opMat = frames[0].clone();
-                cv::Mat cvMat = OP_OP2CVMAT(opMat);
-                // Concat (1,size()-1)
-                for (auto i = 1u; i < frames.size(); i++)
-                {
-                    const cv::Mat framesI = OP_OP2CVCONSTMAT(frames[i]);
-                    cv::hconcat(cvMat, framesI, cvMat);
-                }
-                opMat = OP_CV2OPMAT(cvMat);
+                // Concat all of them at once (each frame is copied once, with no previous clone)
+                OP_OP2CVVECTORMAT(cvMats, frames);
+                cv::Mat cvMat;
+                cv::hconcat(cvMats, cvMat);
+                const Matrix opMat = OP_CV2OPMAT(cvMat);
                 // Display it
                 displayFrame(opMat, waitKeyValue);
             }
@@ -1,4 +1,5 @@
 #include <openpose/hand/handDetector.hpp>
+#include <cmath> // std::floor
 #include <openpose/pose/poseParameters.hpp>
 #include <openpose/utilities/check.hpp>
 #include <openpose/utilities/fastMath.hpp>
@@ -85,42 +86,14 @@ namespace op
         }
     }
 
-    void trackHand(Rectangle<float>& currentRectangle, const std::vector<Rectangle<float>>& previousHands)
+    inline unsigned long long getGridKey(const int cellX, const int cellY)
     {
-        try
-        {
-            if (currentRectangle.area() > 0 && previousHands.size() > 0)
-            {
-                // Find closest previous rectangle
-                auto maxIndex = -1;
-                auto maxValue = 0.f;
-                for (auto previous = 0u ; previous < previousHands.size() ; previous++)
-                {
-                    const auto areaRatio = getAreaRatio(currentRectangle, previousHands[previous]);
-                    if (maxValue < areaRatio)
-                    {
-                        maxValue = areaRatio;
-                        maxIndex = previous;
-                    }
-                }
-                // Update current rectangle with closest previous rectangle
-                if (maxIndex > -1)
-                {
-                    const auto& prevRectangle = previousHands[maxIndex];
-                    const auto ratio = 2.f;
-                    const auto newWidth = fastMax((currentRectangle.width * ratio + prevRectangle.width) * 0.5f,
-                                                  (currentRectangle.height * ratio + prevRectangle.height) * 0.5f);
-                    currentRectangle.x = 0.5f * (currentRectangle.x + prevRectangle.x + 0.5f * (currentRectangle.width + prevRectangle.width) - newWidth);
-                    currentRectangle.y = 0.5f * (currentRectangle.y + prevRectangle.y + 0.5f * (currentRectangle.height + prevRectangle.height) - newWidth);
-                    currentRectangle.width = newWidth;
-                    currentRectangle.height = newWidth;
-                }
-            }
-        }
-        catch (const std::exception& e)
-        {
-            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-        }
+        return ((unsigned long long)(unsigned int)cellX << 32) | (unsigned long long)(unsigned int)cellY;
+    }
+
+    inline int getGridCell(const float coordinate, const float cellSize)
+    {
+        return (int)std::floor(coordinate / cellSize);
     }
 
     HandDetector::HandDetector(const PoseModel poseModel) :
@@ -128,6 +101,8 @@ namespace op
         mPoseIndexes(getPoseKeypoints(poseModel, {"LWrist", "LElbow", "LShoulder", "RWrist", "RElbow", "RShoulder"})),
         mCurrentId{0}
     {
+        resetGrid(mHandLeftPrevious);
+        resetGrid(mHandRightPrevious);
     }
 
     HandDetector::~HandDetector()
@@ -199,8 +174,8 @@ namespace op
                 const auto thresholdRectangle = 0.25f;
                 // Update pose keypoints and hand rectangles
                 mPoseTrack.resize(numberPeople);
-                mHandLeftPrevious.clear();
-                mHandRightPrevious.clear();
+                resetGrid(mHandLeftPrevious);
+                resetGrid(mHandRightPrevious);
                 for (auto person = 0u ; person < mPoseTrack.size() ; person++)
                 {
                     const auto scoreThreshold = 0.66667f;
@@ -209,16 +184,19 @@ namespace op
                     {
                         const auto handLeftRectangle = getKeypointsRectangle(handKeypoints[0], person, thresholdRectangle);
                         if (handLeftRectangle.area() > 0)
-                            mHandLeftPrevious.emplace_back(handLeftRectangle);
+                            mHandLeftPrevious.rectangles.emplace_back(handLeftRectangle);
                     }
                     // Right hand
                     if (getAverageScore(handKeypoints[1], person) > scoreThreshold)
                     {
                         const auto handRightRectangle = getKeypointsRectangle(handKeypoints[1], person, thresholdRectangle);
                         if (handRightRectangle.area() > 0)
-                            mHandRightPrevious.emplace_back(handRightRectangle);
+                            mHandRightPrevious.rectangles.emplace_back(handRightRectangle);
                     }
                 }
+                // Index them for trackHands
+                fillGrid(mHandLeftPrevious);
+                fillGrid(mHandRightPrevious);
             }
         }
         catch (const std::exception& e)
@@ -236,4 +214,113 @@ namespace op
             poseKeypoints.at(i) = poseBodyPartMapStringToKey(poseModel, poseStrings.at(i));
         return poseKeypoints;
     }
+
+    void HandDetector::resetGrid(HandGrid& handGrid)
+    {
+        try
+        {
+            handGrid.rectangles.clear();
+            handGrid.cells.clear();
+            handGrid.cellSize = 1.f;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void HandDetector::fillGrid(HandGrid& handGrid)
+    {
+        try
+        {
+            handGrid.cells.clear();
+            // Cell size = biggest previous hand, so a previous hand can only overlap a new one if its center lies in
+            // one of the few cells around the new hand
+            handGrid.cellSize = 1.f;
+            for (const auto& rectangle : handGrid.rectangles)
+                handGrid.cellSize = fastMax(handGrid.cellSize, fastMax(rectangle.width, rectangle.height));
+            // Bucket each rectangle by its center
+            for (auto index = 0u ; index < handGrid.rectangles.size() ; index++)
+            {
+                const auto center = handGrid.rectangles[index].center();
+                handGrid.cells[getGridKey(
+                    getGridCell(center.x, handGrid.cellSize), getGridCell(center.y, handGrid.cellSize))
+                ].emplace_back(index);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void HandDetector::trackHand(Rectangle<float>& currentRectangle, const HandGrid& previousHands)
+    {
+        try
+        {
+            if (currentRectangle.area() > 0 && !previousHands.rectangles.empty())
+            {
+                // Find closest previous rectangle
+                // Ties are resolved in favor of the lowest index, i.e., same result than a linear scan
+                auto maxIndex = -1;
+                auto maxValue = 0.f;
+                const auto checkPrevious = [&](const unsigned int previous)
+                {
+                    const auto areaRatio = getAreaRatio(currentRectangle, previousHands.rectangles[previous]);
+                    if (maxValue < areaRatio || (maxValue > 0.f && maxValue == areaRatio && (int)previous < maxIndex))
+                    {
+                        maxValue = areaRatio;
+                        maxIndex = previous;
+                    }
+                };
+                // Cells whose centers could overlap currentRectangle (getAreaRatio adds 1 pixel to the intersection)
+                const auto cellSize = previousHands.cellSize;
+                const auto center = currentRectangle.center();
+                const auto radiusX = 0.5f * (currentRectangle.width + cellSize) + 1.f;
+                const auto radiusY = 0.5f * (currentRectangle.height + cellSize) + 1.f;
+                const auto cellXMin = getGridCell(center.x - radiusX, cellSize);
+                const auto cellXMax = getGridCell(center.x + radiusX, cellSize);
+                const auto cellYMin = getGridCell(center.y - radiusY, cellSize);
+                const auto cellYMax = getGridCell(center.y + radiusY, cellSize);
+                const auto numberCells = (unsigned long long)(cellXMax - cellXMin + 1)
+                                       * (unsigned long long)(cellYMax - cellYMin + 1);
+                // Huge rectangle (more cells than previous hands) --> plain linear scan
+                if (numberCells >= previousHands.rectangles.size())
+                {
+                    for (auto previous = 0u ; previous < previousHands.rectangles.size() ; previous++)
+                        checkPrevious(previous);
+                }
+                // Otherwise, only the neighbouring cells
+                else
+                {
+                    for (auto cellY = cellYMin ; cellY <= cellYMax ; cellY++)
+                    {
+                        for (auto cellX = cellXMin ; cellX <= cellXMax ; cellX++)
+                        {
+                            const auto cell = previousHands.cells.find(getGridKey(cellX, cellY));
+                            if (cell != previousHands.cells.end())
+                                for (const auto previous : cell->second)
+                                    checkPrevious(previous);
+                        }
+                    }
+                }
+                // Update current rectangle with closest previous rectangle
+                if (maxIndex > -1)
+                {
+                    const auto& prevRectangle = previousHands.rectangles[maxIndex];
+                    const auto ratio = 2.f;
+                    const auto newWidth = fastMax((currentRectangle.width * ratio + prevRectangle.width) * 0.5f,
+                                                  (currentRectangle.height * ratio + prevRectangle.height) * 0.5f);
+                    currentRectangle.x = 0.5f * (currentRectangle.x + prevRectangle.x + 0.5f * (currentRectangle.width + prevRectangle.width) - newWidth);
+                    currentRectangle.y = 0.5f * (currentRectangle.y + prevRectangle.y + 0.5f * (currentRectangle.height + prevRectangle.height) - newWidth);
+                    currentRectangle.width = newWidth;
+                    currentRectangle.height = newWidth;
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
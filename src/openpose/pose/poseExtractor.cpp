@@ -1,21 +1,42 @@
 #include <openpose/pose/poseExtractor.hpp>
+#include <cmath> // std::ceil, std::floor
+#include <cstring> // std::memcpy
+#include <limits> // std::numeric_limits
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/keypoint.hpp>
 
 namespace op
 {
     const std::string errorMessage = "Either person identification (`--identification`) must be enabled or"
                                      " `--number_people_max 1` in order to run the person tracker (`--tracking`).";
+    // ROI mode parameters
+    // Padding added to each side of each person bounding box, relative to its biggest side
+    const auto ROI_PADDING_RATIO = 0.25f;
+    // Minimum score of a keypoint to be included in the person bounding box
+    const auto ROI_KEYPOINT_THRESHOLD = 0.05f;
+    // If the crop covers more than this ratio of the net input, the full frame is processed instead
+    const auto ROI_MAX_AREA_RATIO = 0.8f;
+    // Net input crop origin and size are multiples of this value (net input sizes must be multiples of 16)
+    const auto ROI_ALIGNMENT = 16;
 
     PoseExtractor::PoseExtractor(const std::shared_ptr<PoseExtractorNet>& poseExtractorNet,
                                  const std::shared_ptr<KeepTopNPeople>& keepTopNPeople,
                                  const std::shared_ptr<PersonIdExtractor>& personIdExtractor,
                                  const std::shared_ptr<std::vector<std::shared_ptr<PersonTracker>>>& personTrackers,
-                                 const int numberPeopleMax, const int tracking) :
+                                 const int numberPeopleMax, const int tracking, const int roiRefresh,
+                                 const std::shared_ptr<MotionGate>& motionGate) :
         mNumberPeopleMax{numberPeopleMax},
         mTracking{tracking},
+        mRoiRefresh{roiRefresh},
+        mRoiPreviousPeople{0},
+        mRoiFramesSinceRefresh{0},
         spPoseExtractorNet{poseExtractorNet},
         spKeepTopNPeople{keepTopNPeople},
         spPersonIdExtractor{personIdExtractor},
-        spPersonTrackers{personTrackers}
+        spPersonTrackers{personTrackers},
+        spMotionGate{motionGate},
+        mGated{false},
+        mDeferred{false}
     {
     }
 
@@ -39,14 +60,83 @@ namespace op
                                     const Point<int>& inputDataSize,
                                     const std::vector<double>& scaleInputToNetInputs,
                                     const Array<float>& poseNetOutput,
-                                    const long long frameId)
+                                    const long long frameId,
+                                    const bool warmup)
     {
         try
         {
-            if (mTracking < 1 || frameId % (mTracking+1) == 0)
+            // Warm-up frame: Whole frame, without updating the state of the following frames
+            if (warmup)
+            {
+                mGated = false;
+                mDeferred = false;
                 spPoseExtractorNet->forwardPass(inputNetData, inputDataSize, scaleInputToNetInputs, poseNetOutput);
+                if (mRoiRefresh >= 0)
+                {
+                    mRoi = Rectangle<float>{0.f, 0.f, float(inputDataSize.x), float(inputDataSize.y)};
+                    mRoiPoseKeypoints = spPoseExtractorNet->getPoseKeypoints();
+                }
+                return;
+            }
+            // Motion gate: No scene change --> Reuse the results of the last processed frame
+            // (if the frame it depends on expired, this one is processed; if it is still being processed by another
+            // GPU, this one is deferred and filled later, so this thread never waits for it)
+            mGated = (spMotionGate != nullptr && spMotionGate->isSkipped(frameId)
+                      && spMotionGate->getResults(frameId, mGatedPoseKeypoints, mGatedPoseScores));
+            mDeferred = (mGated && spMotionGate->isDeferred(frameId));
+            if (mGated)
+            {
+                spPoseExtractorNet->clear();
+                return;
+            }
+            // Key frame (i.e., run OpenPose). Otherwise, the person tracker propagates the previous keypoints
+            const auto keyFrame = (
+                mTracking < 1
+                || (!spPersonTrackers || spPersonTrackers->empty() || !spPersonTrackers->at(0)
+                    ? frameId % (mTracking+1) == 0 : spPersonTrackers->at(0)->isKeyFrame(frameId, mTracking)));
+            if (keyFrame)
+            {
+                // Regular full-frame detection
+                if (mRoiRefresh < 0)
+                    spPoseExtractorNet->forwardPass(
+                        inputNetData, inputDataSize, scaleInputToNetInputs, poseNetOutput);
+                // ROI mode: Body network only run on the area occupied by the people of the previous frame
+                else
+                {
+                    // Full-frame refresh if multi-scale, external net output, no people in the previous frame, or
+                    // every mRoiRefresh frames
+                    auto fullFrame = (
+                        inputNetData.size() != 1 || !poseNetOutput.empty() || mNextRoi.area() <= 0.f
+                        || (mRoiRefresh > 0 && mRoiFramesSinceRefresh >= mRoiRefresh - 1));
+                    if (!fullFrame)
+                    {
+                        fullFrame = !roiForwardPass(inputNetData[0], scaleInputToNetInputs[0], poseNetOutput);
+                        // Tracking lost (fewer people than in the previous frame) --> Re-run on the whole frame
+                        if (!fullFrame && mRoiPoseKeypoints.getSize(0) < mRoiPreviousPeople)
+                            fullFrame = true;
+                    }
+                    if (fullFrame)
+                    {
+                        spPoseExtractorNet->forwardPass(
+                            inputNetData, inputDataSize, scaleInputToNetInputs, poseNetOutput);
+                        mRoi = Rectangle<float>{0.f, 0.f, float(inputDataSize.x), float(inputDataSize.y)};
+                        mRoiPoseKeypoints = spPoseExtractorNet->getPoseKeypoints();
+                        mRoiFramesSinceRefresh = 0;
+                    }
+                    else
+                        mRoiFramesSinceRefresh++;
+                    mRoiPreviousPeople = mRoiPoseKeypoints.getSize(0);
+                    updateNextRoi(inputDataSize);
+                }
+            }
             else
+            {
                 spPoseExtractorNet->clear();
+                mRoiPoseKeypoints.reset();
+            }
+            // Motion gate: Share results with the following skipped frames
+            if (spMotionGate != nullptr)
+                spMotionGate->setResults(frameId, getPoseKeypoints(), getPoseScores());
         }
         catch (const std::exception& e)
         {
@@ -54,6 +144,32 @@ namespace op
         }
     }
 
+    void PoseExtractor::setExpired(const long long frameId)
+    {
+        try
+        {
+            if (spMotionGate != nullptr)
+                spMotionGate->setExpired(frameId);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool PoseExtractor::isDeferred() const
+    {
+        try
+        {
+            return mDeferred;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     Array<float> PoseExtractor::getHeatMapsCopy() const
     {
         try
@@ -71,7 +187,20 @@ namespace op
     {
         try
         {
-            return spPoseExtractorNet->getCandidatesCopy();
+            auto candidates = spPoseExtractorNet->getCandidatesCopy();
+            // ROI mode: Candidates back to frame coordinates
+            if (mRoi.x != 0.f || mRoi.y != 0.f)
+            {
+                for (auto& bodyPartCandidates : candidates)
+                {
+                    for (auto& candidate : bodyPartCandidates)
+                    {
+                        candidate[0] += mRoi.x;
+                        candidate[1] += mRoi.y;
+                    }
+                }
+            }
+            return candidates;
         }
         catch (const std::exception& e)
         {
@@ -84,7 +213,9 @@ namespace op
     {
         try
         {
-            return spPoseExtractorNet->getPoseKeypoints();
+            if (mGated)
+                return mGatedPoseKeypoints;
+            return (mRoiRefresh < 0 ? spPoseExtractorNet->getPoseKeypoints() : mRoiPoseKeypoints);
         }
         catch (const std::exception& e)
         {
@@ -97,6 +228,8 @@ namespace op
     {
         try
         {
+            if (mGated)
+                return mGatedPoseScores;
             return spPoseExtractorNet->getPoseScores();
         }
         catch (const std::exception& e)
@@ -119,6 +252,19 @@ namespace op
         }
     }
 
+    Rectangle<float> PoseExtractor::getRoi() const
+    {
+        try
+        {
+            return mRoi;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Rectangle<float>{};
+        }
+    }
+
     void PoseExtractor::keepTopPeople(Array<float>& poseKeypoints, const Array<float>& poseScores) const
     {
         try
@@ -229,4 +375,99 @@ namespace op
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
+
+    bool PoseExtractor::roiForwardPass(const Array<float>& inputNetData, const double scaleInputToNetInput,
+                                       const Array<float>& poseNetOutput)
+    {
+        try
+        {
+            // ROI in net input coordinates. Origin aligned down and size aligned up to ROI_ALIGNMENT
+            const auto channels = inputNetData.getSize(1);
+            const auto netHeight = inputNetData.getSize(2);
+            const auto netWidth = inputNetData.getSize(3);
+            const auto scale = float(scaleInputToNetInput);
+            auto xNet = fastMax(0, int(std::floor(mNextRoi.x*scale)) / ROI_ALIGNMENT * ROI_ALIGNMENT);
+            auto yNet = fastMax(0, int(std::floor(mNextRoi.y*scale)) / ROI_ALIGNMENT * ROI_ALIGNMENT);
+            const auto widthNet = fastMin(
+                netWidth,
+                (int(std::ceil((mNextRoi.x+mNextRoi.width)*scale)) - xNet + ROI_ALIGNMENT - 1)
+                    / ROI_ALIGNMENT * ROI_ALIGNMENT);
+            const auto heightNet = fastMin(
+                netHeight,
+                (int(std::ceil((mNextRoi.y+mNextRoi.height)*scale)) - yNet + ROI_ALIGNMENT - 1)
+                    / ROI_ALIGNMENT * ROI_ALIGNMENT);
+            xNet = fastMin(xNet, netWidth - widthNet);
+            yNet = fastMin(yNet, netHeight - heightNet);
+            // Not worth it --> Full frame
+            if (widthNet <= 0 || heightNet <= 0
+                || widthNet*heightNet > ROI_MAX_AREA_RATIO * netWidth*netHeight)
+                return false;
+            // Crop net input
+            if (mRoiNetInput.getSize() != std::vector<int>{1, channels, heightNet, widthNet})
+                mRoiNetInput.reset({1, channels, heightNet, widthNet});
+            const auto* const sourcePtr = inputNetData.getConstPtr();
+            auto* targetPtr = mRoiNetInput.getPtr();
+            for (auto c = 0 ; c < channels ; c++)
+                for (auto y = 0 ; y < heightNet ; y++)
+                    std::memcpy(
+                        targetPtr + (c*heightNet + y)*widthNet,
+                        sourcePtr + (c*netHeight + yNet + y)*netWidth + xNet,
+                        widthNet * sizeof(float));
+            // Run body network on the crop
+            mRoi = Rectangle<float>{xNet/scale, yNet/scale, widthNet/scale, heightNet/scale};
+            const Point<int> roiDataSize{positiveIntRound(mRoi.width), positiveIntRound(mRoi.height)};
+            spPoseExtractorNet->forwardPass({mRoiNetInput}, roiDataSize, {scaleInputToNetInput}, poseNetOutput);
+            // Keypoints back to frame coordinates
+            mRoiPoseKeypoints = spPoseExtractorNet->getPoseKeypoints().clone();
+            for (auto i = 0u ; i < mRoiPoseKeypoints.getVolume() ; i+=3)
+            {
+                if (mRoiPoseKeypoints[i+2] > 0.f)
+                {
+                    mRoiPoseKeypoints[i] += mRoi.x;
+                    mRoiPoseKeypoints[i+1] += mRoi.y;
+                }
+            }
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void PoseExtractor::updateNextRoi(const Point<int>& inputDataSize)
+    {
+        try
+        {
+            // Union of the padded bounding boxes of all the people detected in the last frame
+            auto xMin = std::numeric_limits<float>::max();
+            auto yMin = std::numeric_limits<float>::max();
+            auto xMax = std::numeric_limits<float>::lowest();
+            auto yMax = std::numeric_limits<float>::lowest();
+            for (auto person = 0 ; person < mRoiPoseKeypoints.getSize(0) ; person++)
+            {
+                const auto rectangle = getKeypointsRectangle(mRoiPoseKeypoints, person, ROI_KEYPOINT_THRESHOLD);
+                if (rectangle.area() > 0.f)
+                {
+                    const auto padding = ROI_PADDING_RATIO * fastMax(rectangle.width, rectangle.height);
+                    xMin = fastMin(xMin, rectangle.x - padding);
+                    yMin = fastMin(yMin, rectangle.y - padding);
+                    xMax = fastMax(xMax, rectangle.x + rectangle.width + padding);
+                    yMax = fastMax(yMax, rectangle.y + rectangle.height + padding);
+                }
+            }
+            // Clipped to the frame (empty if no people --> Full-frame pass)
+            xMin = fastMax(xMin, 0.f);
+            yMin = fastMax(yMin, 0.f);
+            xMax = fastMin(xMax, float(inputDataSize.x));
+            yMax = fastMin(yMax, float(inputDataSize.y));
+            mNextRoi = (xMin < xMax && yMin < yMax
+                ? Rectangle<float>{xMin, yMin, xMax - xMin, yMax - yMin} : Rectangle<float>{});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
@@ -0,0 +1,139 @@
+#include <openpose/thread/cpuAffinity.hpp>
+#include <algorithm> // std::sort, std::unique
+#include <fstream>
+#include <thread> // std::thread::hardware_concurrency
+#ifdef __linux__
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+#include <openpose/utilities/fastMath.hpp>
+
+namespace op
+{
+    std::vector<std::vector<int>> getNumaNodeCpus()
+    {
+        try
+        {
+            std::vector<std::vector<int>> numaNodeCpus;
+            #ifdef __linux__
+                // Online nodes (same list format as the CPUs, e.g., "0-1")
+                std::ifstream nodeListFile{"/sys/devices/system/node/online"};
+                std::string nodeList;
+                if (std::getline(nodeListFile, nodeList))
+                {
+                    for (const auto node : parseCpuList(nodeList))
+                    {
+                        std::ifstream cpuListFile{
+                            "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"};
+                        std::string cpuList;
+                        std::getline(cpuListFile, cpuList);
+                        // Memory-only nodes have no CPUs
+                        if (numaNodeCpus.size() <= (std::size_t)node)
+                            numaNodeCpus.resize(node + 1);
+                        numaNodeCpus[node] = parseCpuList(cpuList);
+                    }
+                }
+            #endif
+            // Not available -> 1 node with all the CPUs
+            auto numberCpus = 0ull;
+            for (const auto& cpus : numaNodeCpus)
+                numberCpus += cpus.size();
+            if (numberCpus == 0ull)
+            {
+                numaNodeCpus.clear();
+                numaNodeCpus.emplace_back();
+                for (auto cpu = 0 ; cpu < fastMax(1, int(std::thread::hardware_concurrency())) ; cpu++)
+                    numaNodeCpus.back().emplace_back(cpu);
+            }
+            return numaNodeCpus;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::vector<int> parseCpuList(const std::string& cpuList)
+    {
+        try
+        {
+            std::vector<int> cpus;
+            std::size_t begin = 0;
+            while (begin < cpuList.size())
+            {
+                auto end = cpuList.find(',', begin);
+                if (end == std::string::npos)
+                    end = cpuList.size();
+                const auto range = cpuList.substr(begin, end - begin);
+                const auto dash = range.find('-');
+                if (range.find_first_of("0123456789") != std::string::npos)
+                {
+                    const auto first = std::stoi(range.substr(0, dash));
+                    const auto last = (dash == std::string::npos ? first : std::stoi(range.substr(dash + 1)));
+                    for (auto cpu = first ; cpu <= last ; cpu++)
+                        cpus.emplace_back(cpu);
+                }
+                begin = end + 1;
+            }
+            std::sort(cpus.begin(), cpus.end());
+            cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+            return cpus;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::vector<int> getThreadCpus()
+    {
+        try
+        {
+            std::vector<int> cpus;
+            #ifdef __linux__
+                cpu_set_t cpuSet;
+                CPU_ZERO(&cpuSet);
+                if (pthread_getaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0)
+                    for (auto cpu = 0 ; cpu < CPU_SETSIZE ; cpu++)
+                        if (CPU_ISSET(cpu, &cpuSet))
+                            cpus.emplace_back(cpu);
+            #endif
+            return cpus;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    bool setThreadCpus(const std::vector<int>& cpus)
+    {
+        try
+        {
+            if (cpus.empty())
+                return false;
+            #ifdef __linux__
+                cpu_set_t cpuSet;
+                CPU_ZERO(&cpuSet);
+                for (const auto cpu : cpus)
+                    if (cpu >= 0 && cpu < CPU_SETSIZE)
+                        CPU_SET(cpu, &cpuSet);
+                const auto errorCode = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+                if (errorCode != 0)
+                    opLog("Thread affinity could not be set (error " + std::to_string(errorCode) + ").",
+                          Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                return (errorCode == 0);
+            #else
+                return false;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+}
@@ -5,6 +5,7 @@ namespace op
     // Queues
     DEFINE_TEMPLATE_DATUM(PriorityQueue);
     DEFINE_TEMPLATE_DATUM(Queue);
+    DEFINE_TEMPLATE_DATUM(RingBufferQueue);
     template class OP_API QueueBase<BASE_DATUMS_SH, std::queue<BASE_DATUMS_SH>>;
     template class OP_API QueueBase<
         BASE_DATUMS_SH,
@@ -19,6 +20,7 @@ namespace op
     // Thread
     DEFINE_TEMPLATE_DATUM(Thread);
     DEFINE_TEMPLATE_DATUM(ThreadManager);
+    DEFINE_TEMPLATE_DATUM(WorkStealingScheduler);
     // Main workers
     DEFINE_TEMPLATE_DATUM(Worker);
     DEFINE_TEMPLATE_DATUM(WorkerConsumer);
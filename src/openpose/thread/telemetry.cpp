@@ -0,0 +1,340 @@
+#include <openpose/thread/telemetry.hpp>
+#ifdef __GNUG__
+    #include <cstdlib> // std::free
+    #include <cxxabi.h> // abi::__cxa_demangle
+#endif
+#include <openpose/utilities/fastMath.hpp>
+
+namespace op
+{
+    unsigned long long getNowNs()
+    {
+        return (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    unsigned int getHistogramBin(const std::chrono::nanoseconds& wait)
+    {
+        // Bin 0: < 1 us, bin i: [2^(i-1), 2^i) us
+        auto microseconds = (unsigned long long)fastMax(0ll, (long long)(wait.count() / 1000));
+        auto bin = 0u;
+        while (microseconds > 0ull && bin + 1u < QueueStatistics::NUMBER_BINS)
+        {
+            microseconds >>= 1;
+            bin++;
+        }
+        return bin;
+    }
+
+    std::string getWaitString(
+        const double waitMs, const std::array<unsigned long long, QueueStatistics::NUMBER_BINS>& histogram)
+    {
+        // 99th percentile, given as the upper bound of its bin
+        auto numberWaits = 0ull;
+        for (const auto count : histogram)
+            numberWaits += count;
+        if (numberWaits == 0ull)
+            return "0 ms";
+        auto percentileBin = 0u;
+        auto cumulative = 0ull;
+        for (auto bin = 0u ; bin < histogram.size() ; bin++)
+        {
+            cumulative += histogram[bin];
+            if (100ull * cumulative >= 99ull * numberWaits)
+            {
+                percentileBin = bin;
+                break;
+            }
+        }
+        return std::to_string(waitMs) + " ms in " + std::to_string(numberWaits) + " waits (p99 < "
+            + std::to_string((1ull << percentileBin) * 1e-3) + " ms)";
+    }
+
+    std::string getWorkerName(const std::type_info& typeInfo)
+    {
+        std::string name = typeInfo.name();
+        #ifdef __GNUG__
+            int status = -1;
+            char* demangled = abi::__cxa_demangle(typeInfo.name(), nullptr, nullptr, &status);
+            if (status == 0 && demangled != nullptr)
+                name = demangled;
+            std::free(demangled);
+        #endif
+        // "class op::WPoseExtractor<std::shared_ptr<...>>" -> "WPoseExtractor"
+        name = name.substr(0, name.find('<'));
+        const auto lastColon = name.rfind(':');
+        if (lastColon != std::string::npos)
+            name = name.substr(lastColon + 1);
+        const auto lastSpace = name.rfind(' ');
+        if (lastSpace != std::string::npos)
+            name = name.substr(lastSpace + 1);
+        return name;
+    }
+
+    QueueStatistics::QueueStatistics() :
+        numberPushed{0ull},
+        numberPopped{0ull},
+        numberDropped{0ull},
+        size{0ull},
+        averageOccupancy{0.},
+        elapsedSeconds{0.},
+        pushWaitMs{0.},
+        popWaitMs{0.}
+    {
+        pushWaitHistogram.fill(0ull);
+        popWaitHistogram.fill(0ull);
+    }
+
+    std::string QueueStatistics::toString() const
+    {
+        try
+        {
+            return "pushed " + std::to_string(numberPushed) + ", popped " + std::to_string(numberPopped)
+                + ", dropped " + std::to_string(numberDropped) + ", size " + std::to_string(size)
+                + ", average occupancy " + std::to_string(averageOccupancy) + ", push wait "
+                + getWaitString(pushWaitMs, pushWaitHistogram) + ", pop wait "
+                + getWaitString(popWaitMs, popWaitHistogram);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    WorkerStatistics::WorkerStatistics() :
+        threadId{0ull},
+        numberCalls{0ull},
+        averageMs{0.},
+        maxMs{0.}
+    {
+    }
+
+    std::string WorkerStatistics::toString() const
+    {
+        try
+        {
+            return name + " (thread " + std::to_string(threadId) + "): " + std::to_string(numberCalls)
+                + " calls, average " + std::to_string(averageMs) + " ms, max " + std::to_string(maxMs) + " ms";
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    std::string ThreadManagerStatistics::toString() const
+    {
+        try
+        {
+            // Compact, so it fits in a single log line
+            std::string line = "Queues (average occupancy, push/pop wait ms):";
+            for (const auto& queue : queues)
+                line += " [" + std::to_string(queue.averageOccupancy) + ", "
+                    + std::to_string(queue.pushWaitMs) + "/" + std::to_string(queue.popWaitMs) + "]";
+            line += ". Workers (average/max ms):";
+            for (const auto& worker : workers)
+                line += " " + worker.name + "@" + std::to_string(worker.threadId) + " "
+                    + std::to_string(worker.averageMs) + "/" + std::to_string(worker.maxMs);
+            return line + ".";
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    QueueTelemetry::QueueTelemetry() :
+        mStart{std::chrono::steady_clock::now()},
+        mNumberPushed{0ull},
+        mNumberPopped{0ull},
+        mLastChangeNs{getNowNs()},
+        mLastSize{0ull},
+        mOccupancyIntegral{0ull},
+        mPushWaitNs{0ull},
+        mPopWaitNs{0ull}
+    {
+        try
+        {
+            for (auto bin = 0u ; bin < QueueStatistics::NUMBER_BINS ; bin++)
+            {
+                mPushWaitHistogram[bin] = 0ull;
+                mPopWaitHistogram[bin] = 0ull;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    QueueTelemetry::~QueueTelemetry()
+    {
+    }
+
+    void QueueTelemetry::recordPush(const unsigned long long size)
+    {
+        try
+        {
+            mNumberPushed.fetch_add(1ull, std::memory_order_relaxed);
+            recordSize(size);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void QueueTelemetry::recordPop(const unsigned long long size)
+    {
+        try
+        {
+            mNumberPopped.fetch_add(1ull, std::memory_order_relaxed);
+            recordSize(size);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void QueueTelemetry::recordSize(const unsigned long long size)
+    {
+        try
+        {
+            // Each exchange() claims the interval since the previous change, so every nanosecond is added once
+            const auto now = getNowNs();
+            const auto lastChange = mLastChangeNs.exchange(now, std::memory_order_relaxed);
+            const auto lastSize = mLastSize.exchange(size, std::memory_order_relaxed);
+            if (now > lastChange)
+                mOccupancyIntegral.fetch_add(lastSize * (now - lastChange), std::memory_order_relaxed);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void QueueTelemetry::recordPushWait(const std::chrono::nanoseconds& wait)
+    {
+        try
+        {
+            mPushWaitNs.fetch_add((unsigned long long)wait.count(), std::memory_order_relaxed);
+            mPushWaitHistogram[getHistogramBin(wait)].fetch_add(1ull, std::memory_order_relaxed);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void QueueTelemetry::recordPopWait(const std::chrono::nanoseconds& wait)
+    {
+        try
+        {
+            mPopWaitNs.fetch_add((unsigned long long)wait.count(), std::memory_order_relaxed);
+            mPopWaitHistogram[getHistogramBin(wait)].fetch_add(1ull, std::memory_order_relaxed);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    QueueStatistics QueueTelemetry::getStatistics() const
+    {
+        try
+        {
+            QueueStatistics queueStatistics;
+            queueStatistics.numberPushed = mNumberPushed.load(std::memory_order_relaxed);
+            queueStatistics.numberPopped = mNumberPopped.load(std::memory_order_relaxed);
+            queueStatistics.size = mLastSize.load(std::memory_order_relaxed);
+            // Occupancy, including the interval since the last change
+            const auto now = getNowNs();
+            const auto lastChange = mLastChangeNs.load(std::memory_order_relaxed);
+            const auto occupancyIntegral = mOccupancyIntegral.load(std::memory_order_relaxed)
+                + (now > lastChange ? queueStatistics.size * (now - lastChange) : 0ull);
+            const auto elapsedNs = getElapsedNs();
+            queueStatistics.elapsedSeconds = elapsedNs * 1e-9;
+            queueStatistics.averageOccupancy = (elapsedNs > 0ull ? occupancyIntegral / double(elapsedNs) : 0.);
+            // Waits
+            queueStatistics.pushWaitMs = mPushWaitNs.load(std::memory_order_relaxed) * 1e-6;
+            queueStatistics.popWaitMs = mPopWaitNs.load(std::memory_order_relaxed) * 1e-6;
+            for (auto bin = 0u ; bin < QueueStatistics::NUMBER_BINS ; bin++)
+            {
+                queueStatistics.pushWaitHistogram[bin] = mPushWaitHistogram[bin].load(std::memory_order_relaxed);
+                queueStatistics.popWaitHistogram[bin] = mPopWaitHistogram[bin].load(std::memory_order_relaxed);
+            }
+            return queueStatistics;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return QueueStatistics{};
+        }
+    }
+
+    unsigned long long QueueTelemetry::getElapsedNs() const
+    {
+        try
+        {
+            return (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - mStart).count();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    WorkerTelemetry::WorkerTelemetry(const std::type_info& typeInfo) :
+        mName{getWorkerName(typeInfo)},
+        mNumberCalls{0ull},
+        mTotalNs{0ull},
+        mMaxNs{0ull}
+    {
+    }
+
+    WorkerTelemetry::~WorkerTelemetry()
+    {
+    }
+
+    void WorkerTelemetry::record(const std::chrono::nanoseconds& serviceTime)
+    {
+        try
+        {
+            const auto serviceTimeNs = (unsigned long long)serviceTime.count();
+            mNumberCalls.fetch_add(1ull, std::memory_order_relaxed);
+            mTotalNs.fetch_add(serviceTimeNs, std::memory_order_relaxed);
+            // Single writer, so no compare-and-swap is required
+            if (serviceTimeNs > mMaxNs.load(std::memory_order_relaxed))
+                mMaxNs.store(serviceTimeNs, std::memory_order_relaxed);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    WorkerStatistics WorkerTelemetry::getStatistics() const
+    {
+        try
+        {
+            WorkerStatistics workerStatistics;
+            workerStatistics.name = mName;
+            workerStatistics.numberCalls = mNumberCalls.load(std::memory_order_relaxed);
+            workerStatistics.averageMs = (workerStatistics.numberCalls > 0ull
+                ? mTotalNs.load(std::memory_order_relaxed) * 1e-6 / workerStatistics.numberCalls : 0.);
+            workerStatistics.maxMs = mMaxNs.load(std::memory_order_relaxed) * 1e-6;
+            return workerStatistics;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return WorkerStatistics{};
+        }
+    }
+}
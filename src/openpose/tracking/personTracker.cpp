@@ -1,6 +1,8 @@
 #include <openpose/tracking/personTracker.hpp>
+#include <algorithm> // std::count_if
 #include <atomic>
 #include <iostream>
+#include <mutex>
 #include <unordered_map>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose_private/tracking/pyramidalLK.hpp>
@@ -8,11 +10,18 @@
 
 namespace op
 {
+    // Confidence of the propagated (LK) keypoints is multiplied by this factor on each frame without detection
+    const auto KEYPOINT_CONFIDENCE_DECAY = 0.9f;
+    // Adaptive key frame schedule: if the ratio of keypoints that LK keeps tracking between 2 frames goes below this
+    // value, the number of frames between key frames is halved. It grows back by 1 on each key frame otherwise
+    const auto MIN_LK_INLIER_RATIO = 0.8f;
+
     struct PersonTrackerEntry
     {
         std::vector<cv::Point2f> keypoints;
         std::vector<cv::Point2f> lastKeypoints;
         std::vector<char> status;
+        std::vector<float> confidences;
         std::vector<cv::Point2f> getPredicted() const
         {
             std::vector<cv::Point2f> predictedKeypoints(keypoints);
@@ -85,18 +94,27 @@ namespace op
         return roundUp(int(maxDist / 10.), 3);
     }
 
-    void updateLK(std::unordered_map<int,PersonTrackerEntry>& personEntries,
-                  std::vector<cv::Mat>& pyramidImagesPrevious, std::vector<cv::Mat>& pyramidImagesCurrent,
-                  const cv::Mat& imagePrevious, const cv::Mat& imageCurrent,
-                  const int levels, const int patchSize, const bool trackVelocity, const bool scaleVarying)
+    int getNumberTracked(const std::vector<char>& status)
+    {
+        return (int)std::count_if(status.begin(), status.end(), [](const char value) { return value != 0; });
+    }
+
+    // Returns the ratio of tracked keypoints that are still tracked after LK (inlier ratio)
+    float updateLK(std::unordered_map<int,PersonTrackerEntry>& personEntries,
+                   std::vector<cv::Mat>& pyramidImagesPrevious, std::vector<cv::Mat>& pyramidImagesCurrent,
+                   const cv::Mat& imagePrevious, const cv::Mat& imageCurrent,
+                   const int levels, const int patchSize, const bool trackVelocity, const bool scaleVarying)
     {
         try
         {
+            auto keypointsBefore = 0;
+            auto keypointsAfter = 0;
             // Inefficient version, do it per person
             for (auto& kv : personEntries)
             {
                 PersonTrackerEntry newPersonEntry;
                 PersonTrackerEntry& oldPersonEntry = kv.second;
+                keypointsBefore += getNumberTracked(oldPersonEntry.status);
                 int lkSize = patchSize;
                 if (scaleVarying)
                 {
@@ -117,12 +135,18 @@ namespace op
 
                 newPersonEntry.lastKeypoints = oldPersonEntry.keypoints;
                 newPersonEntry.status = oldPersonEntry.status;
+                newPersonEntry.confidences = oldPersonEntry.confidences;
+                for (auto& confidence : newPersonEntry.confidences)
+                    confidence *= KEYPOINT_CONFIDENCE_DECAY;
+                keypointsAfter += getNumberTracked(newPersonEntry.status);
                 oldPersonEntry = newPersonEntry;
             }
+            return (keypointsBefore > 0 ? keypointsAfter / float(keypointsBefore) : 1.f);
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.f;
         }
     }
 
@@ -173,6 +197,7 @@ namespace op
                 personEntries[id] = PersonTrackerEntry();
                 personEntries[id].keypoints.resize(poseKeypoints.getSize(1));
                 personEntries[id].status.resize(poseKeypoints.getSize(1));
+                personEntries[id].confidences.resize(poseKeypoints.getSize(1));
                 for (int j=0; j<poseKeypoints.getSize(1); j++)
                 {
                     personEntries[id].keypoints[j].x = poseKeypoints[
@@ -188,6 +213,7 @@ namespace op
                         personEntries[id].status[j] = 0;
                     else
                         personEntries[id].status[j] = 1;
+                    personEntries[id].confidences[j] = prob;
                 }
             }
         }
@@ -249,6 +275,7 @@ namespace op
                             else
                             {
                                 personEntries[id].status[j] = 1;
+                                personEntries[id].confidences[j] = prob;
                                 const auto distance = sqrt(pow(lkPoint.x-opPoint.x,2)+pow(lkPoint.y-opPoint.y,2));
                                 if (distance < 5)
                                     personEntries[id].keypoints[j] = lkPoint;
@@ -268,6 +295,7 @@ namespace op
                         personEntries[id] = PersonTrackerEntry();
                         personEntries[id].keypoints.resize(poseKeypoints.getSize(1));
                         personEntries[id].status.resize(poseKeypoints.getSize(1));
+                        personEntries[id].confidences.resize(poseKeypoints.getSize(1));
                         for (int j=0; j<poseKeypoints.getSize(1); j++)
                         {
                             personEntries[id].keypoints[j].x = poseKeypoints[
@@ -283,6 +311,7 @@ namespace op
                                 personEntries[id].status[j] = 0;
                             else
                                 personEntries[id].status[j] = 1;
+                            personEntries[id].confidences[j] = prob;
                         }
 
                     }
@@ -330,7 +359,7 @@ namespace op
                         const auto baseIndex = baseIndexY + j*poseKeypoints.getSize(2);
                         poseKeypoints[baseIndex] = pe.keypoints[j].x;
                         poseKeypoints[baseIndex+1] = pe.keypoints[j].y;
-                        poseKeypoints[baseIndex+2] = float(int(pe.status[j]));
+                        poseKeypoints[baseIndex+2] = (pe.status[j] ? pe.confidences[j] : 0.f);
                         if (pe.keypoints[j].x == 0 && pe.keypoints[j].y == 0)
                             poseKeypoints[baseIndex+2] = 0;
                     }
@@ -381,6 +410,11 @@ namespace op
 
         // Thread-safe variables
         std::atomic<long long> mLastFrameId;
+        // Adaptive key frame schedule
+        std::mutex mKeyFrameMutex;
+        long long mLastKeyFrameId;
+        int mFramesBetweenKeyFrames;
+        float mWorstInlierRatio;
 
         ImplPersonTracker(
             const bool mergeResults, const int levels, const int patchSize, const float confidenceThreshold,
@@ -392,7 +426,10 @@ namespace op
             mConfidenceThreshold{confidenceThreshold},
             mScaleVarying{scaleVarying},
             mRescale{rescale},
-            mLastFrameId{-1ll}
+            mLastFrameId{-1ll},
+            mLastKeyFrameId{-1ll},
+            mFramesBetweenKeyFrames{-1},
+            mWorstInlierRatio{1.f}
         {
         }
     };
@@ -498,8 +535,17 @@ namespace op
                         cv::resize(imageCurrent, imageCurrent, rescaleSize, 0, 0, cv::INTER_CUBIC);
                     }
                     scaleKeypoints(spImpl->mPersonEntries, 1.f/xScale, 1.f/yScale);
-                    updateLK(spImpl->mPersonEntries, spImpl->mPyramidImagesPrevious, pyramidImagesCurrent, spImpl->mImagePrevious,
-                             imageCurrent, spImpl->mLevels, spImpl->mPatchSize, spImpl->mTrackVelocity, spImpl->mScaleVarying);
+                    const auto inlierRatio = updateLK(
+                        spImpl->mPersonEntries, spImpl->mPyramidImagesPrevious, pyramidImagesCurrent,
+                        spImpl->mImagePrevious, imageCurrent, spImpl->mLevels, spImpl->mPatchSize,
+                        spImpl->mTrackVelocity, spImpl->mScaleVarying);
+                    // Adaptive key frame schedule: LK losing keypoints --> Key frames more often
+                    {
+                        const std::lock_guard<std::mutex> lock{spImpl->mKeyFrameMutex};
+                        spImpl->mWorstInlierRatio = fastMin(spImpl->mWorstInlierRatio, inlierRatio);
+                        if (inlierRatio < MIN_LK_INLIER_RATIO && spImpl->mFramesBetweenKeyFrames > 0)
+                            spImpl->mFramesBetweenKeyFrames /= 2;
+                    }
                     scaleKeypoints(spImpl->mPersonEntries, xScale, yScale);
                     spImpl->mImagePrevious = imageCurrent;
                     spImpl->mPyramidImagesPrevious = pyramidImagesCurrent;
@@ -551,6 +597,49 @@ namespace op
         }
     }
 
+    bool PersonTracker::isKeyFrame(const long long frameId, const int maxFramesBetweenKeyFrames)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spImpl->mKeyFrameMutex};
+            if (spImpl->mFramesBetweenKeyFrames < 0)
+                spImpl->mFramesBetweenKeyFrames = maxFramesBetweenKeyFrames;
+            // Key frame
+            if (spImpl->mLastKeyFrameId < 0 || frameId < 0
+                || frameId - spImpl->mLastKeyFrameId > spImpl->mFramesBetweenKeyFrames)
+            {
+                // LK was reliable during the whole last interval --> Key frames less often
+                if (spImpl->mWorstInlierRatio >= MIN_LK_INLIER_RATIO)
+                    spImpl->mFramesBetweenKeyFrames = fastMin(
+                        spImpl->mFramesBetweenKeyFrames + 1, maxFramesBetweenKeyFrames);
+                spImpl->mWorstInlierRatio = 1.f;
+                spImpl->mLastKeyFrameId = frameId;
+                return true;
+            }
+            // Intermediate frame (keypoints propagated by LK)
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    int PersonTracker::getFramesBetweenKeyFrames() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spImpl->mKeyFrameMutex};
+            return spImpl->mFramesBetweenKeyFrames;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1;
+        }
+    }
+
     bool PersonTracker::getMergeResults() const
     {
         try
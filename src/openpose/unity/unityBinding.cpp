@@ -18,6 +18,10 @@ namespace op
     bool sMultiThreadDisabled = false;
     bool sUnityOutputEnabled = true;
     bool sImageOutput = false;
+    // Shared memory output (used instead of the output callback if sSharedMemoryName is not empty)
+    std::string sSharedMemoryName;
+    int sSharedMemoryMaxPeople = 0;
+    int sSharedMemoryMaxImageBytes = 0;
 
     enum class OutputType : unsigned char
     {
@@ -48,6 +52,12 @@ namespace op
     class UnityPluginUserOutput : public WorkerConsumer<std::shared_ptr<std::vector<std::shared_ptr<Datum>>>>
     {
     public:
+        explicit UnityPluginUserOutput(
+            const std::shared_ptr<UnitySharedMemoryWriter>& unitySharedMemoryWriter = nullptr) :
+            spUnitySharedMemoryWriter{unitySharedMemoryWriter}
+        {
+        }
+
         void initializationOnThread()
         {
         }
@@ -58,7 +68,11 @@ namespace op
             {
                 if (datumsPtr != nullptr && !datumsPtr->empty())
                 {
-                    if (sUnityOutputEnabled)
+                    // Shared memory: Unity polls the last frame, so nothing is marshalled
+                    if (sUnityOutputEnabled && spUnitySharedMemoryWriter != nullptr)
+                        spUnitySharedMemoryWriter->write(*datumsPtr->at(0), sImageOutput);
+                    // Callbacks
+                    else if (sUnityOutputEnabled)
                     {
                         sendDatumsInfoAndName(datumsPtr);
                         sendPoseKeypoints(datumsPtr);
@@ -85,6 +99,8 @@ namespace op
         }
 
     private:
+        const std::shared_ptr<UnitySharedMemoryWriter> spUnitySharedMemoryWriter;
+
         template<class T>
         void outputValue(T** ptrs, const int ptrSize, int* sizes, const int sizeSize, const OutputType outputType)
         {
@@ -423,8 +439,21 @@ namespace op
             // OpenPose wrapper
             auto spWrapper = std::make_shared<Wrapper>();
 
+            // Shared memory output (allocated once, before processing any frame)
+            std::shared_ptr<UnitySharedMemoryWriter> spUnitySharedMemoryWriter;
+            if (!sSharedMemoryName.empty())
+            {
+                const auto poseModel = spWrapperStructPose->poseModel;
+                spUnitySharedMemoryWriter = std::make_shared<UnitySharedMemoryWriter>(
+                    sSharedMemoryName, sSharedMemoryMaxPeople,
+                    std::array<int, UNITY_SHARED_MEMORY_GROUPS>{
+                        (int)getPoseNumberBodyParts(poseModel), (int)FACE_NUMBER_PARTS, (int)HAND_NUMBER_PARTS,
+                        (int)HAND_NUMBER_PARTS},
+                    sSharedMemoryMaxImageBytes);
+            }
+
             // Initializing the user custom classes
-            auto spUserOutput = std::make_shared<UnityPluginUserOutput>();
+            auto spUserOutput = std::make_shared<UnityPluginUserOutput>(spUnitySharedMemoryWriter);
             ptrUserOutput = spUserOutput.get();
 
             // Add custom processing
@@ -528,6 +557,22 @@ namespace op
             }
         }
 
+        // Enable/disable shared memory output (see UnitySharedMemoryWriter). An empty or null name disables it (i.e.,
+        // the output callback is used). It must be called before _OPRun
+        OP_API void _OPSetSharedMemoryOutput(char* name, int maxPeople, int maxImageBytes)
+        {
+            try
+            {
+                sSharedMemoryName = (name != nullptr ? name : "");
+                sSharedMemoryMaxPeople = maxPeople;
+                sSharedMemoryMaxImageBytes = maxImageBytes;
+            }
+            catch (const std::exception& e)
+            {
+                errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
         // Configs
         OP_API void _OPConfigurePose(
             unsigned char poseMode,
@@ -0,0 +1,278 @@
+#include <openpose/unity/unitySharedMemory.hpp>
+#include <algorithm> // std::min
+#include <atomic> // std::atomic_thread_fence
+#include <cstring> // std::memcpy, std::memset
+#ifdef _WIN32
+    #include <windows.h> // CreateFileMappingA, MapViewOfFile
+#elif defined __unix__ || defined __APPLE__
+    #include <fcntl.h> // open
+    #include <sys/mman.h> // mmap
+    #include <unistd.h> // close, ftruncate
+#else
+    #error Unknown environment!
+#endif
+#include <openpose/core/datum.hpp>
+
+namespace op
+{
+    static_assert(sizeof(UnitySharedMemoryHeader) == 112, "UnitySharedMemoryHeader must not have padding.");
+    static_assert(sizeof(UnitySharedMemoryFrame) == 64, "UnitySharedMemoryFrame must not have padding.");
+
+    const auto UNITY_SHARED_MEMORY_ALIGNMENT = 64ull;
+
+    unsigned long long alignSharedMemory(const unsigned long long numberBytes)
+    {
+        return (numberBytes + UNITY_SHARED_MEMORY_ALIGNMENT - 1) / UNITY_SHARED_MEMORY_ALIGNMENT
+            * UNITY_SHARED_MEMORY_ALIGNMENT;
+    }
+
+    // Sequence counters: the fences keep the data writes between the begin and end counters, also for the compiler
+    void storeSequence(unsigned long long& sequence, const unsigned long long value)
+    {
+        std::atomic_thread_fence(std::memory_order_release);
+        *(volatile unsigned long long*)&sequence = value;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    struct UnitySharedMemoryWriter::ImplUnitySharedMemoryWriter
+    {
+        unsigned long long mTotalBytes;
+        unsigned long long mSequence;
+        unsigned char* pMemory;
+        bool mImageTooLargeWarned;
+        #ifdef _WIN32
+            HANDLE mHandle;
+        #endif
+
+        ImplUnitySharedMemoryWriter() :
+            mTotalBytes{0ull},
+            mSequence{0ull},
+            pMemory{nullptr},
+            mImageTooLargeWarned{false}
+            #ifdef _WIN32
+                , mHandle{nullptr}
+            #endif
+        {
+        }
+
+        void map(const std::string& name)
+        {
+            try
+            {
+                #ifdef _WIN32
+                    mHandle = CreateFileMappingA(
+                        INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, DWORD(mTotalBytes >> 32),
+                        DWORD(mTotalBytes & 0xffffffffull), name.c_str());
+                    if (mHandle == nullptr)
+                        error("Shared memory " + name + " could not be created.", __LINE__, __FUNCTION__, __FILE__);
+                    pMemory = (unsigned char*)MapViewOfFile(mHandle, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)mTotalBytes);
+                    if (pMemory == nullptr)
+                        error("Shared memory " + name + " could not be mapped.", __LINE__, __FUNCTION__, __FILE__);
+                #else
+                    const auto fileDescriptor = open(name.c_str(), O_RDWR | O_CREAT, 0666);
+                    if (fileDescriptor < 0)
+                        error("Shared memory file " + name + " could not be opened.", __LINE__, __FUNCTION__, __FILE__);
+                    if (ftruncate(fileDescriptor, (off_t)mTotalBytes) != 0)
+                    {
+                        close(fileDescriptor);
+                        error("Shared memory file " + name + " could not be resized.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    }
+                    auto* memory = mmap(
+                        nullptr, (size_t)mTotalBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+                    // The mapping remains valid after closing the file
+                    close(fileDescriptor);
+                    if (memory == MAP_FAILED)
+                        error("Shared memory file " + name + " could not be mapped.", __LINE__, __FUNCTION__, __FILE__);
+                    pMemory = (unsigned char*)memory;
+                #endif
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        void unmap()
+        {
+            #ifdef _WIN32
+                if (pMemory != nullptr)
+                    UnmapViewOfFile(pMemory);
+                if (mHandle != nullptr)
+                    CloseHandle(mHandle);
+                mHandle = nullptr;
+            #else
+                if (pMemory != nullptr)
+                    munmap(pMemory, (size_t)mTotalBytes);
+            #endif
+            pMemory = nullptr;
+        }
+
+        inline UnitySharedMemoryHeader& header() const
+        {
+            return *(UnitySharedMemoryHeader*)pMemory;
+        }
+    };
+
+    UnitySharedMemoryWriter::UnitySharedMemoryWriter(
+        const std::string& name, const int maxPeople, const std::array<int, UNITY_SHARED_MEMORY_GROUPS>& numberParts,
+        const int maxImageBytes) :
+        spImpl{std::make_shared<ImplUnitySharedMemoryWriter>()}
+    {
+        try
+        {
+            if (name.empty())
+                error("The shared memory name cannot be empty.", __LINE__, __FUNCTION__, __FILE__);
+            if (maxPeople < 1 || maxImageBytes < 0
+                || *std::min_element(numberParts.begin(), numberParts.end()) < 0)
+                error("Wrong maxPeople, numberParts or maxImageBytes.", __LINE__, __FUNCTION__, __FILE__);
+
+            // Layout (all blocks 64-byte aligned)
+            UnitySharedMemoryHeader header;
+            std::memset(&header, 0, sizeof(header));
+            header.version = UNITY_SHARED_MEMORY_VERSION;
+            header.maxPeople = maxPeople;
+            header.maxImageBytes = maxImageBytes;
+            auto bufferBytes = alignSharedMemory(sizeof(UnitySharedMemoryFrame));
+            for (auto group = 0 ; group < UNITY_SHARED_MEMORY_GROUPS ; group++)
+            {
+                header.numberParts[group] = numberParts[group];
+                header.keypointOffsets[group] = bufferBytes;
+                bufferBytes += alignSharedMemory(3ull * sizeof(float) * maxPeople * numberParts[group]);
+            }
+            header.imageOffset = bufferBytes;
+            bufferBytes += alignSharedMemory(maxImageBytes);
+            header.bufferBytes = bufferBytes;
+            header.bufferOffsets[0] = alignSharedMemory(sizeof(UnitySharedMemoryHeader));
+            header.bufferOffsets[1] = header.bufferOffsets[0] + bufferBytes;
+            header.totalBytes = header.bufferOffsets[1] + bufferBytes;
+
+            // Map it and initialize it. The magic number is written last, so a reader that finds it also finds a
+            // complete header
+            spImpl->mTotalBytes = header.totalBytes;
+            spImpl->map(name);
+            std::memset(spImpl->pMemory, 0, sizeof(UnitySharedMemoryHeader));
+            for (const auto bufferOffset : header.bufferOffsets)
+                std::memset(spImpl->pMemory + bufferOffset, 0, sizeof(UnitySharedMemoryFrame));
+            std::memcpy(spImpl->pMemory, &header, sizeof(header));
+            std::atomic_thread_fence(std::memory_order_release);
+            *(volatile unsigned int*)&spImpl->header().magic = UNITY_SHARED_MEMORY_MAGIC;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        catch (const std::exception& e)
+        {
+            if (spImpl != nullptr)
+                spImpl->unmap();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    UnitySharedMemoryWriter::~UnitySharedMemoryWriter()
+    {
+        try
+        {
+            // The region (or file) is not removed, so readers can still access the last frame
+            spImpl->unmap();
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void UnitySharedMemoryWriter::write(const Datum& datum, const bool writeImage)
+    {
+        try
+        {
+            const auto& header = spImpl->header();
+            const auto sequence = spImpl->mSequence + 1;
+            auto* buffer = spImpl->pMemory + header.bufferOffsets[sequence % 2];
+            auto& frame = *(UnitySharedMemoryFrame*)buffer;
+
+            // Readers of the previous frame of this buffer (at least 1 frame late) will discard their copy
+            storeSequence(frame.sequenceBegin, sequence);
+
+            // Frame information
+            frame.id = datum.id;
+            frame.frameNumber = datum.frameNumber;
+
+            // Keypoints (people exceeding maxPeople are not written)
+            const std::array<const Array<float>*, UNITY_SHARED_MEMORY_GROUPS> keypointArrays{
+                &datum.poseKeypoints, &datum.faceKeypoints, &datum.handKeypoints[0], &datum.handKeypoints[1]};
+            for (auto group = 0 ; group < UNITY_SHARED_MEMORY_GROUPS ; group++)
+            {
+                const auto& keypoints = *keypointArrays[group];
+                auto numberPeople = 0;
+                if (!keypoints.empty())
+                {
+                    if (keypoints.getNumberDimensions() != 3 || keypoints.getSize(1) != header.numberParts[group]
+                        || keypoints.getSize(2) != 3)
+                        error("Keypoints of size " + keypoints.printSize() + " do not match the shared memory"
+                              " layout (" + std::to_string(header.numberParts[group]) + " parts).",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    numberPeople = std::min(keypoints.getSize(0), header.maxPeople);
+                    std::memcpy(buffer + header.keypointOffsets[group], keypoints.getConstPtr(),
+                                sizeof(float) * numberPeople * header.numberParts[group] * 3);
+                }
+                frame.numberPeople[group] = numberPeople;
+            }
+
+            // Image (rendered one if any)
+            frame.imageWidth = 0;
+            frame.imageHeight = 0;
+            frame.imageChannels = 0;
+            if (writeImage)
+            {
+                const auto& image = (datum.cvOutputData.empty() ? datum.cvInputData : datum.cvOutputData);
+                // 8-bit images only (elemSize() rather than elemSize1(), as Matrix::elemSize1() returns elemSize())
+                if (!image.empty() && image.elemSize() == (size_t)image.channels())
+                {
+                    const auto rowBytes = (size_t)image.cols() * image.channels();
+                    if (rowBytes * image.rows() <= (size_t)header.maxImageBytes)
+                    {
+                        auto* imagePtr = buffer + header.imageOffset;
+                        const auto* const imageData = image.dataConst();
+                        if (image.isContinuous())
+                            std::memcpy(imagePtr, imageData, rowBytes * image.rows());
+                        else
+                            for (auto row = 0 ; row < image.rows() ; row++)
+                                std::memcpy(imagePtr + row * rowBytes, imageData + row * image.step1(), rowBytes);
+                        frame.imageWidth = image.cols();
+                        frame.imageHeight = image.rows();
+                        frame.imageChannels = image.channels();
+                    }
+                    else if (!spImpl->mImageTooLargeWarned)
+                    {
+                        spImpl->mImageTooLargeWarned = true;
+                        opLog("The image (" + std::to_string(image.cols()) + "x" + std::to_string(image.rows())
+                              + ") does not fit in the shared memory (maxImageBytes = "
+                              + std::to_string(header.maxImageBytes) + "), so it will not be written.",
+                              Priority::High);
+                    }
+                }
+            }
+
+            // Publish it
+            storeSequence(frame.sequenceEnd, sequence);
+            storeSequence(spImpl->header().sequence, sequence);
+            spImpl->mSequence = sequence;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long UnitySharedMemoryWriter::getSequence() const
+    {
+        try
+        {
+            return spImpl->mSequence;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+}
@@ -9,13 +9,12 @@ namespace op
                                      " is only for array of dimension: [sizeA x sizeB x 3].";
 
     template <typename T>
-    T getDistance(const Array<T>& keypoints, const int person, const int elementA, const int elementB)
+    T getDistance(const ArrayView<const T>& keypoints, const int person, const int elementA, const int elementB)
     {
         try
         {
-            const auto keypointPtr = keypoints.getConstPtr() + person * keypoints.getSize(1) * keypoints.getSize(2);
-            const auto pixelX = keypointPtr[elementA*3] - keypointPtr[elementB*3];
-            const auto pixelY = keypointPtr[elementA*3+1] - keypointPtr[elementB*3+1];
+            const auto pixelX = keypoints(person, elementA, 0) - keypoints(person, elementB, 0);
+            const auto pixelY = keypoints(person, elementA, 1) - keypoints(person, elementB, 1);
             return std::sqrt(pixelX*pixelX+pixelY*pixelY);
         }
         catch (const std::exception& e)
@@ -24,6 +23,24 @@ namespace op
             return T(-1);
         }
     }
+    template OP_API float getDistance(
+        const ArrayView<const float>& keypoints, const int person, const int elementA, const int elementB);
+    template OP_API double getDistance(
+        const ArrayView<const double>& keypoints, const int person, const int elementA, const int elementB);
+
+    template <typename T>
+    T getDistance(const Array<T>& keypoints, const int person, const int elementA, const int elementB)
+    {
+        try
+        {
+            return getDistance(ArrayView<const T>{keypoints}, person, elementA, elementB);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return T(-1);
+        }
+    }
     template OP_API float getDistance(
         const Array<float>& keypoints, const int person, const int elementA, const int elementB);
     template OP_API double getDistance(
@@ -560,7 +577,8 @@ namespace op
 
     template <typename T>
     Rectangle<T> getKeypointsRectangle(
-        const Array<T>& keypoints, const int person, const T threshold, const int firstIndex, const int lastIndex)
+        const ArrayView<const T>& keypoints, const int person, const T threshold, const int firstIndex,
+        const int lastIndex)
     {
         try
         {
@@ -578,19 +596,17 @@ namespace op
                 error("The value of `firstIndex` must be less or equal than `lastIndex`. Currently: "
                     + std::to_string(firstIndex) + " vs. " + std::to_string(lastIndex),
                     __LINE__, __FUNCTION__, __FILE__);
-            // Define keypointPtr
-            const auto keypointPtr = keypoints.getConstPtr() + person * keypoints.getSize(1) * keypoints.getSize(2);
             T minX = std::numeric_limits<T>::max();
             T maxX = std::numeric_limits<T>::lowest();
             T minY = minX;
             T maxY = maxX;
             for (auto part = firstIndex ; part < lastIndexClean ; part++)
             {
-                const auto score = keypointPtr[3*part + 2];
+                const auto score = keypoints(person, part, 2);
                 if (score > threshold)
                 {
-                    const auto x = keypointPtr[3*part];
-                    const auto y = keypointPtr[3*part + 1];
+                    const auto x = keypoints(person, part, 0);
+                    const auto y = keypoints(person, part, 1);
                     // Set X
                     if (maxX < x)
                         maxX = x;
@@ -614,6 +630,27 @@ namespace op
             return Rectangle<T>{};
         }
     }
+    template OP_API Rectangle<float> getKeypointsRectangle(
+        const ArrayView<const float>& keypoints, const int person, const float threshold, const int firstIndex,
+        const int lastIndex);
+    template OP_API Rectangle<double> getKeypointsRectangle(
+        const ArrayView<const double>& keypoints, const int person, const double threshold, const int firstIndex,
+        const int lastIndex);
+
+    template <typename T>
+    Rectangle<T> getKeypointsRectangle(
+        const Array<T>& keypoints, const int person, const T threshold, const int firstIndex, const int lastIndex)
+    {
+        try
+        {
+            return getKeypointsRectangle(ArrayView<const T>{keypoints}, person, threshold, firstIndex, lastIndex);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Rectangle<T>{};
+        }
+    }
     template OP_API Rectangle<float> getKeypointsRectangle(
         const Array<float>& keypoints, const int person, const float threshold, const int firstIndex,
         const int lastIndex);
@@ -622,7 +659,7 @@ namespace op
         const int lastIndex);
 
     template <typename T>
-    T getAverageScore(const Array<T>& keypoints, const int person)
+    T getAverageScore(const ArrayView<const T>& keypoints, const int person)
     {
         try
         {
@@ -632,10 +669,8 @@ namespace op
             // Get average score
             T score = T(0);
             const auto numberKeypoints = keypoints.getSize(1);
-            const auto area = numberKeypoints * keypoints.getSize(2);
-            const auto personOffset = person * area;
             for (auto part = 0 ; part < numberKeypoints ; part++)
-                score += keypoints[personOffset + part*keypoints.getSize(2) + 2];
+                score += keypoints(person, part, 2);
             return score / numberKeypoints;
         }
         catch (const std::exception& e)
@@ -644,11 +679,27 @@ namespace op
             return T(0);
         }
     }
+    template OP_API float getAverageScore(const ArrayView<const float>& keypoints, const int person);
+    template OP_API double getAverageScore(const ArrayView<const double>& keypoints, const int person);
+
+    template <typename T>
+    T getAverageScore(const Array<T>& keypoints, const int person)
+    {
+        try
+        {
+            return getAverageScore(ArrayView<const T>{keypoints}, person);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return T(0);
+        }
+    }
     template OP_API float getAverageScore(const Array<float>& keypoints, const int person);
     template OP_API double getAverageScore(const Array<double>& keypoints, const int person);
 
     template <typename T>
-    T getKeypointsArea(const Array<T>& keypoints, const int person, const T threshold)
+    T getKeypointsArea(const ArrayView<const T>& keypoints, const int person, const T threshold)
     {
         try
         {
@@ -660,11 +711,29 @@ namespace op
             return T(0);
         }
     }
+    template OP_API float getKeypointsArea(
+        const ArrayView<const float>& keypoints, const int person, const float threshold);
+    template OP_API double getKeypointsArea(
+        const ArrayView<const double>& keypoints, const int person, const double threshold);
+
+    template <typename T>
+    T getKeypointsArea(const Array<T>& keypoints, const int person, const T threshold)
+    {
+        try
+        {
+            return getKeypointsArea(ArrayView<const T>{keypoints}, person, threshold);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return T(0);
+        }
+    }
     template OP_API float getKeypointsArea(const Array<float>& keypoints, const int person, const float threshold);
     template OP_API double getKeypointsArea(const Array<double>& keypoints, const int person, const double threshold);
 
     template <typename T>
-    int getBiggestPerson(const Array<T>& keypoints, const T threshold)
+    int getBiggestPerson(const ArrayView<const T>& keypoints, const T threshold)
     {
         try
         {
@@ -693,11 +762,27 @@ namespace op
             return -1;
         }
     }
+    template OP_API int getBiggestPerson(const ArrayView<const float>& keypoints, const float threshold);
+    template OP_API int getBiggestPerson(const ArrayView<const double>& keypoints, const double threshold);
+
+    template <typename T>
+    int getBiggestPerson(const Array<T>& keypoints, const T threshold)
+    {
+        try
+        {
+            return getBiggestPerson(ArrayView<const T>{keypoints}, threshold);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1;
+        }
+    }
     template OP_API int getBiggestPerson(const Array<float>& keypoints, const float threshold);
     template OP_API int getBiggestPerson(const Array<double>& keypoints, const double threshold);
 
     template <typename T>
-    int getNonZeroKeypoints(const Array<T>& keypoints, const int person, const T threshold)
+    int getNonZeroKeypoints(const ArrayView<const T>& keypoints, const int person, const T threshold)
     {
         try
         {
@@ -708,9 +793,8 @@ namespace op
                     error("Person index out of range.", __LINE__, __FUNCTION__, __FILE__);
                 // Count keypoints
                 auto nonZeroCounter = 0;
-                const auto baseIndex = person * (int)keypoints.getVolume(1,2);
                 for (auto part = 0 ; part < keypoints.getSize(1) ; part++)
-                    if (keypoints[baseIndex + 3*part + 2] >= threshold)
+                    if (keypoints(person, part, 2) >= threshold)
                         nonZeroCounter++;
                 return nonZeroCounter;
             }
@@ -723,30 +807,31 @@ namespace op
             return 0;
         }
     }
-    template OP_API int getNonZeroKeypoints(const Array<float>& keypoints, const int person, const float threshold);
-    template OP_API int getNonZeroKeypoints(const Array<double>& keypoints, const int person, const double threshold);
+    template OP_API int getNonZeroKeypoints(
+        const ArrayView<const float>& keypoints, const int person, const float threshold);
+    template OP_API int getNonZeroKeypoints(
+        const ArrayView<const double>& keypoints, const int person, const double threshold);
 
     template <typename T>
-    T getDistanceAverage(const Array<T>& keypoints, const int personA, const int personB, const T threshold)
+    int getNonZeroKeypoints(const Array<T>& keypoints, const int person, const T threshold)
     {
         try
         {
-            return getDistanceAverage(keypoints, personA, keypoints, personB, threshold);
+            return getNonZeroKeypoints(ArrayView<const T>{keypoints}, person, threshold);
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return T(0);
+            return 0;
         }
     }
-    template OP_API float getDistanceAverage(
-        const Array<float>& keypoints, const int personA, const int personB, const float threshold);
-    template OP_API double getDistanceAverage(
-        const Array<double>& keypoints, const int personA, const int personB, const double threshold);
+    template OP_API int getNonZeroKeypoints(const Array<float>& keypoints, const int person, const float threshold);
+    template OP_API int getNonZeroKeypoints(const Array<double>& keypoints, const int person, const double threshold);
 
     template <typename T>
-    T getDistanceAverage(const Array<T>& keypointsA, const int personA, const Array<T>& keypointsB, const int personB,
-                         const T threshold)
+    T getDistanceAverage(
+        const ArrayView<const T>& keypointsA, const int personA, const ArrayView<const T>& keypointsB,
+        const int personB, const T threshold)
     {
         try
         {
@@ -760,14 +845,12 @@ namespace op
             // Get total distance
             T totalDistance = 0;
             int nonZeroCounter = 0;
-            const auto baseIndexA = personA * (int)keypointsA.getVolume(1,2);
-            const auto baseIndexB = personB * (int)keypointsB.getVolume(1,2);
             for (auto part = 0 ; part < keypointsA.getSize(1) ; part++)
             {
-                if (keypointsA[baseIndexA+3*part+2] >= threshold && keypointsB[baseIndexB+3*part+2] >= threshold)
+                if (keypointsA(personA, part, 2) >= threshold && keypointsB(personB, part, 2) >= threshold)
                 {
-                    const auto x = keypointsA[baseIndexA+3*part] - keypointsB[baseIndexB+3*part];
-                    const auto y = keypointsA[baseIndexA+3*part+1] - keypointsB[baseIndexB+3*part+1];
+                    const auto x = keypointsA(personA, part, 0) - keypointsB(personB, part, 0);
+                    const auto y = keypointsA(personA, part, 1) - keypointsB(personB, part, 1);
                     totalDistance += T(std::sqrt(x*x+y*y));
                     nonZeroCounter++;
                 }
@@ -781,6 +864,47 @@ namespace op
             return T(0);
         }
     }
+    template OP_API float getDistanceAverage(
+        const ArrayView<const float>& keypointsA, const int personA, const ArrayView<const float>& keypointsB,
+        const int personB, const float threshold);
+    template OP_API double getDistanceAverage(
+        const ArrayView<const double>& keypointsA, const int personA, const ArrayView<const double>& keypointsB,
+        const int personB, const double threshold);
+
+    template <typename T>
+    T getDistanceAverage(const Array<T>& keypoints, const int personA, const int personB, const T threshold)
+    {
+        try
+        {
+            const ArrayView<const T> keypointsView{keypoints};
+            return getDistanceAverage(keypointsView, personA, keypointsView, personB, threshold);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return T(0);
+        }
+    }
+    template OP_API float getDistanceAverage(
+        const Array<float>& keypoints, const int personA, const int personB, const float threshold);
+    template OP_API double getDistanceAverage(
+        const Array<double>& keypoints, const int personA, const int personB, const double threshold);
+
+    template <typename T>
+    T getDistanceAverage(const Array<T>& keypointsA, const int personA, const Array<T>& keypointsB, const int personB,
+                         const T threshold)
+    {
+        try
+        {
+            return getDistanceAverage(
+                ArrayView<const T>{keypointsA}, personA, ArrayView<const T>{keypointsB}, personB, threshold);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return T(0);
+        }
+    }
     template OP_API float getDistanceAverage(
         const Array<float>& keypointsA, const int personA, const Array<float>& keypointsB, const int personB,
         const float threshold);
@@ -807,27 +931,27 @@ namespace op
         const Array<double>& keypoints, const int person, const bool noCopy);
 
     template <typename T>
-    float getKeypointsRoi(const Array<T>& keypoints, const int personA, const int personB, const T threshold)
+    ArrayView<const T> getKeypointsPerson(const ArrayView<const T>& keypoints, const int person)
     {
         try
         {
-            return getKeypointsRoi(keypoints, personA, keypoints, personB, threshold);
+            return keypoints.slice(0, person);
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return 0.f;
+            return ArrayView<const T>{};
         }
     }
-    template OP_API float getKeypointsRoi(
-        const Array<float>& keypoints, const int personA, const int personB, const float threshold);
-    template OP_API float getKeypointsRoi(
-        const Array<double>& keypoints, const int personA, const int personB, const double threshold);
+    template OP_API ArrayView<const float> getKeypointsPerson(
+        const ArrayView<const float>& keypoints, const int person);
+    template OP_API ArrayView<const double> getKeypointsPerson(
+        const ArrayView<const double>& keypoints, const int person);
 
     template <typename T>
     float getKeypointsRoi(
-        const Array<T>& keypointsA, const int personA, const Array<T>& keypointsB, const int personB,
-        const T threshold)
+        const ArrayView<const T>& keypointsA, const int personA, const ArrayView<const T>& keypointsB,
+        const int personB, const T threshold)
     {
         try
         {
@@ -849,6 +973,48 @@ namespace op
             return 0.f;
         }
     }
+    template OP_API float getKeypointsRoi(
+        const ArrayView<const float>& keypointsA, const int personA, const ArrayView<const float>& keypointsB,
+        const int personB, const float threshold);
+    template OP_API float getKeypointsRoi(
+        const ArrayView<const double>& keypointsA, const int personA, const ArrayView<const double>& keypointsB,
+        const int personB, const double threshold);
+
+    template <typename T>
+    float getKeypointsRoi(const Array<T>& keypoints, const int personA, const int personB, const T threshold)
+    {
+        try
+        {
+            const ArrayView<const T> keypointsView{keypoints};
+            return getKeypointsRoi(keypointsView, personA, keypointsView, personB, threshold);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.f;
+        }
+    }
+    template OP_API float getKeypointsRoi(
+        const Array<float>& keypoints, const int personA, const int personB, const float threshold);
+    template OP_API float getKeypointsRoi(
+        const Array<double>& keypoints, const int personA, const int personB, const double threshold);
+
+    template <typename T>
+    float getKeypointsRoi(
+        const Array<T>& keypointsA, const int personA, const Array<T>& keypointsB, const int personB,
+        const T threshold)
+    {
+        try
+        {
+            return getKeypointsRoi(
+                ArrayView<const T>{keypointsA}, personA, ArrayView<const T>{keypointsB}, personB, threshold);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.f;
+        }
+    }
     template OP_API float getKeypointsRoi(
         const Array<float>& keypointsA, const int personA, const Array<float>& keypointsB, const int personB,
         const float threshold);
@@ -54,7 +54,8 @@ namespace op
         }
     }
 
-    void uCharCvMatToFloatPtr(float* floatPtrImage, const Matrix& matImage, const int normalize)
+    void uCharCvMatToFloatPtr(float* floatPtrImage, const Matrix& matImage, const int normalize,
+                              const size_t paddedVolume)
     {
         try
         {
@@ -114,14 +115,38 @@ namespace op
                     int pixel;
                     const __m256 mmRatio = _mm256_set1_ps(1.f/256.f);
                     const __m256 mmBias = _mm256_set1_ps(-0.5f);
-                    for (pixel = 0 ; pixel < volume-7 ; pixel += 8)
+                    // Aligned and padded (e.g., Array<float> memory, see ARRAY_ALIGNMENT) -> The last partial block
+                    // is also processed (its extra elements are padding), so there is no scalar tail
+                    if (is_aligned(floatPtrImage, 32) && paddedVolume >= size_t((volume + 7) / 8 * 8))
                     {
-                        const __m256 input = _mm256_load_ps(&floatPtrImage[pixel]);
-                        // const __m256 input = _mm256_loadu_ps(&floatPtrImage[pixel]); // If non-aligned pointer
-                        const __m256 output = _mm256_fmadd_ps(input, mmRatio, mmBias);
-                        _mm256_store_ps(&floatPtrImage[pixel], output);
-                        // _mm256_storeu_ps(&floatPtrImage[pixel], output); // If non-aligned pointer
+                        for (pixel = 0 ; pixel < volume ; pixel += 8)
+                        {
+                            const __m256 input = _mm256_load_ps(&floatPtrImage[pixel]);
+                            const __m256 output = _mm256_fmadd_ps(input, mmRatio, mmBias);
+                            _mm256_store_ps(&floatPtrImage[pixel], output);
+                        }
+                    }
+                    // Aligned loads/stores only if allowed
+                    else if (is_aligned(floatPtrImage, 32))
+                    {
+                        for (pixel = 0 ; pixel < volume-7 ; pixel += 8)
+                        {
+                            const __m256 input = _mm256_load_ps(&floatPtrImage[pixel]);
+                            const __m256 output = _mm256_fmadd_ps(input, mmRatio, mmBias);
+                            _mm256_store_ps(&floatPtrImage[pixel], output);
+                        }
+                    }
+                    // Non-aligned pointer (e.g., external memory or Array slice)
+                    else
+                    {
+                        for (pixel = 0 ; pixel < volume-7 ; pixel += 8)
+                        {
+                            const __m256 input = _mm256_loadu_ps(&floatPtrImage[pixel]);
+                            const __m256 output = _mm256_fmadd_ps(input, mmRatio, mmBias);
+                            _mm256_storeu_ps(&floatPtrImage[pixel], output);
+                        }
                     }
+                    // Scalar tail (if not padded)
                     const auto ratio = 1.f/256.f;
                     for (; pixel < volume ; ++pixel)
                         floatPtrImage[pixel] = floatPtrImage[pixel]*ratio - 0.5f;
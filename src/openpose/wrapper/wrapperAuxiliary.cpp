@@ -1,6 +1,9 @@
 #include <openpose/wrapper/wrapperAuxiliary.hpp>
+#include <opencv2/core/core.hpp> // CV_8UC3
 #include <openpose/gpu/gpu.hpp>
+#include <openpose/thread/cpuAffinity.hpp>
 #include <openpose/thread/enumClasses.hpp>
+#include <openpose/utilities/fastMath.hpp>
 
 namespace op
 {
@@ -209,4 +212,80 @@ namespace op
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
+
+    int getNumberGpuThreads(const WrapperStructPose& wrapperStructPose)
+    {
+        try
+        {
+            if (getGpuMode() == GpuMode::NoGpu)
+                return 1;
+            const auto numberGpuThreads = (wrapperStructPose.gpuNumber < 0
+                ? getGpuNumber() - wrapperStructPose.gpuNumberStart : wrapperStructPose.gpuNumber);
+            return fastMax(1, numberGpuThreads);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 1;
+        }
+    }
+
+    std::vector<Matrix> createWarmupFrames(const std::vector<Point<int>>& resolutions)
+    {
+        try
+        {
+            std::vector<Matrix> frames;
+            frames.reserve(resolutions.size());
+            for (const auto& resolution : resolutions)
+            {
+                if (resolution.x < 1 || resolution.y < 1)
+                    error("Wrong warm-up resolution (" + resolution.toString() + ").",
+                          __LINE__, __FUNCTION__, __FILE__);
+                frames.emplace_back(resolution.y, resolution.x, CV_8UC3);
+                frames.back().setTo(0.);
+            }
+            return frames;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::vector<std::vector<int>> getGpuThreadCpus(
+        const WrapperStructPose& wrapperStructPose, const int numberGpuThreads)
+    {
+        try
+        {
+            // Nodes with CPUs
+            const auto numaNodeCpus = getNumaNodeCpus();
+            std::vector<int> numaNodes;
+            for (auto node = 0u ; node < numaNodeCpus.size() ; node++)
+                if (!numaNodeCpus[node].empty())
+                    numaNodes.emplace_back(node);
+            // Node of each GPU
+            std::vector<std::vector<int>> gpuThreadCpus(fastMax(1, numberGpuThreads));
+            std::string placement;
+            for (auto i = 0u ; i < gpuThreadCpus.size() ; i++)
+            {
+                auto numaNode = (i < wrapperStructPose.gpuNumaNodes.size()
+                    ? wrapperStructPose.gpuNumaNodes[i]
+                    : (numberGpuThreads > 0 ? getGpuNumaNode(wrapperStructPose.gpuNumberStart + i) : -1));
+                // Unknown -> evenly distributed
+                if (numaNode < 0 || numaNode >= (int)numaNodeCpus.size() || numaNodeCpus[numaNode].empty())
+                    numaNode = numaNodes.at(i * numaNodes.size() / gpuThreadCpus.size());
+                gpuThreadCpus[i] = numaNodeCpus[numaNode];
+                placement += (i > 0 ? ", " : "") + std::to_string(numaNode);
+            }
+            opLog("Thread placement: " + std::to_string(numaNodes.size()) + " NUMA node(s) with CPUs, GPU thread(s)"
+                  " on node(s) " + placement + ".", Priority::High);
+            return gpuThreadCpus;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
 }
@@ -4,12 +4,18 @@ namespace op
 {
     WrapperStructExtra::WrapperStructExtra(
         const bool reconstruct3d_, const int minViews3d_, const bool identification_, const int tracking_,
-        const int ikThreads_) :
+        const int ikThreads_, const int roiRefresh_, const double motionThreshold_, const int motionMaxSkip_,
+        const int elasticThreads_, const bool pinThreads_) :
         reconstruct3d{reconstruct3d_},
         minViews3d{minViews3d_},
         identification{identification_},
         tracking{tracking_},
-        ikThreads{ikThreads_}
+        ikThreads{ikThreads_},
+        roiRefresh{roiRefresh_},
+        motionThreshold{motionThreshold_},
+        motionMaxSkip{motionMaxSkip_},
+        elasticThreads{elasticThreads_},
+        pinThreads{pinThreads_}
     {
     }
 }
@@ -11,7 +11,9 @@ namespace op
         const std::vector<HeatMapType>& heatMapTypes_, const ScaleMode heatMapScaleMode_,
         const bool addPartCandidates_, const float renderThreshold_, const int numberPeopleMax_,
         const bool maximizePositives_, const double fpsMax_, const String& protoTxtPath_,
-        const String& caffeModelPath_, const float upsamplingRatio_, const bool enableGoogleLogging_) :
+        const String& caffeModelPath_, const float upsamplingRatio_, const bool enableGoogleLogging_,
+        const double latencyBudget_, const std::vector<int>& netInputHeights_,
+        const std::vector<int>& gpuNumaNodes_) :
         poseMode{poseMode_},
         netInputSize{netInputSize_},
         netInputSizeDynamicBehavior{netInputSizeDynamicBehavior_},
@@ -38,7 +40,10 @@ namespace op
         protoTxtPath{protoTxtPath_},
         caffeModelPath{caffeModelPath_},
         upsamplingRatio{upsamplingRatio_},
-        enableGoogleLogging{enableGoogleLogging_}
+        enableGoogleLogging{enableGoogleLogging_},
+        latencyBudget{latencyBudget_},
+        netInputHeights{netInputHeights_},
+        gpuNumaNodes{gpuNumaNodes_}
     {
     }
 }